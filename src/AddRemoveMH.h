@@ -22,50 +22,91 @@ class AddRemoveMH : public GGM<GraphStructure, T> {
 		using PrecisionType     = typename GGMTraits<GraphStructure, T>::PrecisionType;
 		using ReturnType 		= typename GGMTraits<GraphStructure, T>::ReturnType;
 
-		AddRemoveMH(PriorPtr& _ptr_prior,double const & _b , MatCol const & _D, double const & _trGwishSampler, unsigned int const & _MCiterPrior = 100, unsigned int const & _MCiterPost = 100): 
-					GGM<GraphStructure, T>(_ptr_prior, _b, _D, _trGwishSampler), MCiterPrior(_MCiterPrior), MCiterPost(_MCiterPost){}
-		AddRemoveMH(PriorPtr& _ptr_prior,unsigned int const & _p, double const & _trGwishSampler, unsigned int const & _MCiterPrior = 100, unsigned int const & _MCiterPost = 100): 
-					GGM<GraphStructure, T>(_ptr_prior, _p, _trGwishSampler), MCiterPrior(_MCiterPrior), MCiterPost(_MCiterPost){}
+		AddRemoveMH(PriorPtr& _ptr_prior,double const & _b , MatCol const & _D, double const & _trGwishSampler, unsigned int const & _MCiterPrior = 100, unsigned int const & _MCiterPost = 100,
+					ConstantRatio const & _ratio_mode = ConstantRatio::MC): 
+					GGM<GraphStructure, T>(_ptr_prior, _b, _D, _trGwishSampler), MCiterPrior(_MCiterPrior), MCiterPost(_MCiterPost), ratio_mode(_ratio_mode){}
+		AddRemoveMH(PriorPtr& _ptr_prior,unsigned int const & _p, double const & _trGwishSampler, unsigned int const & _MCiterPrior = 100, unsigned int const & _MCiterPost = 100,
+					ConstantRatio const & _ratio_mode = ConstantRatio::MC): 
+					GGM<GraphStructure, T>(_ptr_prior, _p, _trGwishSampler), MCiterPrior(_MCiterPrior), MCiterPost(_MCiterPost), ratio_mode(_ratio_mode){}
 
 		ReturnType operator()(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, sample::GSL_RNG const & engine = sample::GSL_RNG() ) override ;
+		//The graph move does not depend on the precision matrix, hence all moves are proposed from Gold and evaluated concurrently. The first accepted one is 
+		//committed and the following ones are discarded. Since each move has its own stream, the result does not depend on the number of threads
+		std::vector<ReturnType> speculative_moves(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, 
+												  std::deque<sample::GSL_RNG> const & engines) override;
+		std::unique_ptr<GGM<GraphStructure, T>> clone()const override{
+			return std::make_unique<AddRemoveMH>(*this);
+		}
 	protected:
+		//Graph step of operator(), the precision matrix is not sampled. Gold is modified only if the move is accepted. Returns 1 if accepted, 0 otherwise
+		int graph_move(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, sample::GSL_RNG const & engine);
 		unsigned int MCiterPrior;
 		unsigned int MCiterPost;
+		ConstantRatio ratio_mode;
 		double negative_infinity = -std::numeric_limits<double>::infinity();
 		double infinity = std::numeric_limits<double>::infinity();
 }; 
 
 
 template<template <typename> class GraphStructure, typename T>
-typename GGMTraits<GraphStructure, T>::ReturnType
-AddRemoveMH<GraphStructure, T>::operator()(MatCol const & data, unsigned int const & n, 
-										   typename GGMTraits<GraphStructure, T>::Graph & Gold, double alpha, sample::GSL_RNG const & engine ) 
+int AddRemoveMH<GraphStructure, T>::graph_move(MatCol const & data, unsigned int const & n, 
+											   typename GGMTraits<GraphStructure, T>::Graph & Gold, double alpha, sample::GSL_RNG const & engine ) 
 {
 
 	using Graph = GraphStructure<T>;
 
 	sample::runif rand;
-	//1) Propose new Graph
-	auto [Gnew, log_proposal_Graph, mv_type] = this->propose_new_graph(Gold, alpha, engine) ; //mv_type probably is not used here
-
-	//2) Create GWishart wrt Gnew and wrt posterior parameters
+	//1) Factorize posterior inverse scale matrix, it is needed by informed proposals too
 	if(!this->data_factorized){
-		this->D_plus_U = this->Kprior.get_inv_scale() + data;	
+		this->D_plus_U = this->Kprior.get_inv_scale() + this->beta*data;	
 		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
 		this->data_factorized = true;
 	}
-	PrecisionType Kpost(this->Kprior.get_shape() + n , this->D_plus_U, this->chol_inv_DplusU );
+	//2) Propose new Graph and create GWishart wrt posterior parameters
+	auto [Gnew, log_proposal_Graph, mv_type] = this->propose(Gold, alpha, n, engine) ;
+	PrecisionType Kpost(this->Kprior.get_shape() + this->beta*n , this->D_plus_U, this->chol_inv_DplusU );
 	//3) Compute log acceptance ratio
-	double old_prior_member =  this->Kprior.log_normalizing_constat(Gold.completeview(),MCiterPrior, engine);
-	double old_post_member  =  Kpost.log_normalizing_constat(Gold.completeview(),MCiterPost, engine);
-	double new_post_member  =  Kpost.log_normalizing_constat(Gnew.completeview(),MCiterPost, engine);
-	double new_prior_member =  this->Kprior.log_normalizing_constat(Gnew.completeview(),MCiterPrior, engine);
+	double log_GWishConst_ratio{0}; //log(I_Gold(b,D)/I_Gnew(b,D)) + log(I_Gnew(b+n,D+U)/I_Gold(b+n,D+U))
+	if(ratio_mode == ConstantRatio::Approx){
+		log_GWishConst_ratio = this->log_constant_ratio_approx(Kpost, Gnew, mv_type) - this->log_constant_ratio_approx(this->Kprior, Gnew, mv_type);
+	}
+	else{
+		//The four estimates are independent tasks, each one with its own stream. The MC chunks of each estimate are in turn tasks of the same team (see
+		//GWishart::log_normalizing_constat()), so that all threads are busy across the four estimates. Estimates do not depend on the size of the team.
+		//If already inside a parallel region (speculative execution), the team has a single thread
+		const CompleteType Gold_complete(Gold.completeview());
+		const CompleteType Gnew_complete(Gnew.completeview());
+		std::vector<unsigned int> seeds(4);
+		for(auto & seed : seeds)
+			seed = gsl_rng_get(engine());
+		int n_threads{1};
+		#ifdef PARALLELEXEC
+			if(!omp_in_parallel())
+				n_threads = omp_get_max_threads();
+		#endif
+		double old_prior_member{0}, old_post_member{0}, new_post_member{0}, new_prior_member{0};
+		#pragma omp parallel num_threads(n_threads)
+		{
+			#pragma omp single
+			{
+				#pragma omp task shared(old_prior_member)
+				old_prior_member = this->Kprior.log_normalizing_constat(Gold_complete, MCiterPrior, sample::GSL_RNG (seeds[0]));
+				#pragma omp task shared(old_post_member)
+				old_post_member  = Kpost.log_normalizing_constat(Gold_complete, MCiterPost, sample::GSL_RNG (seeds[1]));
+				#pragma omp task shared(new_post_member)
+				new_post_member  = Kpost.log_normalizing_constat(Gnew_complete, MCiterPost, sample::GSL_RNG (seeds[2]));
+				#pragma omp task shared(new_prior_member)
+				new_prior_member = this->Kprior.log_normalizing_constat(Gnew_complete, MCiterPrior, sample::GSL_RNG (seeds[3]));
+			}
+		}
+		log_GWishConst_ratio = old_prior_member - old_post_member + new_post_member - new_prior_member;
+	}
 
-	double log_acceptance_ratio = this->ptr_prior->log_ratio(Gnew, Gold) + log_proposal_Graph + 
-								old_prior_member - old_post_member + new_post_member - new_prior_member;
+	double log_acceptance_ratio = this->ptr_prior->log_ratio(Gnew, Gold) + log_proposal_Graph + log_GWishConst_ratio;
 
 	
 	double acceptance_ratio = std::min(1.0, std::exp(log_acceptance_ratio)); 
+	this->last_acceptance = acceptance_ratio;
 	//4) Perform the move and return
 	int accepted;
 	if(rand(engine) < acceptance_ratio){ //move is accepted
@@ -75,11 +116,62 @@ AddRemoveMH<GraphStructure, T>::operator()(MatCol const & data, unsigned int con
 	else{ //move is refused
 		accepted = 0;
 	}
+	return accepted;
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+typename GGMTraits<GraphStructure, T>::ReturnType
+AddRemoveMH<GraphStructure, T>::operator()(MatCol const & data, unsigned int const & n, 
+										   typename GGMTraits<GraphStructure, T>::Graph & Gold, double alpha, sample::GSL_RNG const & engine ) 
+{
+	int accepted = this->graph_move(data, n, Gold, alpha, engine);
+	PrecisionType Kpost(this->Kprior.get_shape() + this->beta*n , this->D_plus_U, this->chol_inv_DplusU );
 	Kpost.rgwish(Gold.completeview(), this->trGwishSampler, engine); //Sample new matrix. If the move was accepted, Gold is the new graph
 	return std::make_tuple(Kpost.get_matrix(), accepted); 
 }
 
 
+template<template <typename> class GraphStructure, typename T>
+std::vector<typename GGMTraits<GraphStructure, T>::ReturnType>
+AddRemoveMH<GraphStructure, T>::speculative_moves(MatCol const & data, unsigned int const & n, typename GGMTraits<GraphStructure, T>::Graph & Gold, double alpha, 
+												  std::deque<sample::GSL_RNG> const & engines)
+{
+	if(engines.empty())
+		return std::vector<ReturnType>();
+	//Factorize here, copies used by threads must not do it
+	if(!this->data_factorized){
+		this->D_plus_U = this->Kprior.get_inv_scale() + this->beta*data;	
+		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
+		this->data_factorized = true;
+	}
+	//1) Evaluate all moves from Gold. Graphs are modified only if the move is accepted
+	const IdxType n_moves(engines.size());
+	std::vector<Graph> Gnew(n_moves, Gold);
+	std::vector<int> accepted(n_moves, 0);
+	#pragma omp parallel shared(Gnew, accepted)
+	{
+		AddRemoveMH worker(*this); //graph_move() sets selected_link, each thread needs its own copy
+		#pragma omp for schedule(static,1)
+		for(IdxType j = 0; j < n_moves; ++j)
+			accepted[j] = worker.graph_move(data, n, Gnew[j], alpha, engines[j]);
+	}
+	//2) Moves after the first accepted are discarded
+	const IdxType n_done = std::distance(accepted.cbegin(), std::find(accepted.cbegin(), accepted.cend(), 1)) + 1;
+	const IdxType n_performed = std::min(n_done, n_moves);
+	//3) Sample the precision matrices, each one continues the stream of its move
+	std::vector<ReturnType> res(n_performed);
+	#pragma omp parallel for shared(res)
+	for(IdxType j = 0; j < n_performed; ++j){
+		PrecisionType Kpost(this->Kprior.get_shape() + this->beta*n , this->D_plus_U, this->chol_inv_DplusU );
+		Kpost.rgwish(Gnew[j].completeview(), this->trGwishSampler, engines[j]);
+		res[j] = std::make_tuple(Kpost.get_matrix(), accepted[j]);
+	}
+	Gold = std::move(Gnew[n_performed - 1]);
+	return res;
+}
+
+
 
 #endif
 
@@ -0,0 +1,238 @@
+#ifndef __ASYNCWRITER_HPP__
+#define __ASYNCWRITER_HPP__
+
+#include "HDF5conversion.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <cstring>
+
+/*
+	Writes the sampled values on a background thread, so that the sampling never waits for the disk. Values of each chain dataset are copied in a buffer that
+	holds batch_iter iterations, a chunk of the dataset (see ChunkIterations()). When it is full, the buffer is moved to a bounded queue and a new one is filled
+	meanwhile (double buffering). The writer thread pops the buffers and writes each one by a single hyperslab selection.
+	If the queue is full the sampler waits, hence the memory is bounded. Other tasks, such as the additions to the event log of the graphs, go through the same
+	queue so that everything is written in order. The writer thread serializes its HDF5 calls by means of h5_mutex, as all other threads, tasks that do not call
+	HDF5 (see RawChainWriter) are run without it.
+	Errors of the writer thread are rethrown by the next call of the sampler.
+	flush() and close() can not be called while holding h5_mutex. The writer has to be declared after the datasets and objects used by its tasks.
+*/
+
+namespace HDF5conversion{
+
+	class AsyncWriter{
+		public:
+		AsyncWriter(unsigned int const & _max_queue = 8):max_queue(std::max(_max_queue, 1u)){
+			worker = std::thread(&AsyncWriter::run, this);
+		}
+		//Pending buffers are dropped, it is used only if the sampling failed. Call close() otherwise
+		~AsyncWriter(){
+			{
+				std::lock_guard<std::mutex> lock(mtx);
+				queue.clear();
+				stopping = true;
+			}
+			cv_pop.notify_all();
+			if(worker.joinable())
+				worker.join();
+		}
+		AsyncWriter(AsyncWriter const &) = delete;
+		AsyncWriter & operator=(AsyncWriter const &) = delete;
+		//Registers a dataset created by CreateChainDataset(), each iteration adds block elements of type, or a (rows x block) matrix if rows is positive.
+		//first_iter is the first iteration to be written. Returns the id to be used in push()
+		unsigned int add_dataset(DatasetType const & dataset, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+								 unsigned int const & first_iter = 0, ScalarType const & rows = 0);
+		//Copies the values of iteration iter in the buffer of dataset id, iterations of a dataset have to be consecutive. Matrices are stored row by row
+		template<typename T>
+		void push(unsigned int const & id, T const * values, unsigned int const & iter){
+			this->push_bytes(id, values, sizeof(T), iter);
+		}
+		//As push(), values are elem_size bytes each
+		void push_bytes(unsigned int const & id, void const * values, std::size_t const & elem_size, unsigned int const & iter);
+		//Generic task, it is executed by the writer thread while holding h5_mutex if hdf5 is true
+		void push_task(std::function<void()> task, bool const & hdf5 = true);
+		//Sends the partially filled buffers, without waiting for them to be written
+		void send_all();
+		//Sends the partially filled buffers and waits until everything is written
+		void flush();
+		//Flushes and stops the writer thread. It has to be called before closing the datasets
+		void close();
+		private:
+		struct Staged{
+			DatasetType dataset;
+			DataType type;
+			ScalarType block;
+			ScalarType rows;
+			std::size_t elem_size;
+			unsigned int batch_iter;
+			unsigned int first_iter;
+			unsigned int n_iter{0};
+			std::vector<unsigned char> buffer;
+		};
+		void run();
+		void enqueue(std::function<void()> task, bool const & hdf5 = true);
+		void send(Staged & st);
+		void rethrow();
+		std::vector<Staged> staged;
+		std::deque<std::pair<std::function<void()>, bool>> queue; //tasks and whether they call HDF5
+		unsigned int max_queue;
+		bool stopping{false};
+		bool busy{false};
+		std::exception_ptr error;
+		std::mutex mtx;
+		std::condition_variable cv_push; //notified when the queue has room or is empty
+		std::condition_variable cv_pop;  //notified when a task is available
+		std::thread worker;
+	};
+
+	inline unsigned int AsyncWriter::add_dataset(DatasetType const & dataset, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+												 unsigned int const & first_iter, ScalarType const & rows)
+	{
+		Staged st{dataset, type, block, rows, H5Tget_size(type), 1, first_iter, 0, {}};
+		st.batch_iter = ChunkIterations(std::max(rows, ScalarType(1)) * block * st.elem_size, iter_to_store);
+		st.buffer.resize(std::max(rows, ScalarType(1)) * block * st.batch_iter * st.elem_size);
+		staged.push_back(std::move(st));
+		return staged.size() - 1;
+	}
+
+	inline void AsyncWriter::push_bytes(unsigned int const & id, void const * values, std::size_t const & elem_size, unsigned int const & iter)
+	{
+		rethrow();
+		Staged & st = staged[id];
+		if(elem_size != st.elem_size)
+			throw std::runtime_error("Error in AsyncWriter::push(), the type of the values is not the one of the dataset");
+		if(iter != st.first_iter + st.n_iter)
+			throw std::runtime_error("Error in AsyncWriter::push(), iterations have to be consecutive");
+		const std::size_t row_bytes = st.block * st.elem_size;
+		if(st.rows == 0)
+			std::memcpy(st.buffer.data() + st.n_iter*row_bytes, values, row_bytes);
+		else{ //the buffer is a (rows x batch_iter*block) matrix, as the selection in the dataset
+			for(ScalarType r = 0; r < st.rows; ++r)
+				std::memcpy(st.buffer.data() + (r*st.batch_iter + st.n_iter)*row_bytes, reinterpret_cast<unsigned char const *>(values) + r*row_bytes, row_bytes);
+		}
+		if(++st.n_iter == st.batch_iter)
+			send(st);
+	}
+
+	inline void AsyncWriter::send(Staged & st)
+	{
+		if(st.n_iter == 0)
+			return;
+		std::vector<unsigned char> full(st.buffer.size());
+		full.swap(st.buffer); //st.buffer is filled while full is written
+		const std::size_t row_bytes = st.block * st.elem_size;
+		if(st.rows > 0 && st.n_iter < st.batch_iter){ //make the rows of a partial batch contiguous
+			for(ScalarType r = 1; r < st.rows; ++r)
+				std::memmove(full.data() + r*st.n_iter*row_bytes, full.data() + r*st.batch_iter*row_bytes, st.n_iter*row_bytes);
+		}
+		DatasetType dataset = st.dataset;
+		DataType type = st.type;
+		const ScalarType rows = st.rows;
+		const ScalarType offset = st.first_iter*st.block;
+		const ScalarType length = st.n_iter*st.block;
+		enqueue([dataset, type, rows, offset, length, full = std::move(full)]() mutable{
+			DataspaceType dataspace = H5Dget_space(dataset);
+			ExtendDataset(dataset, dataspace, offset + length);
+			ScalarType start[2] = {0, offset};
+			ScalarType count[2] = {std::max(rows, ScalarType(1)), length};
+			const int rank = (rows > 0) ? 2 : 1;
+			StatusType status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, (rank == 2) ? start : start + 1, NULL, (rank == 2) ? count : count + 1, NULL);
+			ScalarType n_elem = count[0]*count[1];
+			MemspaceType memspace = H5Screate_simple(1, &n_elem, NULL);
+			status = H5Dwrite(dataset, type, memspace, dataspace, H5P_DEFAULT, full.data());
+			H5Sclose(memspace);
+			H5Sclose(dataspace);
+			if(status < 0)
+				throw std::runtime_error("Error in AsyncWriter, can not write on file");
+		});
+		st.first_iter += st.n_iter;
+		st.n_iter = 0;
+	}
+
+	inline void AsyncWriter::push_task(std::function<void()> task, bool const & hdf5)
+	{
+		rethrow();
+		enqueue(std::move(task), hdf5);
+	}
+
+	inline void AsyncWriter::enqueue(std::function<void()> task, bool const & hdf5)
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		cv_push.wait(lock, [this](){return queue.size() < max_queue || error;});
+		if(error)
+			return; //rethrown by the next call
+		queue.emplace_back(std::move(task), hdf5);
+		cv_pop.notify_one();
+	}
+
+	inline void AsyncWriter::send_all()
+	{
+		rethrow();
+		for(auto & st : staged)
+			send(st);
+	}
+
+	inline void AsyncWriter::flush()
+	{
+		send_all();
+		std::unique_lock<std::mutex> lock(mtx);
+		cv_push.wait(lock, [this](){return (queue.empty() && !busy) || error;});
+		lock.unlock();
+		rethrow();
+	}
+
+	inline void AsyncWriter::close()
+	{
+		flush();
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			stopping = true;
+		}
+		cv_pop.notify_all();
+		if(worker.joinable())
+			worker.join();
+	}
+
+	inline void AsyncWriter::rethrow()
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if(error)
+			std::rethrow_exception(error);
+	}
+
+	inline void AsyncWriter::run()
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		while(true){
+			cv_pop.wait(lock, [this](){return !queue.empty() || stopping;});
+			if(queue.empty()) //stopping
+				return;
+			auto [task, hdf5] = std::move(queue.front());
+			queue.pop_front();
+			busy = true;
+			lock.unlock();
+			try{
+				if(hdf5){
+					std::lock_guard<std::mutex> h5_lock(h5_mutex);
+					task();
+				}
+				else
+					task();
+			}
+			catch(...){
+				lock.lock();
+				error = std::current_exception();
+				queue.clear();
+				busy = false;
+				cv_push.notify_all();
+				continue;
+			}
+			lock.lock();
+			busy = false;
+			cv_push.notify_all();
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef __BDMCMC_HPP__
+#define __BDMCMC_HPP__
+
+#include "GGM.h"
+
+/*
+	Continuous time Birth-Death MCMC (Mohammadi and Wit). At each iteration the birth (or death) rate of every possible link is computed,
+		rate_e = min{ 1, pi(G +- e | data) / pi(G | data) },
+	where the ratios of GWishart normalizing constants are evaluated with the closed form approximation given by GWishart::log_normalizing_constat_ratio().
+	Rates do not depend on each other, they are computed in parallel and all of them are used to perform the move. The chain jumps to the graph obtained
+	by adding/removing link e with probability rate_e/sum(rates) and the current graph is kept for a waiting time equal to 1/sum(rates).
+	Differently from MH, RJ and DRJ, the move is always performed. Saved samples have to be weighted by their waiting time, see get_waiting_time().
+	The only exception is a total rate equal to zero, when there are no possible links or all rates underflow. No jump is possible, the current graph is kept
+	and its waiting time is set to one, as in discrete time algorithms.
+	Rates of the current graph are stored and reused in the following iteration, unless data are changing (for example in FGMsampler) or the graph passed
+	to the next call is not the one they were computed for (a swap of ParallelTempering, a resumed checkpoint or a copy made by clone()).
+	The log posterior ratio of adding each link does not depend on the other links (the constants are in closed form and the priors factorize over the links),
+	hence it is computed once per data and the rate of removing a link is obtained by changing its sign. After a jump only the rate of the changed link is updated.
+*/
+
+template<template <typename> class GraphStructure = GraphType, typename T = unsigned int>
+class BirthDeathMCMC : public GGM<GraphStructure, T> {
+
+	public:
+		//Typedefs
+		using IdxType  	  		= typename GGMTraits<GraphStructure, T>::IdxType;
+		using MatRow      		= typename GGMTraits<GraphStructure, T>::MatRow;
+		using MatCol      		= typename GGMTraits<GraphStructure, T>::MatCol;
+		using VecRow      		= typename GGMTraits<GraphStructure, T>::VecRow;
+		using VecCol      		= typename GGMTraits<GraphStructure, T>::VecCol;
+		using CholTypeRow 		= typename GGMTraits<GraphStructure, T>::CholTypeRow;
+		using CholTypeCol 		= typename GGMTraits<GraphStructure, T>::CholTypeCol;
+		using GroupsPtr   		= typename GGMTraits<GraphStructure, T>::GroupsPtr;
+		using PriorPtr			= typename GGMTraits<GraphStructure, T>::PriorPtr;
+		using Graph 			= typename GGMTraits<GraphStructure, T>::Graph;
+		using CompleteType 		= typename GGMTraits<GraphStructure, T>::CompleteType;
+		using PrecisionType     = typename GGMTraits<GraphStructure, T>::PrecisionType;
+		using ReturnType 		= typename GGMTraits<GraphStructure, T>::ReturnType;
+
+		BirthDeathMCMC(PriorPtr& _ptr_prior,double const & _b , MatCol const & _D, double const & _trGwishSampler):
+					   GGM<GraphStructure, T>(_ptr_prior, _b, _D, _trGwishSampler){}
+		BirthDeathMCMC(PriorPtr& _ptr_prior,unsigned int const & _p, double const & _trGwishSampler):
+					   GGM<GraphStructure, T>(_ptr_prior, _p, _trGwishSampler){}
+
+		//The probability of proposing an addition is not used, the type of move is driven by the rates
+		ReturnType operator()(MatCol const & data, unsigned int const & n, Graph & Gold, double, sample::GSL_RNG const & engine = sample::GSL_RNG() ) override ;
+		double get_waiting_time()const override{
+			return waiting_time;
+		}
+		bool is_continuous_time()const override{
+			return true;
+		}
+		std::unique_ptr<GGM<GraphStructure, T>> clone()const override{
+			return std::make_unique<BirthDeathMCMC>(*this);
+		}
+	protected:
+		//Computes the birth/death rates of all possible links of G and its waiting time. Kpost is the posterior GWishart
+		void compute_rates(Graph const & G, PrecisionType const & Kpost);
+		//Updates the rates after the link in position pos has been changed
+		void update_rate(IdxType const & pos);
+		//Sums the rates and sets the waiting time of the current graph
+		void set_waiting_time();
+		std::vector<double> rates; //rates[pos] is the rate of the link in position pos of the adjacency list
+		std::vector<double> log_ratio_add; //log posterior ratio of adding the link in position pos, it does not depend on the current graph
+		std::vector<unsigned int> present; //present[pos] is 1 if the link in position pos belongs to the graph whose rates are stored
+		std::vector<std::pair<unsigned int, unsigned int>> links; //links[pos] is pos_to_ij(pos), positions do not change
+		double total_rate{0.0}; //zero if no jump is possible
+		double waiting_time{1.0};
+		bool rates_available{false};
+};
+
+
+template<template <typename> class GraphStructure, typename T>
+void BirthDeathMCMC<GraphStructure, T>::compute_rates(typename GGMTraits<GraphStructure, T>::Graph const & G, PrecisionType const & Kpost)
+{
+	const unsigned int n_rates(this->positions.size());
+	if(links.size() != n_rates){
+		links.resize(n_rates);
+		#pragma omp parallel for shared(links)
+		for(IdxType pos = 0; pos < n_rates; ++pos)
+			links[pos] = G.pos_to_ij(pos);
+	}
+	const auto adj(G.get_adj_list());
+	present.assign(adj.cbegin(), adj.cend());
+	rates.resize(n_rates);
+	log_ratio_add.resize(n_rates);
+	#pragma omp parallel for shared(rates, log_ratio_add)
+	for(IdxType pos = 0; pos < n_rates; ++pos){
+		log_ratio_add[pos] = this->log_posterior_ratio_approx(G, links[pos], MoveType::Add, Kpost);
+		const double log_rate = (present[pos]) ? -log_ratio_add[pos] : log_ratio_add[pos];
+		rates[pos] = (log_rate < 0.0) ? std::exp(log_rate) : 1.0;
+	}
+	set_waiting_time();
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+void BirthDeathMCMC<GraphStructure, T>::update_rate(IdxType const & pos)
+{
+	present[pos] = 1 - present[pos];
+	const double log_rate = (present[pos]) ? -log_ratio_add[pos] : log_ratio_add[pos];
+	rates[pos] = (log_rate < 0.0) ? std::exp(log_rate) : 1.0;
+	set_waiting_time();
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+void BirthDeathMCMC<GraphStructure, T>::set_waiting_time()
+{
+	total_rate = std::accumulate(rates.cbegin(), rates.cend(), 0.0);
+	waiting_time = (total_rate > 0.0) ? 1.0/total_rate : 1.0; //the graph can not be left, see the description of the class
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+typename GGMTraits<GraphStructure, T>::ReturnType
+BirthDeathMCMC<GraphStructure, T>::operator()(MatCol const & data, unsigned int const & n,
+										   	  typename GGMTraits<GraphStructure, T>::Graph & Gold, double, sample::GSL_RNG const & engine )
+{
+
+	sample::runif rand;
+
+	//1) Posterior GWishart. If data changed, the rates of Gold are not valid anymore
+	if(!this->data_factorized){
+		this->D_plus_U = this->Kprior.get_inv_scale() + this->beta*data;
+		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
+		this->data_factorized = true;
+		rates_available = false;
+	}
+	PrecisionType Kpost(this->Kprior.get_shape() + this->beta*n , this->D_plus_U, this->chol_inv_DplusU );
+	if(rates_available){ //stored rates are valid only if they refer to Gold, that may not be the graph left by the previous call
+		const auto adj(Gold.get_adj_list());
+		rates_available = std::equal(adj.cbegin(), adj.cend(), present.cbegin(), present.cend());
+	}
+	if(!rates_available){
+		compute_rates(Gold, Kpost);
+		rates_available = true;
+	}
+
+	//2) Select the link to be changed proportionally to its rate and perform the jump. Gold is kept if no jump is possible
+	int accepted{0};
+	if(total_rate > 0.0){
+		const double u( rand(engine) * total_rate ); //uniform in (0, sum(rates))
+		double cumulative_rate{0};
+		IdxType selected{0};
+		for(; selected < rates.size() - 1; ++selected){
+			cumulative_rate += rates[selected];
+			if(u < cumulative_rate)
+				break;
+		}
+		while(rates[selected] == 0.0) //u may reach the total rate because of rounding, a link that can not be changed is never selected
+			--selected;
+		this->selected_link = links[selected];
+		Gold = this->change_link(Gold, selected).first;
+		accepted = 1;
+		//3) Rates of the new graph, they also give its waiting time. Only the changed link has a different rate
+		update_rate(selected);
+	}
+	Kpost.rgwish(Gold.completeview(), this->trGwishSampler, engine); //Sample new matrix according to the new graph
+	return std::make_tuple(Kpost.get_matrix(), accepted);
+}
+
+
+
+#endif
+
@@ -355,45 +355,41 @@ Rcpp::List Generate_Basis_derivatives(int const & n_basis, int const & nderiv, R
 }
 
 
+//Read_InfoFile() on a file that is already open
+static Rcpp::List InfoFile_ResultFile( analysis::ResultFile & result )
+{
+  auto const & info = result.get_info();
+  return  Rcpp::List::create ( Rcpp::Named("p") = info[0], 
+                               Rcpp::Named("n") = info[1], 
+                               Rcpp::Named("stored_iter") = info[2],   
+                               Rcpp::Named("stored_iterG") = info[3],
+                               Rcpp::Named("niter") = (info.size() > 4) ? Rcpp::wrap(info[4]) : R_NilValue,
+                               Rcpp::Named("sampler") = result.get_sampler(),
+                               Rcpp::Named("nchains") = result.get_nchains(),
+                               Rcpp::Named("sigmaG") = HDF5conversion::ReadScalarDataset(result.get_file(), "SigmaG")
+                             );
+}
+
 //' Read information from file
 //'
 //' \loadmathjax Read from \code{file_name} some information that are needed to extract data from it. 
 //' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
 //' @return It returns a list containing \code{p}, the dimension of the graph, \code{n} the number of observed data, \code{stored_iter} the number of saved iterations for the regression parameters,
 //' \code{stored_iterG} the number of saved iterations for the graphical related quantities, i.e the graph and the precision matrix. Finally, \code{sampler} recalls what type of sampler was used. 
-//' Possibilities are \code{"GGMsampler"}, \code{"FGMsampler"}, \code{"FLMsampler_diagonal"} or \code{"FLMsampler_fixed"}.
+//' Possibilities are \code{"GGMsampler"}, \code{"FGMsampler"}, \code{"FLMsampler_diagonal"} or \code{"FLMsampler_fixed"}. 
+//' \code{nchains} is the number of independent chains saved in the file, the information above refers to each of them.
+//' \code{sigmaG} contains the value of \code{sigmaG} tuned during burn-in for each chain, it is empty if the adaptation was not requested. \code{niter} is the number of performed iterations, it is smaller than the requested one if the sampling stopped early, see \code{target_ess} in \code{\link{sampler_parameters}}. It is \code{NULL} for files that do not record it.
 //' @export
 // [[Rcpp::export]]
 Rcpp::List Read_InfoFile( Rcpp::String const & file_name )
 {
-  //std::vector< unsigned int > info =  HDF5conversion::GetInfo(file_name);
-  auto [info, sampler] =  HDF5conversion::GetInfo(file_name);
-  return  Rcpp::List::create ( Rcpp::Named("p") = info[0], 
-                               Rcpp::Named("n") = info[1], 
-                               Rcpp::Named("stored_iter") = info[2],   
-                               Rcpp::Named("stored_iterG") = info[3],
-                               Rcpp::Named("sampler") = sampler
-                             );
+  analysis::ResultFile result(file_name);
+  return InfoFile_ResultFile(result);
 }
 
 
-//' Compute quantiles of sampled values
-//'
-//' \loadmathjax This function reads the sampled values saved in a binary file and computes the quantiles of the desired level.
-//' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
-//' @param Beta boolean, set \code{TRUE} to compute the quantiles for all \code{p*n} \mjseqn{\beta} coefficients. It may require long time.
-//' @param Mu boolean, set \code{TRUE} to compute the quantiles for all \mjseqn{p} parameters. 
-//' @param TauEps boolean, set \code{TRUE} to compute the quantiles of \mjseqn{\tau_{\epsilon}} parameter.
-//' @param Precision boolean, set \code{TRUE} to compute the mean for all the elements of the precision matrix 
-//' or the \mjseqn{\tau_{j}} coefficients if the file contains the output of a \code{\link{FLM_sampling}}, diagonal version.
-//' @param lower_qtl the level of the first desired quantile.
-//' @param upper_qtl the level of the second desired quantile.
-//'
-//' @return It returns a list containig the upper and lower quantiles of the requested quantities.
-//' @export
-// [[Rcpp::export]]
-Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false, bool Mu = false, bool TauEps = false, bool Precision = false,
-                               double const & lower_qtl = 0.05, double const & upper_qtl = 0.95  )
+//Compute_Quantiles() on a file that is already open
+static Rcpp::List Quantiles_ResultFile( analysis::ResultFile & result, bool Beta, bool Mu, bool TauEps, bool Precision, double const & lower_qtl, double const & upper_qtl, int chain )
 {
   
   Rcpp::List Quantiles = Rcpp::List::create( Rcpp::Named("Beta"),      
@@ -403,13 +399,15 @@ Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false,
                                            );
 
   //Read file info
-  auto [info, sampler] =  HDF5conversion::GetInfo(file_name);
+  auto const & info = result.get_info();
+  auto const & sampler = result.get_sampler();
   const unsigned int& p = info[0];
   const unsigned int& n = info[1];
   const unsigned int& stored_iter  = info[2];
   const unsigned int& stored_iterG = info[3]; 
   if(!(sampler == "FLMsampler_diagonal" || sampler == "FLMsampler_fixed" || sampler == "FGMsampler" || sampler == "GGMsampler"))
     throw std::runtime_error("Unrecognized sampler type, it can only be: FLMsampler_diagonal, FLMsampler_fixed, FGMsampler or GGMsampler");
+  const std::vector<std::string> chain_groups = result.chain_groups(chain);
 
   if(!(Precision || Beta || Mu || TauEps))
     Rcpp::Rcout<<"All possible parameters were FALSE, no mean has been computed"<<std::endl;
@@ -421,13 +419,13 @@ Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false,
     if(sampler == "FLMsampler_diagonal"){
       prec_elem = p;
       Rcpp::Rcout<<"Compute TauK quantiles..."<<std::endl;
-      auto [Lower, Upper] =  analysis::Vector_ComputeQuantiles( file_name, stored_iterG, prec_elem, "Precision", lower_qtl, upper_qtl );
+      auto [Lower, Upper] =  analysis::Vector_ComputeQuantiles( result.get_file(), stored_iterG, prec_elem, "Precision", lower_qtl, upper_qtl, chain_groups );
       Quantiles["Precision"] = Rcpp::List::create(Rcpp::Named("Lower")=Lower, Rcpp::Named("Upper")=Upper);
     }
     else{
       prec_elem = 0.5*p*(p+1);
       Rcpp::Rcout<<"Compute Precision quantiles..."<<std::endl;
-      auto [Lower_vett, Upper_vett] =  analysis::Vector_ComputeQuantiles( file_name, stored_iterG, prec_elem, "Precision", lower_qtl, upper_qtl );
+      auto [Lower_vett, Upper_vett] =  analysis::Vector_ComputeQuantiles( result.get_file(), stored_iterG, prec_elem, "Precision", lower_qtl, upper_qtl, chain_groups );
       MatRow Lower(MatRow::Zero(p,p));  
       MatRow Upper(MatRow::Zero(p,p));  
       unsigned int pos{0};
@@ -448,7 +446,7 @@ Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false,
     if(stored_iter <= 0)
       throw std::runtime_error("stored_iter parameter has to be positive");
     Rcpp::Rcout<<"Compute Beta quantiles..."<<std::endl;
-    auto [Lower, Upper] =  analysis::Matrix_ComputeQuantiles( file_name, stored_iter, p, n, lower_qtl, upper_qtl );
+    auto [Lower, Upper] =  analysis::Matrix_ComputeQuantiles( result.get_file(), stored_iter, p, n, lower_qtl, upper_qtl, chain_groups );
     Quantiles["Beta"] = Rcpp::List::create(Rcpp::Named("Lower")=Lower, Rcpp::Named("Upper")=Upper);
   }
   if(Mu){
@@ -457,7 +455,7 @@ Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false,
     if(stored_iter <= 0)
       throw std::runtime_error("stored_iter parameter has to be positive");
     Rcpp::Rcout<<"Compute Mu quantiles..."<<std::endl;
-    auto [Lower, Upper] =  analysis::Vector_ComputeQuantiles( file_name, stored_iter, p, "Mu", lower_qtl, upper_qtl );
+    auto [Lower, Upper] =  analysis::Vector_ComputeQuantiles( result.get_file(), stored_iter, p, "Mu", lower_qtl, upper_qtl, chain_groups );
     Quantiles["Mu"] = Rcpp::List::create(Rcpp::Named("Lower")=Lower, Rcpp::Named("Upper")=Upper);
   }
   if(TauEps){
@@ -466,26 +464,38 @@ Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false,
     if(stored_iter <= 0)
       throw std::runtime_error("stored_iter parameter has to be positive");
     Rcpp::Rcout<<"Compute TauEps quantiles..."<<std::endl;
-    auto [Lower, Upper] =  analysis::Scalar_ComputeQuantiles( file_name, stored_iter, lower_qtl, upper_qtl );
+    auto [Lower, Upper] =  analysis::Scalar_ComputeQuantiles( result.get_file(), stored_iter, lower_qtl, upper_qtl, chain_groups );
     Quantiles["TauEps"] = Rcpp::List::create(Rcpp::Named("Lower")=Lower, Rcpp::Named("Upper")=Upper);
   }
   return Quantiles;
 }
 
-
-//' Compute Posterior means of sampled values
+//' Compute quantiles of sampled values
 //'
-//' \loadmathjax This function reads the sampled values saved in a binary file and computes the mean of the requested quantities.
+//' \loadmathjax This function reads the sampled values saved in a binary file and computes the quantiles of the desired level. If the sampled values were not saved, see \code{store_chain} in \code{\link{sampler_parameters}}, the quantiles estimated during the sampling are returned. In that case the levels have to be the ones used for the sampling.
 //' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
-//' @param Beta boolean, set \code{TRUE} to compute the mean for all \code{p*n} \mjseqn{\beta} coefficients. It may require long time.
-//' @param Mu boolean, set \code{TRUE} to compute the mean for all \mjseqn{p} parameters. 
-//' @param TauEps boolean, set \code{TRUE} to compute the mean of \mjseqn{\tau_{\epsilon}} parameter.
+//' @param Beta boolean, set \code{TRUE} to compute the quantiles for all \code{p*n} \mjseqn{\beta} coefficients. It may require long time.
+//' @param Mu boolean, set \code{TRUE} to compute the quantiles for all \mjseqn{p} parameters. 
+//' @param TauEps boolean, set \code{TRUE} to compute the quantiles of \mjseqn{\tau_{\epsilon}} parameter.
 //' @param Precision boolean, set \code{TRUE} to compute the mean for all the elements of the precision matrix 
 //' or the \mjseqn{\tau_{j}} coefficients if the file contains the output of a \code{\link{FLM_sampling}}, diagonal version.
-//' @return It returns a list containig the mean of the requested quantities.
+//' @param lower_qtl the level of the first desired quantile.
+//' @param upper_qtl the level of the second desired quantile.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//'
+//' @return It returns a list containig the upper and lower quantiles of the requested quantities.
 //' @export
 // [[Rcpp::export]]
-Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = false, bool Mu = false, bool TauEps = false, bool Precision = false)
+Rcpp::List Compute_Quantiles( Rcpp::String const & file_name, bool Beta = false, bool Mu = false, bool TauEps = false, bool Precision = false,
+                               double const & lower_qtl = 0.05, double const & upper_qtl = 0.95, int chain = 0  )
+{
+  analysis::ResultFile result(file_name);
+  return Quantiles_ResultFile(result, Beta, Mu, TauEps, Precision, lower_qtl, upper_qtl, chain);
+}
+
+
+//Compute_PosteriorMeans() on a file that is already open
+static Rcpp::List PosteriorMeans_ResultFile( analysis::ResultFile & result, bool Beta, bool Mu, bool TauEps, bool Precision, int chain )
 {
 
   Rcpp::List PosteriorMeans = Rcpp::List::create ( Rcpp::Named("MeanBeta"), 
@@ -493,13 +503,15 @@ Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = f
                                                    Rcpp::Named("MeanK"),   
                                                    Rcpp::Named("MeanTaueps") );  
   //Read file info
-  auto [info, sampler] =  HDF5conversion::GetInfo(file_name);
+  auto const & info = result.get_info();
+  auto const & sampler = result.get_sampler();
   const unsigned int& p = info[0];
   const unsigned int& n = info[1];
   const unsigned int& stored_iter = info[2];
   const unsigned int& stored_iterG = info[3];
   if(!(sampler == "FLMsampler_diagonal" || sampler == "FLMsampler_fixed" || sampler == "FGMsampler" || sampler == "GGMsampler"))
     throw std::runtime_error("Unrecognized sampler type, it can only be: FLMsampler_diagonal, FLMsampler_fixed, FGMsampler or GGMsampler");
+  const std::vector<std::string> chain_groups = result.chain_groups(chain);
 
   if(!(Precision || Beta || Mu || TauEps))
     Rcpp::Rcout<<"All possible parameters were FALSE, no mean has been computed"<<std::endl;
@@ -509,13 +521,13 @@ Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = f
     unsigned int  prec_elem = 0;
     if(sampler == "FLMsampler_diagonal"){
       prec_elem = p;
-      VecCol MeanK_vett = analysis::Vector_PointwiseEstimate(file_name, stored_iterG, prec_elem, "Precision" );
+      VecCol MeanK_vett = analysis::Vector_PointwiseEstimate(result.get_file(), stored_iterG, prec_elem, "Precision", chain_groups );
       PosteriorMeans["MeanK"] = MeanK_vett;
     }
     else{
       prec_elem = 0.5*p*(p+1);
       MatRow MeanK(MatRow::Zero(p,p));  
-      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate(file_name, stored_iterG, prec_elem, "Precision" );
+      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate(result.get_file(), stored_iterG, prec_elem, "Precision", chain_groups );
       unsigned int pos{0};
       for(unsigned int i = 0; i < p; ++i){
         for(unsigned int j = i; j < p; ++j){
@@ -530,7 +542,7 @@ Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = f
       throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no Beta coefficient for this sampler.");
     if(stored_iter <= 0)
       throw std::runtime_error("stored_iter parameter has to be positive");
-    MatCol MeanBeta = analysis::Matrix_PointwiseEstimate( file_name, stored_iter, p, n );
+    MatCol MeanBeta = analysis::Matrix_PointwiseEstimate( result.get_file(), stored_iter, p, n, chain_groups );
     PosteriorMeans["MeanBeta"] = MeanBeta;
   }
   if(Mu){
@@ -538,7 +550,7 @@ Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = f
       throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no Mu coefficient for this sampler."); 
     if(stored_iter <= 0)
       throw std::runtime_error("stored_iter parameter has to be positive");
-    VecCol MeanMu = analysis::Vector_PointwiseEstimate( file_name, stored_iter, p, "Mu" );
+    VecCol MeanMu = analysis::Vector_PointwiseEstimate( result.get_file(), stored_iter, p, "Mu", chain_groups );
     PosteriorMeans["MeanMu"] = MeanMu;
   }
   if(TauEps){
@@ -546,12 +558,91 @@ Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = f
       throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no TauEps coefficient for this sampler.");
     if(stored_iter <= 0)
       throw std::runtime_error("stored_iter parameter has to be positive");
-    double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name, stored_iter );
+    double MeanTaueps =  analysis::Scalar_PointwiseEstimate( result.get_file(), stored_iter, chain_groups );
     PosteriorMeans["MeanTaueps"] = MeanTaueps;
   }
   return PosteriorMeans;
 }
 
+//' Compute Posterior means of sampled values
+//'
+//' \loadmathjax This function reads the sampled values saved in a binary file and computes the mean of the requested quantities. If the sampled values were not saved, see \code{store_chain} in \code{\link{sampler_parameters}}, the means computed during the sampling are returned.
+//' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
+//' @param Beta boolean, set \code{TRUE} to compute the mean for all \code{p*n} \mjseqn{\beta} coefficients. It may require long time.
+//' @param Mu boolean, set \code{TRUE} to compute the mean for all \mjseqn{p} parameters. 
+//' @param TauEps boolean, set \code{TRUE} to compute the mean of \mjseqn{\tau_{\epsilon}} parameter.
+//' @param Precision boolean, set \code{TRUE} to compute the mean for all the elements of the precision matrix 
+//' or the \mjseqn{\tau_{j}} coefficients if the file contains the output of a \code{\link{FLM_sampling}}, diagonal version.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//' @return It returns a list containig the mean of the requested quantities.
+//' @export
+// [[Rcpp::export]]
+Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = false, bool Mu = false, bool TauEps = false, bool Precision = false, int chain = 0)
+{
+  analysis::ResultFile result(file_name);
+  return PosteriorMeans_ResultFile(result, Beta, Mu, TauEps, Precision, chain);
+}
+
+
+//Chains of the elements (index1[k], index2[k]) of variable, indices start from 0 and index2 is used only for Beta. Returns a matrix whose k-th column is the chain
+//of the k-th element, chains saved in the file are one after the other. Datasets stay open in result, close elements are read together, see analysis::Read_Chains().
+//Chains that are memory mapped are copied from the map
+static Eigen::MatrixXd Chains_ResultFile( analysis::ResultFile & result, std::string const & variable, std::vector<unsigned int> const & index1, 
+                                          std::vector<unsigned int> const & index2, int chain )
+{
+  if(variable != "Beta" && variable != "Mu" && variable != "Precision" && variable != "TauEps")
+    throw std::runtime_error("Error, only possible values for variable are Beta, Precision, Mu, TauEps");
+  if(index2.size() != index1.size())
+    throw std::runtime_error("Error, index1 and index2 must have the same length");
+
+  //Read file info
+  auto const & info = result.get_info();
+  auto const & sampler = result.get_sampler();
+  const unsigned int& p = info[0];
+  const unsigned int& n = info[1];
+  const unsigned int& stored_iter = info[2];
+  const unsigned int& stored_iterG = info[3];
+  if(!(sampler == "FLMsampler_diagonal" || sampler == "FLMsampler_fixed" || sampler == "FGMsampler" || sampler == "GGMsampler"))
+    throw std::runtime_error("Unrecognized sampler type, it can only be: FLMsampler_diagonal, FLMsampler_fixed, FGMsampler or GGMsampler");
+  if(variable != "Precision" && sampler == "GGMsampler")
+    throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no " + variable + " coefficient for this sampler.");
+
+  //Index of each element in the dataset and number of elements saved by each iteration
+  std::vector<unsigned int> elements(index1.size(), 0);
+  unsigned int n_elem{1};
+  unsigned int row_length{1};
+  unsigned int n_iter{stored_iter};
+  if(variable == "Beta"){
+    if(n <= 0)
+      throw std::runtime_error("The number of observed data n has to be provided to extract the chain for Beta");
+    n_elem = p*n;
+    row_length = n;
+    for(std::size_t k = 0; k < index1.size(); ++k){
+      if(index2[k] >= n)
+        throw std::runtime_error("Invalid index2 request. It exceeds the number of curves");
+      elements[k] = index1[k]*n + index2[k];
+    }
+  }
+  else if(variable == "Mu" || variable == "Precision"){
+    n_elem = p;
+    if(variable == "Precision"){
+      n_elem = (sampler == "FLMsampler_diagonal") ? p : 0.5*p*(p+1);
+      n_iter = stored_iterG; //Precision matrices are saved with graphs
+    }
+    elements = index1;
+  }
+  if(std::any_of(elements.cbegin(), elements.cend(), [&n_elem](unsigned int const & e){return e >= n_elem;}))
+    throw std::runtime_error("Invalid index1 request. It exceeds the number of elements of " + variable);
+
+  //Chains saved in the file are returned one after the other. The chain-major copy is read if available
+  const std::vector<std::string> chain_groups = result.chain_groups(chain);
+  Eigen::MatrixXd chains(n_iter*chain_groups.size(), elements.size());
+  for(std::size_t g = 0; g < chain_groups.size(); ++g){
+    const MatRow values(analysis::Read_Chains(result.get_chain(chain_groups[g], variable), elements, n_iter, row_length));
+    chains.middleRows(g*n_iter, n_iter) = values.transpose();
+  }
+  return chains;
+}
 
 //' Read chain from file
 //'
@@ -568,100 +659,125 @@ Rcpp::List Compute_PosteriorMeans( Rcpp::String const & file_name, bool Beta = f
 //' Instead, for outputs coming from \code{FLM} sampler with diagonal graph, only the diagonal of the precision matrix is saved. If so, \code{index1} ranges from 1 up to \mjseqn{p}. Moreover, set \code{prec_ele} eqaul to \mjseqn{p}.
 //' If \code{variable} is equal to \code{"Beta"}, this index ranges for 1 up to \mjseqn{p}, it represents the spine coefficinet.
 //' @param index2 integer, to be used only if \code{variable} is equal to \code{"Beta"}. It ranges from 1 up to \mjseqn{n}. In this case, the chain for the spline_index-th coefficients of the curve_index-th curve is read.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to get all the chains one after the other, \code{k} to read only the \code{k}-th one.
 //'
 //' @return It returns a numeric vector all the sampled values of the required element.
 //' @export
 // [[Rcpp::export]]
-Eigen::VectorXd Extract_Chain( Rcpp::String const & file_name, Rcpp::String const & variable, unsigned int  index1 = 1, unsigned int index2 = 1 )
+Eigen::VectorXd Extract_Chain( Rcpp::String const & file_name, Rcpp::String const & variable, unsigned int  index1 = 1, unsigned int index2 = 1, int chain = 0 )
 { 
-
-  if(variable != "Beta" && variable != "Mu" && variable != "Precision" && variable != "TauEps")
-    throw std::runtime_error("Error, only possible values for variable are Beta, Precision, Mu, TauEps");
-
   if(index1 <= 0 || index2 <= 0)
     throw std::runtime_error("index1 and index2 parameters start counting from 1, not from 0. The first element corresponds to index 1, not 0. The inserted values has to be strictly positive");
+  analysis::ResultFile result(file_name);
+  return Chains_ResultFile(result, variable, {index1 - 1}, {index2 - 1}, chain).col(0);
+}
 
-  index1 = index1 - 1;
-  index2 = index2 - 1;
-
-  HDF5conversion::FileType file;
-  HDF5conversion::DatasetType dataset_rd;
-  std::string file_name_stl{file_name};
+//' Read chain from the file of a running sampling
+//'
+//' \loadmathjax As \code{\link{Extract_Chain}}, but it also reads the file of a sampling that is still running in live mode, see \code{flush_every} in \code{\link{sampler_parameters}}.
+//' It returns the values that the sampler made visible so far, up to \code{flush_every} iterations behind the current one. Call it again to get the new ones,
+//' e.g to draw the traceplot or to compute partial summaries of a long run without stopping it. Files of completed or interrupted samplings are read as well.
+//' @param file_name, string with the name of the file, as given to the sampler. It has to include the extension, usually \code{.h5}.
+//' @param variable string, the name of the dataset to be read from the file. Only possibilities are \code{"Beta"}, \code{"Mu"}, \code{"Precision"} and \code{"TauEps"}.
+//' @param index1 integer, the index of the element whose chain has to read from the file, as in \code{\link{Extract_Chain}}.
+//' @param index2 integer, to be used only if \code{variable} is equal to \code{"Beta"}, as in \code{\link{Extract_Chain}}.
+//' @param chain integer, used only if the sampling runs more than one chain. While they run, each chain writes its own file, hence only one chain at the time can be read:
+//' set \code{k} to read the \code{k}-th one. Set 0 to get all the chains one after the other once the sampling is over.
+//'
+//' @return It returns a numeric vector with the values of the required element saved so far.
+//' @export
+// [[Rcpp::export]]
+Eigen::VectorXd Extract_LiveChain( Rcpp::String const & file_name, Rcpp::String const & variable, unsigned int index1 = 1, unsigned int index2 = 1, int chain = 0 )
+{
+  if(index1 <= 0 || index2 <= 0)
+    throw std::runtime_error("index1 and index2 parameters start counting from 1, not from 0. The first element corresponds to index 1, not 0. The inserted values has to be strictly positive");
+  const std::string name(file_name);
+  if(chain > 0){ //while the chains run, the k-th one writes its own file, see chains::run_chains()
+    const std::string base((name.size() > 3 && name.compare(name.size() - 3, 3, ".h5") == 0) ? name.substr(0, name.size() - 3) : name);
+    const std::string chain_file(chains::chain_file_name(base, chain) + ".h5");
+    if(std::ifstream(chain_file).good()){
+      analysis::ResultFile result(chain_file, true);
+      return Chains_ResultFile(result, variable, {index1 - 1}, {index2 - 1}, 0).col(0);
+    }
+  }
+  analysis::ResultFile result(name, true);
+  return Chains_ResultFile(result, variable, {index1 - 1}, {index2 - 1}, chain).col(0);
+}
 
-  //Read file info
-  auto [info, sampler] =  HDF5conversion::GetInfo(file_name);
-  const unsigned int& p = info[0];
-  const unsigned int& n = info[1];
-  const unsigned int& stored_iter = info[2];
+//' Store the chains by parameter
+//'
+//' \loadmathjax Sampled values are saved iteration by iteration, hence the chain of a single element is scattered in the whole file and reading it requires a 
+//' large number of small reads. This function adds to the file a second copy of the chains of \code{"Beta"}, \code{"Mu"} and \code{"Precision"} where the chain of each element 
+//' is stored contiguously. \code{\link{Extract_Chain}} and \code{\link{Compute_Quantiles}} use it when available, reading the chains sequentially.
+//' The copy is obtained by blocks, the memory used does not depend on the number of saved iterations. Call it once the sampling is over, 
+//' it doubles the space required by the chains on disk. Chains that were not stored, see \code{store_chain} in \code{\link{sampler_parameters}}, are skipped,
+//' as the ones saved in the raw format (see \code{chain_format}), that are read through a memory map without copies.
+//' @param file_name, string with the name of the file to be modified. It has to include the extension, usually \code{.h5}.
+//' @param contiguous boolean, if \code{TRUE} the copy is stored contiguously and uncompressed, so that \code{\link{Extract_Chain}}, \code{\link{Compute_Quantiles}} 
+//' and \code{\link{Compute_PosteriorMeans}} memory map it and read the values in place. Not available on Windows, where the copy is read as usual. 
+//' If \code{FALSE} the copy is compressed, it requires less space on disk.
+//'
+//' @return It returns nothing, the file is modified.
+//' @export
+// [[Rcpp::export]]
+void Transpose_Chains(Rcpp::String const & file_name, bool const & contiguous = true)
+{
+  auto [info, sampler] = HDF5conversion::GetInfo(file_name);
+  const unsigned int& stored_iter  = info[2];
   const unsigned int& stored_iterG = info[3];
   if(!(sampler == "FLMsampler_diagonal" || sampler == "FLMsampler_fixed" || sampler == "FGMsampler" || sampler == "GGMsampler"))
     throw std::runtime_error("Unrecognized sampler type, it can only be: FLMsampler_diagonal, FLMsampler_fixed, FGMsampler or GGMsampler");
-
-  //Open file
-  file=H5Fopen(file_name_stl.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
+  std::string file_name_stl{file_name};
+  const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(file_name_stl);
+  //Large datasets are aligned to pages, so that contiguous copies are mapped from their first value
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_alignment(fapl, 4096, 4096);
+  HDF5conversion::FileType file = H5Fopen(file_name_stl.data(), H5F_ACC_RDWR, fapl);
+  H5Pclose(fapl);
   if(file < 0)
     throw std::runtime_error("Error, can not open the file. Probably it was not closed correctly");
-
-  std::vector<double> chain;
-  if(variable == "Beta"){
-    if(sampler == "GGMsampler")
-      throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no Beta coefficient for this sampler.");
-    if(n <= 0)
-      throw std::runtime_error("The number of observed data n has to be provided to extract the chain for Beta");
-    //Open datasets
-    dataset_rd  = H5Dopen(file, "/Beta", H5P_DEFAULT);
-    if(dataset_rd < 0)
-      throw std::runtime_error("Error, can not open dataset for Beta ");
-    chain = HDF5conversion::GetChain_from_Matrix(dataset_rd, index1, index2, stored_iter, n);
-    H5Dclose(dataset_rd);
-  }
-  else if(variable == "Mu"){
-    if(sampler == "GGMsampler")
-      throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no Mu coefficient for this sampler.");
-    //Open datasets
-    dataset_rd  = H5Dopen(file, "/Mu", H5P_DEFAULT);
-    if(dataset_rd < 0)
-      throw std::runtime_error("Error, can not open dataset for MU");
-    chain = HDF5conversion::GetChain_from_Vector(dataset_rd, index1, stored_iter, p);
-    H5Dclose(dataset_rd);
-  }
-  else if(variable == "Precision"){
-    unsigned int prec_elem{0};
-    if(sampler == "FLMsampler_diagonal"){
-      prec_elem = p;
+  const std::array<std::string, 3> chain_names{"Beta", "Mu", "Precision"};
+  for(auto const & group : chain_groups){
+    if(HDF5conversion::GetChainFormat(file, group) == HDF5conversion::ChainFormat::Raw) //raw chains are read through a memory map as they are
+      continue;
+    for(std::string const & name : chain_names){
+      if(analysis::Chain_Stored(file, group, name)) //Precision matrices are saved with graphs
+        HDF5conversion::TransposeChain(file, group, name, (name == "Precision") ? stored_iterG : stored_iter, 67108864, contiguous);
     }
-    else{
-      prec_elem = 0.5*p*(p+1);
-    }    
-    //Open datasets
-    dataset_rd  = H5Dopen(file, "/Precision", H5P_DEFAULT);
-    if(dataset_rd < 0)
-      throw std::runtime_error("Error, can not open dataset for Precision");
-    chain = HDF5conversion::GetChain_from_Vector(dataset_rd, index1, stored_iter, prec_elem);
-    H5Dclose(dataset_rd);
-  }
-  else if(variable == "TauEps"){
-    if(sampler == "GGMsampler")
-      throw std::runtime_error("The file was recognized as output of a GGMsampler. There is no TauEps coefficient for this sampler.");
-    //Open datasets
-    dataset_rd  = H5Dopen(file, "/TauEps", H5P_DEFAULT);
-    if(dataset_rd < 0)
-      throw std::runtime_error("Error, can not open the dataset for TauEps");
-    chain.resize(stored_iter);
-    double * buffer = chain.data();
-    HDF5conversion::StatusType status = H5Dread(dataset_rd, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer);
-    if(status < 0)
-      throw std::runtime_error("Error, can not read the chain for TauEps");
-    H5Dclose(dataset_rd);
-  }
-  else{
-    throw std::runtime_error("Error, only possible values for variable are Beta, Precision, Mu, TauEps");
+    Rcpp::checkUserInterrupt();
   }
-
   H5Fclose(file);
+}
 
-  Eigen::Map< Eigen::VectorXd > result(&(chain[0]), chain.size());
-  return result;
+//Summary_Graph() on a file that is already open
+static Rcpp::List SummaryGraph_ResultFile(analysis::ResultFile & result, Rcpp::Nullable<Rcpp::List> groups, int chain, int top_k)
+{
+  //Read file info
+  auto const & info = result.get_info();
+  auto const & sampler = result.get_sampler();
+  const unsigned int& p = info[0];
+  const unsigned int& stored_iterG = info[3];
+  if(!(sampler == "FGMsampler" || sampler == "GGMsampler"))
+    throw std::runtime_error("Sampler type was not recognized as a graphical sampler. Only possibilities are FGMsampler or GGMsampler");
+
+  std::shared_ptr<const Groups> ptr_gruppi = nullptr;
+  if (groups.isNotNull()){ //Assume it is a BlockGraph
+    Rcpp::List gr(groups);
+    ptr_gruppi = std::make_shared<const Groups>(gr); 
+  }
+  if(top_k < 0)
+    throw std::runtime_error("top_k parameter can not be negative");
+  auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(result.get_file(), stored_iterG, p, ptr_gruppi, result.chain_groups(chain), top_k);
+  //Create Rcpp::List of sampled Graphs
+  std::vector< Rcpp::List > L(SampledG.size());
+  int counter = 0;
+  for(auto it = SampledG.cbegin(); it != SampledG.cend(); ++it){
+    L[counter++] = Rcpp::List::create(Rcpp::Named("Graph")=it->first, Rcpp::Named("Frequency")=it->second);
+  }
+  return Rcpp::List::create ( Rcpp::Named("plinks")= plinks,  
+                              Rcpp::Named("VisitedGraphs")= visited, 
+                              Rcpp::Named("TracePlot_Gsize")= TracePlot, 
+                              Rcpp::Named("SampledGraphs")= L   );
 }
 
 //' Read the sampled Graph saved on file
@@ -670,6 +786,8 @@ Eigen::VectorXd Extract_Chain( Rcpp::String const & file_name, Rcpp::String cons
 //' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
 //' @param groups List representing the groups of the block form. Numerations starts from 0 and vertrices has to be contiguous from group to group, 
 //' i.e ((0,1,2),(3,4)) is fine but ((1,2,3), (4,5)) and ((1,3,5), (2,4)) are not. Leave \code{NULL} if the graph is not in block form.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//' @param top_k integer, if positive only the \code{top_k} most visited graphs are returned in \code{SampledGraphs}. \code{VisitedGraphs} and \code{plinks} still account for all the graphs.
 //'
 //' @return It returns a list composed of: \code{plinks} that contains the posterior probability of inclusion of each possible link. \code{AcceptedMoves} contains the number of
 //' Metropolis-Hastings moves that were accepted in the sampling, \code{VisitedGraphs} the number of graph that were visited at least once, \code{TracePlot_Gsize} is a vector 
@@ -677,36 +795,222 @@ Eigen::VectorXd Extract_Chain( Rcpp::String const & file_name, Rcpp::String cons
 //' To save memory, the graphs are represented only by the upper triangular part, stored row-wise. 
 //' @export
 // [[Rcpp::export]]
-Rcpp::List Summary_Graph(Rcpp::String const & file_name, Rcpp::Nullable<Rcpp::List> groups = R_NilValue)
+Rcpp::List Summary_Graph(Rcpp::String const & file_name, Rcpp::Nullable<Rcpp::List> groups = R_NilValue, int chain = 0, int top_k = 0)
+{
+  analysis::ResultFile result(file_name);
+  return SummaryGraph_ResultFile(result, groups, chain, top_k);
+}
+
+//' Read the most visited graphs with bounded memory
+//'
+//' \loadmathjax This function summarizes the visited graphs keeping only a bounded number of them, by means of the Space-Saving algorithm. Use it instead of \code{\link{Summary_Graph}} 
+//' when the visited graphs are too many to be stored. Each reported frequency overestimates the true one by at most its \code{Error}, that is at most \code{TotalVisits/Capacity}, 
+//' and every graph visited more often than that is reported.
+//' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
+//' @param capacity integer, the maximum number of graphs that are kept while the saved graphs are read. Set 0 to read the summary computed during the sampling, 
+//' see \code{sketch_capacity} in \code{\link{sampler_parameters}}, without reading the saved graphs.
+//' @param top_k integer, if positive only the \code{top_k} most visited graphs are returned in \code{SampledGraphs}.
+//' @param groups List representing the groups of the block form. Numerations starts from 0 and vertrices has to be contiguous from group to group, 
+//' i.e ((0,1,2),(3,4)) is fine but ((1,2,3), (4,5)) and ((1,3,5), (2,4)) are not. Leave \code{NULL} if the graph is not in block form.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//'
+//' @return It returns a list composed of: \code{plinks} that contains the posterior probability of inclusion of each possible link, computed exactly. \code{TotalVisits} is the 
+//' number of summarized graphs, \code{Capacity} the maximum number of kept graphs and \code{SampledGraphs} is a list containing the kept graphs, from the most visited one, 
+//' with their estimated absolute frequence of visit and its maximum overestimation \code{Error}. The graphs are represented only by the upper triangular part, stored row-wise. 
+//' @export
+// [[Rcpp::export]]
+Rcpp::List Summary_GraphSketch(Rcpp::String const & file_name, int capacity = 0, int top_k = 0, Rcpp::Nullable<Rcpp::List> groups = R_NilValue, int chain = 0)
 {
   //Read file info
   auto [info, sampler] = HDF5conversion::GetInfo(file_name);
   const unsigned int& p = info[0];
-  const unsigned int& n = info[1];
-  const unsigned int& stored_iter = info[2];
   const unsigned int& stored_iterG = info[3];
   if(!(sampler == "FGMsampler" || sampler == "GGMsampler"))
     throw std::runtime_error("Sampler type was not recognized as a graphical sampler. Only possibilities are FGMsampler or GGMsampler");
+  if(capacity < 0)
+    throw std::runtime_error("capacity parameter can not be negative");
+  if(top_k < 0)
+    throw std::runtime_error("top_k parameter can not be negative");
 
   std::shared_ptr<const Groups> ptr_gruppi = nullptr;
   if (groups.isNotNull()){ //Assume it is a BlockGraph
     Rcpp::List gr(groups);
     ptr_gruppi = std::make_shared<const Groups>(gr); 
-    const Groups& gruppi_test = *ptr_gruppi;
   }
-  auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name, stored_iterG, p, ptr_gruppi);
+  auto [plinks, SketchedG, total, kept] = analysis::Summary_GraphSketch(file_name, stored_iterG, p, capacity, ptr_gruppi, HDF5conversion::GetChainGroups(file_name, chain), top_k);
   //Create Rcpp::List of sampled Graphs
-  std::vector< Rcpp::List > L(SampledG.size());
+  std::vector< Rcpp::List > L(SketchedG.size());
   int counter = 0;
-  for(auto it = SampledG.cbegin(); it != SampledG.cend(); ++it){
-    L[counter++] = Rcpp::List::create(Rcpp::Named("Graph")=it->first, Rcpp::Named("Frequency")=it->second);
+  for(auto it = SketchedG.cbegin(); it != SketchedG.cend(); ++it){
+    L[counter++] = Rcpp::List::create(Rcpp::Named("Graph")=std::get<0>(*it), Rcpp::Named("Frequency")=std::get<1>(*it), Rcpp::Named("Error")=std::get<2>(*it));
   }
   return Rcpp::List::create ( Rcpp::Named("plinks")= plinks,  
-                              Rcpp::Named("VisitedGraphs")= visited, 
-                              Rcpp::Named("TracePlot_Gsize")= TracePlot, 
+                              Rcpp::Named("TotalVisits")= static_cast<double>(total), 
+                              Rcpp::Named("Capacity")= static_cast<double>(kept), 
                               Rcpp::Named("SampledGraphs")= L   );
 }
 
+//' Read Rao-Blackwellized probabilities of inclusion
+//'
+//' \loadmathjax This function reads the posterior probabilities of inclusion of each possible link that are computed by \code{\link{GGM_sampling}} and \code{\link{FGM_sampling}} 
+//' during the sampling. At each iteration after burn-in, the changed link contributes with its probability of being in the next graph, i.e the acceptance probability of the move, 
+//' instead of its indicator. They have lower Monte Carlo variance than the ones returned by \code{\link{Summary_Graph}} and do not require to read the sampled graphs.
+//' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to average all the chains, \code{k} to read only the \code{k}-th one.
+//'
+//' @return It returns the \mjseqn{p \times p} matrix of posterior probabilities of inclusion.
+//' @export
+// [[Rcpp::export]]
+Eigen::MatrixXd Read_plinksRB(Rcpp::String const & file_name, int chain = 0)
+{
+  auto [info, sampler] = HDF5conversion::GetInfo(file_name);
+  if(!(sampler == "FGMsampler" || sampler == "GGMsampler"))
+    throw std::runtime_error("Sampler type was not recognized as a graphical sampler. Only possibilities are FGMsampler or GGMsampler");
+  const unsigned int& p = info[0];
+  return analysis::Read_plinksRB(file_name, p, HDF5conversion::GetChainGroups(file_name, chain));
+}
+
+//Result file held by a handle returned by Open_ResultFile()
+static analysis::ResultFile & Get_ResultFile(SEXP handle)
+{
+  if(TYPEOF(handle) != EXTPTRSXP || !Rf_inherits(handle, "BGSL_ResultFile"))
+    throw std::runtime_error("Error, handle has to be the value returned by Open_ResultFile()");
+  Rcpp::XPtr<analysis::ResultFile> ptr(handle);
+  if(ptr.get() == nullptr)
+    throw std::runtime_error("Error, the handle is no longer valid. Open the file again by Open_ResultFile()");
+  return *ptr;
+}
+
+//' Open a file of sampled values and keep it open
+//'
+//' \loadmathjax Each call of \code{\link{Read_InfoFile}}, \code{\link{Compute_PosteriorMeans}}, \code{\link{Compute_Quantiles}}, \code{\link{Extract_Chain}} and \code{\link{Summary_Graph}} 
+//' opens the file, reads its information and closes it. This function opens the file once and returns a handle to be passed to \code{\link{ResultFile_Info}}, 
+//' \code{\link{ResultFile_PosteriorMeans}}, \code{\link{ResultFile_Quantiles}}, \code{\link{ResultFile_Extract_Chains}} and \code{\link{ResultFile_Summary_Graph}}, 
+//' that perform the same queries. The information of the file is read once and the datasets of the extracted chains are kept open, hence it is convenient when many chains are extracted.
+//' The file is opened in read only mode, close it by \code{\link{Close_ResultFile}} before modifying it, e.g by \code{\link{Transpose_Chains}}. It is closed anyway when the handle is garbage collected.
+//' @param file_name, string with the name of the file to be open. It has to include the extension, usually \code{.h5}.
+//'
+//' @return It returns a handle to the open file, of class \code{"BGSL_ResultFile"}.
+//' @export
+// [[Rcpp::export]]
+SEXP Open_ResultFile(Rcpp::String const & file_name)
+{
+  Rcpp::XPtr<analysis::ResultFile> ptr(new analysis::ResultFile(file_name), true);
+  ptr.attr("class") = "BGSL_ResultFile";
+  return ptr;
+}
+
+//' Close a file opened by Open_ResultFile
+//'
+//' \loadmathjax Closes the file and the datasets held by a handle returned by \code{\link{Open_ResultFile}}. The handle can not be used anymore.
+//' @param handle the value returned by \code{\link{Open_ResultFile}}.
+//'
+//' @return It returns nothing.
+//' @export
+// [[Rcpp::export]]
+void Close_ResultFile(SEXP handle)
+{
+  Get_ResultFile(handle).close();
+}
+
+//' Read information from an open file
+//'
+//' \loadmathjax As \code{\link{Read_InfoFile}}, for a file opened by \code{\link{Open_ResultFile}}.
+//' @param handle the value returned by \code{\link{Open_ResultFile}}.
+//'
+//' @return The same list returned by \code{\link{Read_InfoFile}}.
+//' @export
+// [[Rcpp::export]]
+Rcpp::List ResultFile_Info(SEXP handle)
+{
+  return InfoFile_ResultFile(Get_ResultFile(handle));
+}
+
+//' Compute Posterior means from an open file
+//'
+//' \loadmathjax As \code{\link{Compute_PosteriorMeans}}, for a file opened by \code{\link{Open_ResultFile}}.
+//' @param handle the value returned by \code{\link{Open_ResultFile}}.
+//' @param Beta boolean, set \code{TRUE} to compute the mean for all \code{p*n} \mjseqn{\beta} coefficients.
+//' @param Mu boolean, set \code{TRUE} to compute the mean for all \mjseqn{p} parameters. 
+//' @param TauEps boolean, set \code{TRUE} to compute the mean of \mjseqn{\tau_{\epsilon}} parameter.
+//' @param Precision boolean, set \code{TRUE} to compute the mean for all the elements of the precision matrix.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//'
+//' @return The same list returned by \code{\link{Compute_PosteriorMeans}}.
+//' @export
+// [[Rcpp::export]]
+Rcpp::List ResultFile_PosteriorMeans(SEXP handle, bool Beta = false, bool Mu = false, bool TauEps = false, bool Precision = false, int chain = 0)
+{
+  return PosteriorMeans_ResultFile(Get_ResultFile(handle), Beta, Mu, TauEps, Precision, chain);
+}
+
+//' Compute quantiles from an open file
+//'
+//' \loadmathjax As \code{\link{Compute_Quantiles}}, for a file opened by \code{\link{Open_ResultFile}}.
+//' @param handle the value returned by \code{\link{Open_ResultFile}}.
+//' @param Beta boolean, set \code{TRUE} to compute the quantiles for all \code{p*n} \mjseqn{\beta} coefficients.
+//' @param Mu boolean, set \code{TRUE} to compute the quantiles for all \mjseqn{p} parameters. 
+//' @param TauEps boolean, set \code{TRUE} to compute the quantiles of \mjseqn{\tau_{\epsilon}} parameter.
+//' @param Precision boolean, set \code{TRUE} to compute the quantiles for all the elements of the precision matrix.
+//' @param lower_qtl the level of the first desired quantile.
+//' @param upper_qtl the level of the second desired quantile.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//'
+//' @return The same list returned by \code{\link{Compute_Quantiles}}.
+//' @export
+// [[Rcpp::export]]
+Rcpp::List ResultFile_Quantiles(SEXP handle, bool Beta = false, bool Mu = false, bool TauEps = false, bool Precision = false,
+                                double const & lower_qtl = 0.05, double const & upper_qtl = 0.95, int chain = 0)
+{
+  return Quantiles_ResultFile(Get_ResultFile(handle), Beta, Mu, TauEps, Precision, lower_qtl, upper_qtl, chain);
+}
+
+//' Read many chains from an open file
+//'
+//' \loadmathjax As \code{\link{Extract_Chain}}, for a file opened by \code{\link{Open_ResultFile}}, but the chains of many elements are read by a single call. 
+//' The datasets stay open after the first request and close elements are read together. Indices start counting from 1.
+//' @param handle the value returned by \code{\link{Open_ResultFile}}.
+//' @param variable string, the name of the dataset to be read from the file. Only possibilities are \code{"Beta"}, \code{"Mu"}, \code{"Precision"} and \code{"TauEps"}.
+//' @param index1 integer vector, the indices of the elements whose chains have to be read, as \code{index1} in \code{\link{Extract_Chain}}.
+//' @param index2 integer vector, used only if \code{variable} is equal to \code{"Beta"}. It has the same length of \code{index1}, or length one if all the elements refer to the same curve.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to get all the chains one after the other, \code{k} to read only the \code{k}-th one.
+//'
+//' @return It returns a matrix whose \code{k}-th column contains all the sampled values of the \code{k}-th requested element.
+//' @export
+// [[Rcpp::export]]
+Eigen::MatrixXd ResultFile_Extract_Chains(SEXP handle, Rcpp::String const & variable, Rcpp::IntegerVector const & index1, 
+                                          Rcpp::IntegerVector const & index2 = Rcpp::IntegerVector::create(1), int chain = 0)
+{
+  if(index2.size() != index1.size() && index2.size() != 1)
+    throw std::runtime_error("Error, index2 has to have the same length of index1 or length one");
+  std::vector<unsigned int> idx1(index1.size());
+  std::vector<unsigned int> idx2(index1.size());
+  for(R_xlen_t k = 0; k < index1.size(); ++k){
+    const int i2 = (index2.size() == 1) ? index2[0] : index2[k];
+    if(index1[k] == NA_INTEGER || i2 == NA_INTEGER || index1[k] <= 0 || i2 <= 0)
+      throw std::runtime_error("index1 and index2 parameters start counting from 1, not from 0. The first element corresponds to index 1, not 0. The inserted values has to be strictly positive");
+    idx1[k] = index1[k] - 1;
+    idx2[k] = i2 - 1;
+  }
+  return Chains_ResultFile(Get_ResultFile(handle), variable, idx1, idx2, chain);
+}
+
+//' Read the sampled Graph from an open file
+//'
+//' \loadmathjax As \code{\link{Summary_Graph}}, for a file opened by \code{\link{Open_ResultFile}}.
+//' @param handle the value returned by \code{\link{Open_ResultFile}}.
+//' @param groups List representing the groups of the block form, see \code{\link{Summary_Graph}}. Leave \code{NULL} if the graph is not in block form.
+//' @param chain integer, used only if the file contains more than one chain. Set 0 to pool all the chains, \code{k} to read only the \code{k}-th one.
+//' @param top_k integer, if positive only the \code{top_k} most visited graphs are returned in \code{SampledGraphs}.
+//'
+//' @return The same list returned by \code{\link{Summary_Graph}}.
+//' @export
+// [[Rcpp::export]]
+Rcpp::List ResultFile_Summary_Graph(SEXP handle, Rcpp::Nullable<Rcpp::List> groups = R_NilValue, int chain = 0, int top_k = 0)
+{
+  return SummaryGraph_ResultFile(Get_ResultFile(handle), groups, chain, top_k);
+}
+
 // [[Rcpp::export]]
 Rcpp::List SimulateData_GGM_c(unsigned int const & p, unsigned int const & n, unsigned int const & n_groups, Rcpp::String const & form, 
                             Rcpp::String const & graph, 
@@ -788,19 +1092,54 @@ Rcpp::List CreateGroups(unsigned int const & p, unsigned int const & n_groups)
 
 
 
+//Options shared by all samplers, read by name from the list created by sampler_parameters(). Missing fields are completed with defaults on the R side
+template<typename ParamType>
+static void ReadStorageOptions(ParamType & param, Rcpp::List const & Param)
+{
+  param.checkpoint_every = std::max(Rcpp::as<int>(Param["checkpoint_every"]), 0);
+  param.resume = Rcpp::as<bool>(Param["resume"]);
+  param.chain_format = HDF5conversion::ChainFormatFromName(Rcpp::as<std::string>(Param["chain_format"]));
+  param.flush_every = std::max(Rcpp::as<int>(Param["flush_every"]), 0);
+}
+
+//Options of the graphical samplers, read by name as in ReadStorageOptions()
+static void ReadGraphOptions(Parameters & param, Rcpp::List const & Param)
+{
+  param.n_speculative = std::max(Rcpp::as<int>(Param["n_speculative"]), 1);
+  param.n_replicas = std::max(Rcpp::as<int>(Param["n_replicas"]), 1);
+  param.max_temperature = Rcpp::as<double>(Param["max_temperature"]);
+  param.swap_every = std::max(Rcpp::as<int>(Param["swap_every"]), 1);
+  param.adapt_sigma = Rcpp::as<bool>(Param["adapt_sigma"]);
+  param.target_acceptance = Rcpp::as<double>(Param["target_acceptance"]);
+  param.store_chain = Rcpp::as<bool>(Param["store_chain"]);
+  param.lower_qtl = Rcpp::as<double>(Param["lower_qtl"]);
+  param.upper_qtl = Rcpp::as<double>(Param["upper_qtl"]);
+  param.target_ess = Rcpp::as<double>(Param["target_ess"]);
+  param.target_rhat = Rcpp::as<double>(Param["target_rhat"]);
+  param.check_every = std::max(Rcpp::as<int>(Param["check_every"]), 1);
+  param.report_diagnostics = Rcpp::as<bool>(Param["report_diagnostics"]);
+  param.keyframe_every = std::max(Rcpp::as<int>(Param["keyframe_every"]), 0);
+  param.sketch_capacity = std::max(Rcpp::as<int>(Param["sketch_capacity"]), 0);
+  ReadStorageOptions(param, Param);
+}
+
 // [[Rcpp::export]]
 Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data, 
                             int const & p, int const & n, int const & niter, int const & burnin, double const & thin, Rcpp::String file_name,
                             Eigen::MatrixXd D, double const & b, 
                             Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const & G0, Eigen::MatrixXd const & K0,
-                            int const & MCprior = 100, int const & MCpost = 100, double const & threshold = 0.00000001,
+                            Rcpp::List const & Param,
                             Rcpp::String form = "Complete", Rcpp::String prior = "Uniform", Rcpp::String algo = "MH",  
                             Rcpp::Nullable<Rcpp::List> groups = R_NilValue, int seed = 0, double const & Gprior = 0.5, 
                             double const & sigmaG = 0.1, double const & paddrm = 0.5, bool print_info = true  )
 { 
   using MatRow = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;  
   Hyperparameters hy(b, D, paddrm, sigmaG, Gprior);
-  Parameters param(niter, burnin, thin, MCprior, MCpost, threshold);
+  Parameters param(niter, burnin, thin, Rcpp::as<int>(Param["MCprior"]), Rcpp::as<int>(Param["MCpost"]), Rcpp::as<double>(Param["threshold"]));
+  ReadGraphOptions(param, Param);
+  const std::string ratio_mode = Rcpp::as<std::string>(Param["ratio_mode"]);
+  const int n_tries = Rcpp::as<int>(Param["n_tries"]);
+  const int nchains = Rcpp::as<int>(Param["nchains"]);
   Rcpp::String file_name_extension(file_name);
   file_name_extension += ".h5";
 
@@ -808,34 +1147,36 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
   {
     Init<GraphType, unsigned int> init(n,p);
     init.set_init(MatRow (K0), GraphType<unsigned int> (G0)  );
-    //Select the method to be used
-    auto method = SelectMethod_Generic<GraphType, unsigned>(prior, algo, hy, param);
-    //Crete sampler obj
-    GGMsampler  Sampler(data, n, param, hy, init, method, file_name, seed, print_info);
+    //Crete sampler obj. Each chain has its own GGM method and sampler
+    const std::string prior_name(prior), algo_name(algo), ratio_name(ratio_mode);
+    auto build = [&](std::string const & chain_file, unsigned int const & chain_seed, bool const & print_bar){
+      auto method = SelectMethod_Generic<GraphType, unsigned>(prior_name, algo_name, hy, param, ratio_name, n_tries);
+      return GGMsampler(data, n, param, hy, init, method, chain_file, chain_seed, print_bar);
+    };
     //Run
     if(print_info){
       Rcpp::Rcout<<"GGM Sampler starts:"<<std::endl; 
     }
     auto start = std::chrono::high_resolution_clock::now();
-    int accepted = Sampler.run();
+    std::vector<int> accepted = chains::run_chains(std::string(file_name), std::max(nchains, 1), seed, print_info, build, param.checkpoint_every > 0);
     auto stop = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> timer = stop - start;
     if(print_info){
       Rcpp::Rcout<<std::endl<<"Time: "<<timer.count()<<" s "<<std::endl; 
     }
-    if(accepted < 0){
-      std::string name(file_name);
-      name += ".h5";
-      Rcpp::Rcout<<"Removing file "<<name<<std::endl;
-      Rcpp::Function R_file_remove("file.remove");
-      R_file_remove(name);
+    if(*std::min_element(accepted.cbegin(), accepted.cend()) < 0){
+      chains::discard_interrupted(std::string(file_name), std::max(nchains, 1), param.checkpoint_every > 0);
       return Rcpp::List::create();
     }
     else{
       //Posterior Analysis
       Rcpp::Rcout<<"Created file: "<<std::string (file_name)<<".h5"<<std::endl;
+      const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(std::string(file_name_extension)); //all chains are pooled
+      auto [info_file, sampler_type] = HDF5conversion::GetInfo(std::string(file_name_extension)); //fewer iterations are saved if the sampling stopped early
+      param.iter_to_store  = info_file[2];
+      param.iter_to_storeG = info_file[3];
       Rcpp::Rcout<<"Computing PosterionMeans ... "<<std::endl;
-      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision" );
+      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision", chain_groups );
       MatRow MeanK(MatRow::Zero(p,p));
       unsigned int pos{0};
       for(unsigned int i = 0; i < p; ++i){
@@ -843,7 +1184,7 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
           MeanK(i,j) = MeanK_vett(pos++);
         }
       }
-      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p);
+      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p, nullptr, chain_groups);
       //Create Rcpp::List of sampled Graphs
       std::vector< Rcpp::List > L(SampledG.size());
       int counter = 0;
@@ -852,6 +1193,7 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
       }
       return Rcpp::List::create ( Rcpp::Named("MeanK")= MeanK, 
                                   Rcpp::Named("plinks")= plinks,  
+                                  Rcpp::Named("plinks_RB")= analysis::Read_plinksRB(file_name_extension, p, chain_groups),
                                   Rcpp::Named("AcceptedMoves")= accepted, 
                                   Rcpp::Named("VisitedGraphs")= visited, 
                                   Rcpp::Named("TracePlot_Gsize")= TracePlot, 
@@ -869,34 +1211,36 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
     param.ptr_groups = ptr_gruppi;
     Init<BlockGraph,  unsigned int> init(n,p, ptr_gruppi);
     init.set_init(MatRow (K0),BlockGraph<unsigned int>(G0,ptr_gruppi));
-    //Select the method to be used
-    auto method = SelectMethod_Generic<BlockGraph, unsigned int>(prior, algo, hy, param);
-    //Crete sampler obj
-    GGMsampler<BlockGraph> Sampler(data, n, param, hy, init, method, file_name, seed, print_info);
+    //Crete sampler obj. Each chain has its own GGM method and sampler
+    const std::string prior_name(prior), algo_name(algo), ratio_name(ratio_mode);
+    auto build = [&](std::string const & chain_file, unsigned int const & chain_seed, bool const & print_bar){
+      auto method = SelectMethod_Generic<BlockGraph, unsigned int>(prior_name, algo_name, hy, param, ratio_name, n_tries);
+      return GGMsampler<BlockGraph>(data, n, param, hy, init, method, chain_file, chain_seed, print_bar);
+    };
     //Run
     if(print_info){
       Rcpp::Rcout<<"Block GGM Sampler starts:"<<std::endl; 
     }
     auto start = std::chrono::high_resolution_clock::now();
-    int accepted = Sampler.run();
+    std::vector<int> accepted = chains::run_chains(std::string(file_name), std::max(nchains, 1), seed, print_info, build, param.checkpoint_every > 0);
     auto stop = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> timer = stop - start;
     if(print_info){
       Rcpp::Rcout<<std::endl<<"Time: "<<timer.count()<<" s "<<std::endl; 
     }
-    if(accepted < 0){
-      std::string name(file_name);
-      name += ".h5";
-      Rcpp::Rcout<<"Removing file "<<name<<std::endl;
-      Rcpp::Function R_file_remove("file.remove");
-      R_file_remove(name);
+    if(*std::min_element(accepted.cbegin(), accepted.cend()) < 0){
+      chains::discard_interrupted(std::string(file_name), std::max(nchains, 1), param.checkpoint_every > 0);
       return Rcpp::List::create();
     }
     else{
       //Posterior Analysis
       Rcpp::Rcout<<"Created file: "<<std::string (file_name)<<".h5"<<std::endl;
+      const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(std::string(file_name_extension)); //all chains are pooled
+      auto [info_file, sampler_type] = HDF5conversion::GetInfo(std::string(file_name_extension)); //fewer iterations are saved if the sampling stopped early
+      param.iter_to_store  = info_file[2];
+      param.iter_to_storeG = info_file[3];
       Rcpp::Rcout<<"Computing PosterionMeans ... "<<std::endl;
-      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision" );
+      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision", chain_groups );
       MatRow MeanK(MatRow::Zero(p,p));
       unsigned int pos{0};
       for(unsigned int i = 0; i < p; ++i){
@@ -904,7 +1248,7 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
           MeanK(i,j) = MeanK_vett(pos++);
         }
       }
-      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p, ptr_gruppi);
+      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p, ptr_gruppi, chain_groups);
       //Create Rcpp::List of sampled Graphs
       std::vector< Rcpp::List > L(SampledG.size());
       int counter = 0;
@@ -913,6 +1257,7 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
       }
       return Rcpp::List::create ( Rcpp::Named("MeanK")= MeanK, 
                                   Rcpp::Named("plinks")= plinks,  
+                                  Rcpp::Named("plinks_RB")= analysis::Read_plinksRB(file_name_extension, p, chain_groups),
                                   Rcpp::Named("AcceptedMoves")= accepted, 
                                   Rcpp::Named("VisitedGraphs")= visited, 
                                   Rcpp::Named("TracePlot_Gsize")= TracePlot, 
@@ -928,14 +1273,15 @@ Rcpp::List GGM_sampling_c(  Eigen::MatrixXd const & data,
 
 
 // [[Rcpp::export]]
-Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int const & burnin, double const & thin, Eigen::MatrixXd const & BaseMat,
+Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int const & burnin, double const & thin,
                           Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> G,
                           Eigen::MatrixXd const & Beta0, Eigen::VectorXd const & mu0, double const & tau_eps0, Eigen::VectorXd const & tauK0, Eigen::MatrixXd const & K0,
                           double const & a_tau_eps, double const & b_tau_eps, double const & sigmamu, double const & aTauK, double const & bTauK, double const & bK, Eigen::MatrixXd const & DK,
-                          Rcpp::String file_name, bool diagonal_graph = true, 
-                          double const & threshold_GWish = 0.00000001, int seed = 0, bool print_info = true)
+                          Rcpp::String file_name, bool diagonal_graph,
+                          Rcpp::List const & Param, int seed = 0, bool print_info = true)
 {
-
+  const Eigen::MatrixXd BaseMat = Rcpp::as<Eigen::MatrixXd>(Param["BaseMat"]);
+  const int nchains = Rcpp::as<int>(Param["nchains"]);
   const unsigned int p = BaseMat.cols();
   const unsigned int n = data.cols();
   const unsigned int r = BaseMat.rows();
@@ -943,31 +1289,33 @@ Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
   file_name_extension += ".h5";
   if(data.rows() != r)
     throw std::runtime_error("Dimension of data and BaseMat are incoherent. data has to be (n_grid_points x n), BaseMat is (n_grid_points x p)");
+  //Quantities depending only on the data are computed once, all chains share them
+  const FunctionalDataPtr shared_data = std::make_shared<const FunctionalData>(data, BaseMat);
   
   if(diagonal_graph){
     //FLMHyperparameters hy(p);
     FLMHyperparameters hy(a_tau_eps, b_tau_eps, sigmamu, aTauK, bTauK );
     FLMParameters param(niter, burnin, thin, BaseMat);
+    ReadStorageOptions(param, Param);
     InitFLM init(n,p);
     init.set_init(Beta0, mu0, tau_eps0, tauK0);
-    FLMsampler<GraphForm::Diagonal> Sampler(data, param, hy, init, file_name, seed, print_info);
+    //Crete sampler obj, one for each chain
+    auto build = [&](std::string const & chain_file, unsigned int const & chain_seed, bool const & print_bar){
+      return FLMsampler<GraphForm::Diagonal>(shared_data, param, hy, init, chain_file, chain_seed, print_bar);
+    };
     //Run
     if(print_info){
       Rcpp::Rcout<<"FLM Sampler diagonal starts:"<<std::endl; 
     }
     auto start = std::chrono::high_resolution_clock::now();
-    int status = Sampler.run();
+    std::vector<int> status = chains::run_chains(std::string(file_name), std::max(nchains, 1), seed, print_info, build, param.checkpoint_every > 0);
     auto stop = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> timer = stop - start;
     if(print_info){
       Rcpp::Rcout<<std::endl<<"Time: "<<timer.count()<<" s "<<std::endl; 
     }
-    if(status < 0 ){
-      std::string name(file_name);
-      name += ".h5";
-      Rcpp::Rcout<<"Removing file "<<name<<std::endl;
-      Rcpp::Function R_file_remove("file.remove");
-      R_file_remove(name);
+    if(*std::min_element(status.cbegin(), status.cend()) < 0){
+      chains::discard_interrupted(std::string(file_name), std::max(nchains, 1), param.checkpoint_every > 0);
       Rcpp::List PosteriorMeans = Rcpp::List::create ( Rcpp::Named("MeanBeta"), 
                                                        Rcpp::Named("MeanMu"), 
                                                        Rcpp::Named("MeanTauK"),   
@@ -977,11 +1325,12 @@ Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
     else{
       //Posterior analysis
       Rcpp::Rcout<<"Created file: "<<std::string (file_name)<<".h5"<<std::endl;
+      const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(std::string(file_name_extension)); //all chains are pooled
       Rcpp::Rcout<<"Computing PosterionMeans ... "<<std::endl;
-      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n );
-      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu" );
-      VecCol MeanTauK   =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Precision" );
-      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store );
+      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n, chain_groups );
+      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu", chain_groups );
+      VecCol MeanTauK   =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Precision", chain_groups );
+      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store, chain_groups );
       
       Rcpp::List PosteriorMeans = Rcpp::List::create ( Rcpp::Named("MeanBeta")=MeanBeta, 
                                                        Rcpp::Named("MeanMu")=MeanMu, 
@@ -996,7 +1345,8 @@ Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
     
     //FLMHyperparameters hy(p);
     FLMHyperparameters hy(a_tau_eps, b_tau_eps, sigmamu, bK, DK );
-    FLMParameters param(niter, burnin, thin, BaseMat, threshold_GWish);
+    FLMParameters param(niter, burnin, thin, BaseMat, Rcpp::as<double>(Param["threshold"]));
+    ReadStorageOptions(param, Param);
     if(G.rows() != G.cols())
       throw std::runtime_error("Inserted graph is not squared");
     if(G.rows() != p)
@@ -1005,25 +1355,24 @@ Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
     GraphType<unsigned int> Graph(G);
     InitFLM init(n,p, Graph);
     init.set_init(Beta0, mu0, tau_eps0, K0 );
-    FLMsampler<GraphForm::Fix> Sampler(data, param, hy, init, file_name, seed, print_info);
+    //Crete sampler obj, one for each chain
+    auto build = [&](std::string const & chain_file, unsigned int const & chain_seed, bool const & print_bar){
+      return FLMsampler<GraphForm::Fix>(shared_data, param, hy, init, chain_file, chain_seed, print_bar);
+    };
     //Run
     if(print_info){
       Rcpp::Rcout<<"FLM Sampler fixed starts:"<<std::endl; 
     }
     auto start = std::chrono::high_resolution_clock::now();
-    int  status = Sampler.run();
+    std::vector<int> status = chains::run_chains(std::string(file_name), std::max(nchains, 1), seed, print_info, build, param.checkpoint_every > 0);
     auto stop = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> timer = stop - start;
     if(print_info){
       Rcpp::Rcout<<std::endl<<"Time: "<<timer.count()<<" s "<<std::endl; 
     }
 
-    if(status < 0){
-      std::string name(file_name);
-      name += ".h5";
-      Rcpp::Rcout<<"Removing file "<<name<<std::endl;
-      Rcpp::Function R_file_remove("file.remove");
-      R_file_remove(name);
+    if(*std::min_element(status.cbegin(), status.cend()) < 0){
+      chains::discard_interrupted(std::string(file_name), std::max(nchains, 1), param.checkpoint_every > 0);
       Rcpp::List PosteriorMeans = Rcpp::List::create ( Rcpp::Named("MeanBeta"), 
                                                        Rcpp::Named("MeanMu"), 
                                                        Rcpp::Named("MeanTauK"),   
@@ -1033,11 +1382,12 @@ Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
     else{
       //Posterior analysis
       Rcpp::Rcout<<"Created file: "<<std::string (file_name)<<".h5"<<std::endl;
+      const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(std::string(file_name_extension)); //all chains are pooled
       Rcpp::Rcout<<"Computing PosterionMeans ... "<<std::endl;
-      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n );
-      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu" );
-      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, 0.5*p*(p+1), "Precision" );
-      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store );
+      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n, chain_groups );
+      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu", chain_groups );
+      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, 0.5*p*(p+1), "Precision", chain_groups );
+      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store, chain_groups );
       
       MatRow MeanK(MatRow::Zero(p,p));
       unsigned int pos{0};
@@ -1061,7 +1411,7 @@ Rcpp::List FLM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
 
 // [[Rcpp::export]]
 Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int const & burnin, double const & thin, double const & thinG,  //data and iterations
-                          Eigen::MatrixXd const & BaseMat, Rcpp::String const & file_name,  //Basemat and name of file 
+                          Rcpp::String const & file_name,  //name of file 
 
                           Eigen::MatrixXd const & Beta0, Eigen::VectorXd const & mu0, double const & tau_eps0,  //initial values
                           Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const & G0, Eigen::MatrixXd const & K0, 
@@ -1069,7 +1419,7 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
                           double const & a_tau_eps, double const & b_tau_eps, double const & sigmamu,  double const & bK, //hyperparam
                           Eigen::MatrixXd const & DK, double const & sigmaG, double const & paddrm , double const & Gprior,
                           
-                          int const & MCprior, int const & MCpost, double const & threshold,  //GGM_parameters
+                          Rcpp::List const & Param,  //sampler parameters, BaseMat included
                           Rcpp::String form = "Complete", Rcpp::String prior = "Uniform", Rcpp::String algo = "MH",  
                           Rcpp::Nullable<Rcpp::List> groups = R_NilValue, 
 
@@ -1077,6 +1427,7 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
 {
   using MatRow = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;  
 
+  const Eigen::MatrixXd BaseMat = Rcpp::as<Eigen::MatrixXd>(Param["BaseMat"]);
   const unsigned int p = BaseMat.cols();
   const unsigned int n = data.cols();
   const unsigned int r = BaseMat.rows();
@@ -1084,34 +1435,38 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
   file_name_extension += ".h5";
   if(data.rows() != r)
     throw std::runtime_error("Dimension of data and BaseMat are incoherent. data has to be (n_grid_points x n), BaseMat is (n_grid_points x p)");
+  //Quantities depending only on the data are computed once, all chains share them
+  const FunctionalDataPtr shared_data = std::make_shared<const FunctionalData>(data, BaseMat);
 
  Hyperparameters hy(a_tau_eps, b_tau_eps, sigmamu, bK, DK, paddrm, sigmaG, Gprior);
- Parameters param(niter, burnin, thin, thinG, MCprior, MCpost, BaseMat, threshold);
+ Parameters param(niter, burnin, thin, thinG, Rcpp::as<int>(Param["MCprior"]), Rcpp::as<int>(Param["MCpost"]), BaseMat, Rcpp::as<double>(Param["threshold"]));
+ ReadGraphOptions(param, Param);
+ const std::string ratio_mode = Rcpp::as<std::string>(Param["ratio_mode"]);
+ const int n_tries = Rcpp::as<int>(Param["n_tries"]);
+ const int nchains = Rcpp::as<int>(Param["nchains"]);
  if (form == "Complete")
  {
 
    Init<GraphType, unsigned int> init(Beta0, mu0, tau_eps0, MatRow (K0), GraphType<unsigned int> (G0) );
-   //Select the method to be used
-   auto method = SelectMethod_Generic<GraphType, unsigned>(prior, algo, hy, param);
-   //Crete sampler obj
-   FGMsampler  Sampler(data, param, hy, init, method, file_name, seed, print_info);
+   //Crete sampler obj. Each chain has its own GGM method and sampler
+   const std::string prior_name(prior), algo_name(algo), ratio_name(ratio_mode);
+   auto build = [&](std::string const & chain_file, unsigned int const & chain_seed, bool const & print_bar){
+     auto method = SelectMethod_Generic<GraphType, unsigned>(prior_name, algo_name, hy, param, ratio_name, n_tries);
+     return FGMsampler(shared_data, param, hy, init, method, chain_file, chain_seed, print_bar);
+   };
    //Run
    if(print_info){
      Rcpp::Rcout<<"FGM Sampler starts:"<<std::endl; 
    }
    auto start = std::chrono::high_resolution_clock::now();
-   int accepted = Sampler.run();
+   std::vector<int> accepted = chains::run_chains(std::string(file_name), std::max(nchains, 1), seed, print_info, build, param.checkpoint_every > 0);
    auto stop = std::chrono::high_resolution_clock::now();
    std::chrono::duration<double> timer = stop - start;
    if(print_info){
      Rcpp::Rcout<<std::endl<<"Time: "<<timer.count()<<" s "<<std::endl; 
    }
-   if(accepted < 0){
-      std::string name(file_name);
-      name += ".h5";
-      Rcpp::Rcout<<"Removing file "<<name<<std::endl;
-      Rcpp::Function R_file_remove("file.remove");
-      R_file_remove(name);
+   if(*std::min_element(accepted.cbegin(), accepted.cend()) < 0){
+      chains::discard_interrupted(std::string(file_name), std::max(nchains, 1), param.checkpoint_every > 0);
       Rcpp::List PosteriorMeans = Rcpp::List::create ( Rcpp::Named("MeanBeta"), 
                                                        Rcpp::Named("MeanMu"), 
                                                        Rcpp::Named("MeanK"),   
@@ -1127,11 +1482,15 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
    else{
       //Posterior Analysis
       Rcpp::Rcout<<"Created file: "<<std::string (file_name)<<".h5"<<std::endl;
+      const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(std::string(file_name_extension)); //all chains are pooled
+      auto [info_file, sampler_type] = HDF5conversion::GetInfo(std::string(file_name_extension)); //fewer iterations are saved if the sampling stopped early
+      param.iter_to_store  = info_file[2];
+      param.iter_to_storeG = info_file[3];
       Rcpp::Rcout<<"Computing PosterionMeans ... "<<std::endl;
-      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n );
-      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu" );
-      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision" );
-      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store );
+      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n, chain_groups );
+      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu", chain_groups );
+      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision", chain_groups );
+      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store, chain_groups );
       MatRow MeanK(MatRow::Zero(p,p));
       unsigned int pos{0};
           for(unsigned int i = 0; i < p; ++i){
@@ -1140,7 +1499,7 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
             }
           }
       //Graph analysis
-      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p);
+      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p, nullptr, chain_groups);
       //Create Rcpp::List of sampled Graphs
       std::vector< Rcpp::List > L(SampledG.size());
       int counter = 0;
@@ -1154,6 +1513,7 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
                                                        Rcpp::Named("MeanTaueps")=MeanTaueps );   
 
       Rcpp::List GraphAnalysis  = Rcpp::List::create ( Rcpp::Named("plinks")= plinks,  
+                                                       Rcpp::Named("plinks_RB")= analysis::Read_plinksRB(file_name_extension, p, chain_groups),
                                                        Rcpp::Named("AcceptedMoves")= accepted, 
                                                        Rcpp::Named("VisitedGraphs")= visited, 
                                                        Rcpp::Named("TracePlot_Gsize")= TracePlot, 
@@ -1172,27 +1532,25 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
    std::shared_ptr<const Groups> ptr_gruppi = std::make_shared<const Groups>(gr); 
    param.ptr_groups = ptr_gruppi;
    Init<BlockGraph, unsigned int> init(Beta0, mu0, tau_eps0, MatRow (K0), BlockGraph<unsigned int> (G0, ptr_gruppi) );
-   //Select the method to be used
-   auto method = SelectMethod_Generic<BlockGraph, unsigned int>(prior, algo, hy, param);
-   //Crete sampler obj
-   FGMsampler<BlockGraph, unsigned int> Sampler(data, param, hy, init, method, file_name, seed, print_info);
+   //Crete sampler obj. Each chain has its own GGM method and sampler
+   const std::string prior_name(prior), algo_name(algo), ratio_name(ratio_mode);
+   auto build = [&](std::string const & chain_file, unsigned int const & chain_seed, bool const & print_bar){
+     auto method = SelectMethod_Generic<BlockGraph, unsigned int>(prior_name, algo_name, hy, param, ratio_name, n_tries);
+     return FGMsampler<BlockGraph, unsigned int>(shared_data, param, hy, init, method, chain_file, chain_seed, print_bar);
+   };
    //Run
    if(print_info){
      Rcpp::Rcout<<"FGM Sampler starts:"<<std::endl; 
    }
    auto start = std::chrono::high_resolution_clock::now();
-   int accepted = Sampler.run();
+   std::vector<int> accepted = chains::run_chains(std::string(file_name), std::max(nchains, 1), seed, print_info, build, param.checkpoint_every > 0);
    auto stop = std::chrono::high_resolution_clock::now();
    std::chrono::duration<double> timer = stop - start;
    if(print_info){
      Rcpp::Rcout<<std::endl<<"Time: "<<timer.count()<<" s "<<std::endl; 
    }
-   if(accepted < 0){
-      std::string name(file_name);
-      name += ".h5";
-      Rcpp::Rcout<<"Removing file "<<name<<std::endl;
-      Rcpp::Function R_file_remove("file.remove");
-      R_file_remove(name);
+   if(*std::min_element(accepted.cbegin(), accepted.cend()) < 0){
+      chains::discard_interrupted(std::string(file_name), std::max(nchains, 1), param.checkpoint_every > 0);
       Rcpp::List PosteriorMeans = Rcpp::List::create ( Rcpp::Named("MeanBeta"), 
                                                        Rcpp::Named("MeanMu"), 
                                                        Rcpp::Named("MeanK"),   
@@ -1208,11 +1566,15 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
    else{
       //Posterior Analysis
       Rcpp::Rcout<<"Created file: "<<std::string (file_name)<<".h5"<<std::endl;
+      const std::vector<std::string> chain_groups = HDF5conversion::GetChainGroups(std::string(file_name_extension)); //all chains are pooled
+      auto [info_file, sampler_type] = HDF5conversion::GetInfo(std::string(file_name_extension)); //fewer iterations are saved if the sampling stopped early
+      param.iter_to_store  = info_file[2];
+      param.iter_to_storeG = info_file[3];
       Rcpp::Rcout<<"Computing PosterionMeans ... "<<std::endl;
-      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n );
-      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu" );
-      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision" );
-      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store );
+      MatCol MeanBeta   =  analysis::Matrix_PointwiseEstimate( file_name_extension, param.iter_to_store, p, n, chain_groups );
+      VecCol MeanMu     =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_store, p, "Mu", chain_groups );
+      VecCol MeanK_vett =  analysis::Vector_PointwiseEstimate( file_name_extension, param.iter_to_storeG, 0.5*p*(p+1), "Precision", chain_groups );
+      double MeanTaueps =  analysis::Scalar_PointwiseEstimate( file_name_extension, param.iter_to_store, chain_groups );
       MatRow MeanK(MatRow::Zero(p,p));
       unsigned int pos{0};
           for(unsigned int i = 0; i < p; ++i){
@@ -1221,7 +1583,7 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
             }
           }
       //Graph analysis
-      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p, ptr_gruppi);
+      auto [plinks, SampledG, TracePlot, visited] = analysis::Summary_Graph(file_name_extension, param.iter_to_storeG, p, ptr_gruppi, chain_groups);
       //Create Rcpp::List of sampled Graphs
       std::vector< Rcpp::List > L(SampledG.size());
       int counter = 0;
@@ -1235,6 +1597,7 @@ Rcpp::List FGM_sampling_c(Eigen::MatrixXd const & data, int const & niter, int c
                                                        Rcpp::Named("MeanTaueps")=MeanTaueps );   
 
       Rcpp::List GraphAnalysis  = Rcpp::List::create ( Rcpp::Named("plinks")= plinks,  
+                                                       Rcpp::Named("plinks_RB")= analysis::Read_plinksRB(file_name_extension, p, chain_groups),
                                                        Rcpp::Named("AcceptedMoves")= accepted, 
                                                        Rcpp::Named("VisitedGraphs")= visited, 
                                                        Rcpp::Named("TracePlot_Gsize")= TracePlot, 
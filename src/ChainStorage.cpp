@@ -0,0 +1,723 @@
+#include "ChainStorage.h"
+#include <cstdio>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace HDF5conversion{
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Format
+
+	ChainFormat GetChainFormat(FileType & file, std::string const & group)
+	{
+		const std::string name(group + "ChainFormat");
+		if(H5Lexists(file, name.data(), H5P_DEFAULT) <= 0)
+			return ChainFormat::HDF5;
+		DatasetType dataset = H5Dopen(file, name.data(), H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not open dataset " + name);
+		const std::string format(ReadString(dataset));
+		H5Dclose(dataset);
+		return ChainFormatFromName(format);
+	}
+
+	ChainFormat ChainFormatFromName(std::string const & name)
+	{
+		if(name == "raw")
+			return ChainFormat::Raw;
+		if(name != "hdf5")
+			throw std::runtime_error("Error, unknown format of the chains " + name + ". The only possible formats are hdf5 and raw");
+		return ChainFormat::HDF5;
+	}
+
+	void WriteChainFormat(FileType & file, ChainFormat const & format)
+	{
+		if(format == ChainFormat::HDF5) //files without /ChainFormat are in HDF5 format
+			return;
+		DataspaceType dataspace = H5Screate(H5S_NULL);
+		DatasetType dataset = H5Dcreate(file, "/ChainFormat", H5T_STD_I32LE, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		H5Sclose(dataspace);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset for ChainFormat");
+		WriteString(dataset, "raw");
+		H5Dclose(dataset);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------
+	//HDF5 format
+
+	unsigned int HDF5ChainWriter::add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+											unsigned int const & first_iter, ScalarType const & rows, bool const & resume)
+	{
+		DatasetType dataset;
+		if(resume){
+			dataset = OpenDataset(file, name);
+			DataType type_rd = H5Dget_type(dataset);
+			const bool same_size = (H5Tget_size(type_rd) == H5Tget_size(type));
+			H5Tclose(type_rd);
+			if(!same_size)
+				throw std::runtime_error("Error, the dataset " + name + " of the file to be resumed was written with a different type");
+		}
+		else
+			dataset = CreateChainDataset(file, name, type, block, iter_to_store, rows);
+		datasets.push_back(dataset);
+		blocks.push_back(block);
+		return writer.add_dataset(dataset, type, block, iter_to_store, first_iter, rows);
+	}
+
+	void HDF5ChainWriter::resize(unsigned int const & id, unsigned int const & n_iter)
+	{
+		ResizeChainDataset(datasets[id], blocks[id]*n_iter);
+	}
+
+	void HDF5ChainWriter::sync()
+	{
+		writer.send_all();
+		FileType f = file;
+		writer.push_task([f](){
+			if(H5Fflush(f, H5F_SCOPE_LOCAL) < 0)
+				throw std::runtime_error("Error, can not flush the file");
+		});
+	}
+
+	void HDF5ChainWriter::release()
+	{
+		for(auto & dataset : datasets)
+			H5Dclose(dataset);
+		datasets.clear();
+		blocks.clear();
+	}
+
+	HDF5ChainReader::HDF5ChainReader(FileType & file, std::string const & group, std::string const & name)
+	{
+		dataset = H5Dopen(file, (group + name).data(), H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not open dataset for " + name);
+		if(HasChainMajor(file, group, name)){
+			dataset_t = H5Dopen(file, (group + ChainMajorName(name)).data(), H5P_DEFAULT);
+			if(dataset_t < 0)
+				throw std::runtime_error("Error, can not open dataset for " + ChainMajorName(name));
+			mapped = MappedDataset(dataset_t);
+		}
+	}
+
+	HDF5ChainReader::~HDF5ChainReader()
+	{
+		mapped.release();
+		if(dataset_t >= 0)
+			H5Dclose(dataset_t);
+		if(dataset >= 0)
+			H5Dclose(dataset);
+	}
+
+	MatRow HDF5ChainReader::iterations(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter)
+	{
+		return GetIterations(dataset, first_iter, n_iter, stored_iter);
+	}
+
+	MatRow HDF5ChainReader::elements(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter)
+	{
+		if(double const * values = view(first, n_elem, stored_iter))
+			return Eigen::Map<const MatRow>(values, n_elem, stored_iter);
+		if(dataset_t >= 0)
+			return GetChains_from_ChainMajor(dataset_t, first, n_elem, stored_iter);
+		return GetChains_from_Block(dataset, first, n_elem, stored_iter);
+	}
+
+	std::vector<unsigned char> HDF5ChainReader::bytes(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter)
+	{
+		DataspaceType dataspace = H5Dget_space(dataset);
+		const ScalarType length = H5Sget_simple_extent_npoints(dataspace);
+		H5Sclose(dataspace);
+		if(stored_iter == 0 || length % stored_iter != 0 || first_iter + n_iter > stored_iter)
+			throw std::runtime_error("Error, the requested iterations exceed the dataset dimension");
+		return ReadPackedGraphs(dataset, length/stored_iter, first_iter, n_iter);
+	}
+
+	double const * HDF5ChainReader::view(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter) const
+	{
+		if(!mapped.is_mapped() || mapped.cols() != stored_iter || first + n_elem > mapped.rows())
+			return nullptr;
+		return mapped.middle_rows(first, n_elem).data();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Raw format
+
+	namespace{
+		constexpr char raw_magic[8] = {'B','G','S','L','R','A','W','1'};
+		constexpr std::uint32_t raw_version{1};
+		constexpr std::uint64_t raw_header_bytes{32};
+		constexpr std::uint64_t raw_record_bytes{24}; //kind, chain, first iteration, payload size
+		enum RecordKind : std::uint32_t {chain_record = 0, values_record = 1, index_record = 2};
+		enum TypeCode : std::uint32_t {type_double = 0, type_uchar = 1, type_uint = 2};
+
+		bool LittleEndian()
+		{
+			const std::uint32_t one{1};
+			unsigned char first;
+			std::memcpy(&first, &one, 1);
+			return first == 1;
+		}
+
+		//Offsets in the raw file are 64 bits, long is not large enough on every platform
+		int Seek(std::FILE * stream, std::uint64_t const & pos, int const & origin)
+		{
+			#ifdef _WIN32
+				return _fseeki64(stream, static_cast<__int64>(pos), origin);
+			#else
+				return fseeko(stream, static_cast<off_t>(pos), origin);
+			#endif
+		}
+
+		std::uint64_t Tell(std::FILE * stream)
+		{
+			#ifdef _WIN32
+				const __int64 pos = _ftelli64(stream);
+			#else
+				const off_t pos = ftello(stream);
+			#endif
+			if(pos < 0)
+				throw std::runtime_error("Error, can not read the position in the raw file of the chains");
+			return static_cast<std::uint64_t>(pos);
+		}
+
+		//Records start at multiples of 8 bytes, so that the values of type double are aligned in the memory map
+		std::uint64_t Padded(std::uint64_t const & bytes)
+		{
+			return (bytes + 7) & ~std::uint64_t(7);
+		}
+
+		//Appends the bytes of value to out
+		template<typename T>
+		void Put(std::vector<unsigned char> & out, T const & value)
+		{
+			unsigned char const * ptr = reinterpret_cast<unsigned char const *>(&value);
+			out.insert(out.end(), ptr, ptr + sizeof(T));
+		}
+
+		//Reads a T from in at position pos and moves pos after it. Throws if in is too short
+		template<typename T>
+		T Get(unsigned char const * in, std::uint64_t const & size, std::uint64_t & pos)
+		{
+			if(pos + sizeof(T) > size)
+				throw std::runtime_error("Error, the raw file of the chains is corrupted");
+			T value;
+			std::memcpy(&value, in + pos, sizeof(T));
+			pos += sizeof(T);
+			return value;
+		}
+	}
+
+	//Iterations from first_iter to first_iter + n_iter - 1 of a chain, their values start at offset in the file
+	struct RawRecord{
+		std::uint64_t offset;
+		std::uint64_t first_iter;
+		std::uint64_t n_iter;
+	};
+
+	struct RawChain{
+		std::string name;
+		std::uint32_t type;
+		std::uint64_t elem_size;
+		std::uint64_t rows;
+		std::uint64_t block;
+		std::uint64_t n_iter{0}; //stored iterations, the valid records may contain more of them
+		std::vector<RawRecord> records;
+		std::uint64_t iter_bytes() const{
+			return elem_size*std::max(rows, std::uint64_t(1))*block;
+		}
+		//Adds a record written after the current ones. Iterations that it contains are dropped from the previous records
+		void add(RawRecord const & record){
+			while(!records.empty() && records.back().first_iter >= record.first_iter)
+				records.pop_back();
+			if(!records.empty() && records.back().first_iter + records.back().n_iter > record.first_iter)
+				records.back().n_iter = record.first_iter - records.back().first_iter;
+			records.push_back(record);
+			n_iter = record.first_iter + record.n_iter;
+		}
+	};
+
+	//Chains of a raw file and the end of its last valid record
+	struct RawChainList{
+		std::vector<RawChain> chains;
+		std::uint64_t end{raw_header_bytes};
+		std::uint64_t index_offset{0};
+	};
+
+	//Parses the index record or, if there is none, scans the records of a raw file of size bytes. read(pos, n, out) copies n bytes starting from pos in out
+	template<class Read>
+	static RawChainList ParseRawChains(std::uint64_t const & size, Read && read)
+	{
+		RawChainList list;
+		if(size < raw_header_bytes)
+			throw std::runtime_error("Error, the raw file of the chains is too short");
+		std::vector<unsigned char> header(raw_header_bytes);
+		read(0, raw_header_bytes, header.data());
+		std::uint64_t pos{8};
+		if(std::memcmp(header.data(), raw_magic, 8) != 0)
+			throw std::runtime_error("Error, the file is not a raw file of the chains");
+		if(Get<std::uint32_t>(header.data(), raw_header_bytes, pos) != raw_version)
+			throw std::runtime_error("Error, unknown version of the raw file of the chains");
+		Get<std::uint32_t>(header.data(), raw_header_bytes, pos);
+		list.index_offset = Get<std::uint64_t>(header.data(), raw_header_bytes, pos);
+		std::vector<unsigned char> record(raw_record_bytes);
+		if(list.index_offset > 0 && list.index_offset + raw_record_bytes <= size){
+			read(list.index_offset, raw_record_bytes, record.data());
+			pos = 0;
+			const std::uint32_t kind = Get<std::uint32_t>(record.data(), raw_record_bytes, pos);
+			pos += 12;
+			const std::uint64_t payload = Get<std::uint64_t>(record.data(), raw_record_bytes, pos);
+			if(kind == index_record && list.index_offset + raw_record_bytes + payload <= size){
+				std::vector<unsigned char> index(payload);
+				read(list.index_offset + raw_record_bytes, payload, index.data());
+				unsigned char const * in = index.data();
+				pos = 0;
+				const std::uint64_t n_chains = Get<std::uint64_t>(in, payload, pos);
+				for(std::uint64_t c = 0; c < n_chains; ++c){
+					RawChain chain;
+					chain.type 		= Get<std::uint32_t>(in, payload, pos);
+					const std::uint32_t name_length = Get<std::uint32_t>(in, payload, pos);
+					chain.elem_size = Get<std::uint64_t>(in, payload, pos);
+					chain.rows 		= Get<std::uint64_t>(in, payload, pos);
+					chain.block 	= Get<std::uint64_t>(in, payload, pos);
+					if(pos + name_length > payload)
+						throw std::runtime_error("Error, the raw file of the chains is corrupted");
+					chain.name.assign(reinterpret_cast<char const *>(in + pos), name_length);
+					pos += name_length;
+					const std::uint64_t n_iter = Get<std::uint64_t>(in, payload, pos);
+					const std::uint64_t n_records = Get<std::uint64_t>(in, payload, pos);
+					for(std::uint64_t r = 0; r < n_records; ++r){
+						RawRecord rec;
+						rec.offset 	   = Get<std::uint64_t>(in, payload, pos);
+						rec.first_iter = Get<std::uint64_t>(in, payload, pos);
+						rec.n_iter 	   = Get<std::uint64_t>(in, payload, pos);
+						chain.records.push_back(rec);
+					}
+					chain.n_iter = n_iter;
+					list.chains.push_back(std::move(chain));
+				}
+				list.end = list.index_offset;
+				return list;
+			}
+		}
+		//No index, records are scanned up to the last complete one
+		list.index_offset = 0;
+		std::uint64_t offset{raw_header_bytes};
+		while(offset + raw_record_bytes <= size){
+			read(offset, raw_record_bytes, record.data());
+			pos = 0;
+			const std::uint32_t kind 	   = Get<std::uint32_t>(record.data(), raw_record_bytes, pos);
+			const std::uint32_t id 		   = Get<std::uint32_t>(record.data(), raw_record_bytes, pos);
+			const std::uint64_t first_iter = Get<std::uint64_t>(record.data(), raw_record_bytes, pos);
+			const std::uint64_t payload    = Get<std::uint64_t>(record.data(), raw_record_bytes, pos);
+			if(offset + raw_record_bytes + payload > size || kind == index_record)
+				break;
+			if(kind == chain_record){
+				std::vector<unsigned char> decl(payload);
+				read(offset + raw_record_bytes, payload, decl.data());
+				pos = 0;
+				RawChain chain;
+				chain.type 		= Get<std::uint32_t>(decl.data(), payload, pos);
+				const std::uint32_t name_length = Get<std::uint32_t>(decl.data(), payload, pos);
+				chain.elem_size = Get<std::uint64_t>(decl.data(), payload, pos);
+				chain.rows 		= Get<std::uint64_t>(decl.data(), payload, pos);
+				chain.block 	= Get<std::uint64_t>(decl.data(), payload, pos);
+				if(pos + name_length > payload || id != list.chains.size())
+					throw std::runtime_error("Error, the raw file of the chains is corrupted");
+				chain.name.assign(reinterpret_cast<char const *>(decl.data() + pos), name_length);
+				list.chains.push_back(std::move(chain));
+			}
+			else if(kind == values_record){
+				if(id >= list.chains.size() || list.chains[id].iter_bytes() == 0 || payload % list.chains[id].iter_bytes() != 0)
+					throw std::runtime_error("Error, the raw file of the chains is corrupted");
+				list.chains[id].add(RawRecord{offset + raw_record_bytes, first_iter, payload/list.chains[id].iter_bytes()});
+			}
+			offset = Padded(offset + raw_record_bytes + payload);
+		}
+		list.end = std::min(offset, Padded(size));
+		return list;
+	}
+
+	//Raw file being written, it is shared by the writer and the tasks of its background thread
+	struct RawChainFile{
+		std::string file_name;
+		std::FILE * stream{nullptr};
+		RawChainList list;
+		~RawChainFile(){
+			if(stream != nullptr)
+				std::fclose(stream);
+		}
+		//Appends a record, the file is positioned at its end
+		void append(std::uint32_t const & kind, std::uint32_t const & id, std::uint64_t const & first_iter, unsigned char const * payload, std::uint64_t const & size){
+			std::vector<unsigned char> record;
+			Put(record, kind);
+			Put(record, id);
+			Put(record, first_iter);
+			Put(record, size);
+			const std::uint64_t padding = Padded(size) - size;
+			const char zeros[8] = {0,0,0,0,0,0,0,0};
+			if(std::fwrite(record.data(), 1, record.size(), stream) != record.size() || (size > 0 && std::fwrite(payload, 1, size, stream) != size) ||
+			   (padding > 0 && std::fwrite(zeros, 1, padding, stream) != padding))
+				throw std::runtime_error("Error, can not write the raw file of the chains " + file_name);
+			list.end += raw_record_bytes + Padded(size);
+		}
+		//Writes the index of offset in the header
+		void write_header(std::uint64_t const & index_offset){
+			std::vector<unsigned char> header(raw_magic, raw_magic + 8);
+			Put(header, raw_version);
+			Put(header, static_cast<std::uint32_t>(raw_header_bytes));
+			Put(header, index_offset);
+			header.resize(raw_header_bytes, 0);
+			if(Seek(stream, 0, SEEK_SET) != 0 || std::fwrite(header.data(), 1, header.size(), stream) != header.size())
+				throw std::runtime_error("Error, can not write the raw file of the chains " + file_name);
+		}
+	};
+
+	RawChainWriter::RawChainWriter(std::string const & file_name, bool const & resume):raw(std::make_shared<RawChainFile>())
+	{
+		if(!LittleEndian())
+			throw std::runtime_error("Error, the raw format of the chains is available only on little-endian machines");
+		raw->file_name = RawChainsName(file_name);
+		if(resume){
+			raw->stream = std::fopen(raw->file_name.data(), "r+b");
+			if(raw->stream == nullptr)
+				throw std::runtime_error("Cannot open the raw file of the chains to be resumed, " + raw->file_name);
+			Seek(raw->stream, 0, SEEK_END);
+			const std::uint64_t size = Tell(raw->stream);
+			std::FILE * stream = raw->stream;
+			raw->list = ParseRawChains(size, [stream](std::uint64_t const & pos, std::uint64_t const & n, unsigned char * out){
+				if(Seek(stream, pos, SEEK_SET) != 0 || std::fread(out, 1, n, stream) != n)
+					throw std::runtime_error("Error, can not read the raw file of the chains");
+			});
+			//The index and the incomplete records are dropped, new records are appended
+			std::fflush(raw->stream);
+			#ifdef _WIN32
+				const int status = _chsize_s(_fileno(raw->stream), raw->list.end);
+			#else
+				const int status = ftruncate(fileno(raw->stream), raw->list.end);
+			#endif
+			if(status != 0)
+				throw std::runtime_error("Error, can not truncate the raw file of the chains " + raw->file_name);
+			raw->write_header(0);
+			Seek(raw->stream, 0, SEEK_END);
+		}
+		else{
+			raw->stream = std::fopen(raw->file_name.data(), "w+b");
+			if(raw->stream == nullptr)
+				throw std::runtime_error("Cannot create the raw file of the chains, " + raw->file_name);
+			raw->write_header(0);
+		}
+	}
+
+	RawChainWriter::~RawChainWriter() = default;
+
+	unsigned int RawChainWriter::add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+										   unsigned int const & first_iter, ScalarType const & rows, bool const & resume)
+	{
+		std::uint32_t code;
+		if(H5Tequal(type, H5T_NATIVE_DOUBLE) > 0)
+			code = type_double;
+		else if(H5Tequal(type, H5T_NATIVE_UCHAR) > 0)
+			code = type_uchar;
+		else if(H5Tequal(type, H5T_NATIVE_UINT) > 0)
+			code = type_uint;
+		else
+			throw std::runtime_error("Error, the type of chain " + name + " can not be saved in the raw format");
+		RawChain chain{name, code, H5Tget_size(type), rows, block, 0, {}};
+		auto & chains = raw->list.chains;
+		auto it = std::find_if(chains.begin(), chains.end(), [&name](RawChain const & c){return c.name == name;});
+		if(resume){
+			if(it == chains.end() || it->type != chain.type || it->rows != chain.rows || it->block != chain.block)
+				throw std::runtime_error("Error, the chain " + name + " of the raw file to be resumed does not match the sampler");
+		}
+		else{
+			if(it != chains.end())
+				throw std::runtime_error("Error, the chain " + name + " was already added");
+			writer.flush(); //the writer thread is idle while the declaration is appended
+			std::vector<unsigned char> decl;
+			Put(decl, chain.type);
+			Put(decl, static_cast<std::uint32_t>(name.size()));
+			Put(decl, chain.elem_size);
+			Put(decl, chain.rows);
+			Put(decl, chain.block);
+			decl.insert(decl.end(), name.cbegin(), name.cend());
+			raw->append(chain_record, chains.size(), 0, decl.data(), decl.size());
+			chains.push_back(chain);
+			it = chains.end() - 1;
+		}
+		Staged st{static_cast<unsigned int>(it - chains.begin()), chain.iter_bytes(), 1, first_iter, 0, {}};
+		st.batch_iter = std::clamp(raw_batch_bytes/std::max(st.iter_bytes, std::size_t(1)), ScalarType(1), std::max(static_cast<ScalarType>(iter_to_store), ScalarType(1)));
+		st.buffer.resize(st.iter_bytes*st.batch_iter);
+		staged.push_back(std::move(st));
+		return staged.size() - 1;
+	}
+
+	void RawChainWriter::push_bytes(unsigned int const & id, void const * values, std::size_t const & elem_size, unsigned int const & iter)
+	{
+		Staged & st = staged[id];
+		if(elem_size != raw->list.chains[st.chain].elem_size)
+			throw std::runtime_error("Error in RawChainWriter::push(), the type of the values is not the one of the chain");
+		if(iter != st.first_iter + st.n_iter)
+			throw std::runtime_error("Error in RawChainWriter::push(), iterations have to be consecutive");
+		std::memcpy(st.buffer.data() + st.n_iter*st.iter_bytes, values, st.iter_bytes);
+		if(++st.n_iter == st.batch_iter)
+			send(st);
+	}
+
+	void RawChainWriter::send(Staged & st)
+	{
+		if(st.n_iter == 0)
+			return;
+		std::vector<unsigned char> full(st.buffer.size());
+		full.swap(st.buffer); //st.buffer is filled while full is written
+		const std::uint32_t chain = st.chain;
+		const std::uint64_t first_iter = st.first_iter;
+		const std::uint64_t n_iter = st.n_iter;
+		const std::uint64_t size = st.n_iter*st.iter_bytes;
+		std::shared_ptr<RawChainFile> file = raw;
+		writer.push_task([file, chain, first_iter, n_iter, size, full = std::move(full)](){
+			const std::uint64_t offset = file->list.end + raw_record_bytes;
+			file->append(values_record, chain, first_iter, full.data(), size);
+			file->list.chains[chain].add(RawRecord{offset, first_iter, n_iter});
+		}, false);
+		st.first_iter += st.n_iter;
+		st.n_iter = 0;
+	}
+
+	void RawChainWriter::sync()
+	{
+		for(auto & st : staged)
+			send(st);
+		std::shared_ptr<RawChainFile> file = raw;
+		writer.push_task([file](){
+			if(std::fflush(file->stream) != 0)
+				throw std::runtime_error("Error, can not write the raw file of the chains " + file->file_name);
+		}, false);
+	}
+
+	void RawChainWriter::flush()
+	{
+		sync();
+		writer.flush();
+	}
+
+	void RawChainWriter::close()
+	{
+		flush();
+		writer.close();
+	}
+
+	void RawChainWriter::resize(unsigned int const & id, unsigned int const & n_iter)
+	{
+		RawChain & chain = raw->list.chains[staged[id].chain];
+		chain.n_iter = std::min(chain.n_iter, static_cast<std::uint64_t>(n_iter));
+	}
+
+	void RawChainWriter::release()
+	{
+		if(raw->stream == nullptr)
+			return;
+		std::vector<unsigned char> index;
+		Put(index, static_cast<std::uint64_t>(raw->list.chains.size()));
+		for(auto const & chain : raw->list.chains){
+			Put(index, chain.type);
+			Put(index, static_cast<std::uint32_t>(chain.name.size()));
+			Put(index, chain.elem_size);
+			Put(index, chain.rows);
+			Put(index, chain.block);
+			index.insert(index.end(), chain.name.cbegin(), chain.name.cend());
+			Put(index, chain.n_iter);
+			Put(index, static_cast<std::uint64_t>(chain.records.size()));
+			for(auto const & rec : chain.records){
+				Put(index, rec.offset);
+				Put(index, rec.first_iter);
+				Put(index, rec.n_iter);
+			}
+		}
+		const std::uint64_t index_offset = raw->list.end;
+		raw->append(index_record, 0, 0, index.data(), index.size());
+		raw->write_header(index_offset);
+		const bool closed = (std::fclose(raw->stream) == 0);
+		raw->stream = nullptr;
+		if(!closed)
+			throw std::runtime_error("Error, can not close the raw file of the chains " + raw->file_name);
+	}
+
+	//Memory map of a raw file and its chains
+	struct RawChainIndex{
+		std::string file_name;
+		RawChainList list;
+		unsigned char const * data{nullptr};
+		std::uint64_t size{0};
+		void * base{nullptr};
+		std::vector<unsigned char> buffer; //content of the file where it can not be mapped
+		~RawChainIndex(){
+			#ifndef _WIN32
+				if(base != nullptr)
+					munmap(base, size);
+			#endif
+		}
+	};
+
+	std::shared_ptr<const RawChainIndex> OpenRawChains(std::string const & file_name)
+	{
+		auto raw = std::make_shared<RawChainIndex>();
+		raw->file_name = file_name;
+		#ifdef _WIN32
+			std::ifstream in(file_name, std::ios::binary);
+			if(!in)
+				throw std::runtime_error("Error, can not open the raw file of the chains " + file_name);
+			raw->buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			raw->data = raw->buffer.data();
+			raw->size = raw->buffer.size();
+		#else
+			int fd = open(file_name.data(), O_RDONLY);
+			if(fd < 0)
+				throw std::runtime_error("Error, can not open the raw file of the chains " + file_name);
+			struct stat file_stat;
+			if(fstat(fd, &file_stat) != 0){
+				::close(fd);
+				throw std::runtime_error("Error, can not open the raw file of the chains " + file_name);
+			}
+			raw->size = file_stat.st_size;
+			if(raw->size > 0){
+				void * addr = mmap(NULL, raw->size, PROT_READ, MAP_SHARED, fd, 0);
+				if(addr == MAP_FAILED){
+					::close(fd);
+					throw std::runtime_error("Error, can not map the raw file of the chains " + file_name);
+				}
+				raw->base = addr;
+				raw->data = static_cast<unsigned char const *>(addr);
+			}
+			::close(fd);
+		#endif
+		unsigned char const * data = raw->data;
+		raw->list = ParseRawChains(raw->size, [data](std::uint64_t const & pos, std::uint64_t const & n, unsigned char * out){
+			std::memcpy(out, data + pos, n);
+		});
+		for(auto const & chain : raw->list.chains)
+			for(auto const & rec : chain.records)
+				if(rec.offset + rec.n_iter*chain.iter_bytes() > raw->size)
+					throw std::runtime_error("Error, the raw file of the chains is corrupted");
+		return raw;
+	}
+
+	bool HasRawChain(RawChainIndex const & raw, std::string const & name)
+	{
+		return std::any_of(raw.list.chains.cbegin(), raw.list.chains.cend(), [&name](RawChain const & c){return c.name == name;});
+	}
+
+	RawChainReader::RawChainReader(std::shared_ptr<const RawChainIndex> const & _raw, std::string const & name):raw(_raw)
+	{
+		auto const & chains = raw->list.chains;
+		auto it = std::find_if(chains.cbegin(), chains.cend(), [&name](RawChain const & c){return c.name == name;});
+		if(it == chains.cend())
+			throw std::runtime_error("Error, the raw file " + raw->file_name + " does not contain the chain " + name);
+		chain = it - chains.cbegin();
+	}
+
+	void RawChainReader::copy(unsigned int const & first_iter, unsigned int const & n_iter, unsigned char * out) const
+	{
+		RawChain const & c = raw->list.chains[chain];
+		const std::uint64_t iter_bytes = c.iter_bytes();
+		if(first_iter + n_iter > c.n_iter)
+			throw std::runtime_error("Error, the requested iterations exceed the ones saved in the raw file for " + c.name);
+		std::uint64_t next = first_iter; //next iteration to be copied
+		const std::uint64_t last = first_iter + n_iter;
+		for(auto const & rec : c.records){
+			if(next >= last)
+				break;
+			if(rec.first_iter + rec.n_iter <= next)
+				continue;
+			if(rec.first_iter > next)
+				break; //missing iterations
+			const std::uint64_t n = std::min(rec.first_iter + rec.n_iter, last) - next;
+			std::memcpy(out + (next - first_iter)*iter_bytes, raw->data + rec.offset + (next - rec.first_iter)*iter_bytes, n*iter_bytes);
+			next += n;
+		}
+		if(next < last)
+			throw std::runtime_error("Error, the raw file does not contain all the requested iterations of " + c.name);
+	}
+
+	MatRow RawChainReader::iterations(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter)
+	{
+		RawChain const & c = raw->list.chains[chain];
+		if(c.type != type_double)
+			throw std::runtime_error("Error, the chain " + c.name + " is not made of double");
+		if(first_iter + n_iter > stored_iter)
+			throw std::runtime_error("Error, the requested iterations exceed the chain length");
+		MatRow values(n_iter, c.iter_bytes()/sizeof(double));
+		copy(first_iter, n_iter, reinterpret_cast<unsigned char *>(values.data()));
+		return values;
+	}
+
+	MatRow RawChainReader::elements(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter)
+	{
+		RawChain const & c = raw->list.chains[chain];
+		if(c.type != type_double)
+			throw std::runtime_error("Error, the chain " + c.name + " is not made of double");
+		const std::uint64_t iter_elems = c.iter_bytes()/sizeof(double);
+		if(first + n_elem > iter_elems || stored_iter > c.n_iter)
+			throw std::runtime_error("Error, the requested chains exceed the ones saved in the raw file for " + c.name);
+		//The values of each record are viewed in place, as a (n_iter x iter_elems) matrix
+		MatRow chains(n_elem, stored_iter);
+		std::uint64_t next{0};
+		for(auto const & rec : c.records){
+			if(next >= stored_iter || rec.first_iter > next)
+				break;
+			if(rec.first_iter + rec.n_iter <= next)
+				continue;
+			const std::uint64_t n = std::min(rec.first_iter + rec.n_iter, static_cast<std::uint64_t>(stored_iter)) - next;
+			const Eigen::Map<const MatRow> values(reinterpret_cast<double const *>(raw->data + rec.offset) + (next - rec.first_iter)*iter_elems, n, iter_elems);
+			chains.middleCols(next, n) = values.middleCols(first, n_elem).transpose();
+			next += n;
+		}
+		if(next < stored_iter)
+			throw std::runtime_error("Error, the raw file does not contain all the requested iterations of " + c.name);
+		return chains;
+	}
+
+	std::vector<unsigned char> RawChainReader::bytes(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter)
+	{
+		if(first_iter + n_iter > stored_iter)
+			throw std::runtime_error("Error, the requested iterations exceed the chain length");
+		std::vector<unsigned char> values(n_iter*raw->list.chains[chain].iter_bytes());
+		copy(first_iter, n_iter, values.data());
+		return values;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Factories
+
+	std::unique_ptr<ChainWriter> MakeChainWriter(ChainFormat const & format, FileType & file, std::string const & file_name, bool const & resume)
+	{
+		if(resume && GetChainFormat(file) != format)
+			throw std::runtime_error("Error, the sampling can be resumed only with the same chain_format of the interrupted one");
+		if(format == ChainFormat::Raw)
+			return std::make_unique<RawChainWriter>(file_name, resume);
+		return std::make_unique<HDF5ChainWriter>(file);
+	}
+
+	std::unique_ptr<ChainReader> MakeChainReader(FileType & file, std::string const & group, std::string const & name)
+	{
+		if(GetChainFormat(file, group) == ChainFormat::Raw)
+			return std::make_unique<RawChainReader>(OpenRawChains(RawChainsName(GetFileName(file), group)), "/" + name);
+		return std::make_unique<HDF5ChainReader>(file, group, name);
+	}
+
+	bool HasChain(FileType & file, std::string const & group, std::string const & name)
+	{
+		if(GetChainFormat(file, group) == ChainFormat::Raw)
+			return HasRawChain(*OpenRawChains(RawChainsName(GetFileName(file), group)), "/" + name);
+		return H5Lexists(file, (group + name).data(), H5P_DEFAULT) > 0;
+	}
+}
@@ -0,0 +1,195 @@
+#ifndef __CHAINSTORAGE_HPP__
+#define __CHAINSTORAGE_HPP__
+
+#include "AsyncWriter.h"
+#include "MappedDataset.h"
+
+/*
+	Storage of the chains written by the samplers. Samplers add their chains to a ChainWriter, push the values of each saved iteration and close it, the values
+	are written on a background thread by AsyncWriter. The posterior analysis reads them back through a ChainReader. Two formats are available:
+	- HDF5 (HDF5ChainWriter, HDF5ChainReader), the default one. Each chain is a dataset of the .h5 file created by CreateChainDataset().
+	- Raw (RawChainWriter, RawChainReader). All chains are appended to a single binary file, RawChainsName(), in large sequential batches and without any call
+	  to HDF5. It is read back through a memory map. The .h5 file keeps everything else (/Info, checkpoints, summaries, event log of the graphs) and the dataset
+	  /ChainFormat, that tells the readers where the chains are, see GetChainFormat().
+	The raw file is little-endian. It starts with a header of 32 bytes: the magic string "BGSLRAW1", the version, the size of the header and the offset of the
+	index, zero if there is no index. Then come the records, each one made of kind, chain, first iteration and size of the payload, followed by the payload.
+	- Chain records declare a chain: type, size of its elements, rows, block and name.
+	- Value records hold the values of consecutive iterations of a chain, one iteration after the other. Matrices are saved row by row.
+	- The index record is appended when the writer is released. For each chain, it holds the number of stored iterations and the position of its value records.
+	Records are never rewritten. A resumed sampling drops the index and appends new records, the valid value of an iteration is the one of the last record
+	that contains it. Files without index, e.g of an interrupted sampling, are read by scanning their records.
+*/
+
+namespace HDF5conversion{
+
+	enum class ChainFormat{HDF5, Raw};
+
+	//Format of the chains saved in group, see the dataset ChainFormat. Files without it are in HDF5 format
+	ChainFormat GetChainFormat(FileType & file, std::string const & group = "/");
+	//Writes the dataset /ChainFormat, only for the raw format
+	void WriteChainFormat(FileType & file, ChainFormat const & format);
+	//Format called name, "hdf5" or "raw"
+	ChainFormat ChainFormatFromName(std::string const & name);
+
+	class ChainWriter{
+		public:
+		ChainWriter() = default;
+		virtual ~ChainWriter() = default;
+		ChainWriter(ChainWriter const &) = delete;
+		ChainWriter & operator=(ChainWriter const &) = delete;
+		//Adds the chain name, each iteration adds block elements of type, or a (rows x block) matrix if rows is positive. first_iter is the first iteration to
+		//be written. If resume, the chain written by the interrupted sampling is opened and it has to match the given one. Returns the id to be used in push()
+		virtual unsigned int add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+									   unsigned int const & first_iter = 0, ScalarType const & rows = 0, bool const & resume = false) = 0;
+		//Adds the values of iteration iter of chain id, iterations of a chain have to be consecutive. Matrices are given row by row
+		template<typename T>
+		void push(unsigned int const & id, T const * values, unsigned int const & iter){
+			this->push_bytes(id, values, sizeof(T), iter);
+		}
+		//Generic task that writes on the .h5 file, e.g additions to the event log of the graphs. It is executed in order with the writes of the chains
+		void push_task(std::function<void()> task){
+			writer.push_task(std::move(task));
+		}
+		//Waits until everything pushed so far is written
+		virtual void flush() = 0;
+		//Sends everything pushed so far and makes it visible to the readers of a file in SWMR mode, then writes progress in dataset, see WriteProgress().
+		//It does not wait for the writes
+		void publish(DatasetType const & dataset, std::vector<unsigned int> const & progress){
+			this->sync();
+			writer.push_task([d = dataset, progress]() mutable{ WriteProgress(d, progress); });
+		}
+		//Flushes and stops the background thread, it can not be called while holding h5_mutex
+		virtual void close() = 0;
+		//Drops the iterations of chain id after the first n_iter ones, used when the sampling stops early. Called after close(), holding h5_mutex
+		virtual void resize(unsigned int const & id, unsigned int const & n_iter) = 0;
+		//Closes the chains, called after close(), holding h5_mutex. The .h5 file stays open
+		virtual void release() = 0;
+		protected:
+		virtual void push_bytes(unsigned int const & id, void const * values, std::size_t const & elem_size, unsigned int const & iter) = 0;
+		//Sends the partially filled batches followed by a flush of the file, without waiting
+		virtual void sync() = 0;
+		AsyncWriter writer;
+	};
+
+	//Chains written as datasets of the .h5 file, as CreateChainDataset() and AsyncWriter do
+	class HDF5ChainWriter : public ChainWriter{
+		public:
+		HDF5ChainWriter(FileType & _file):file(_file){}
+		unsigned int add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+							   unsigned int const & first_iter = 0, ScalarType const & rows = 0, bool const & resume = false) override;
+		void flush() override{
+			writer.flush();
+		}
+		void close() override{
+			writer.close();
+		}
+		void resize(unsigned int const & id, unsigned int const & n_iter) override;
+		void release() override;
+		private:
+		void push_bytes(unsigned int const & id, void const * values, std::size_t const & elem_size, unsigned int const & iter) override{
+			writer.push_bytes(id, values, elem_size, iter);
+		}
+		void sync() override;
+		FileType file;
+		std::vector<DatasetType> datasets;
+		std::vector<ScalarType> blocks;
+	};
+
+	struct RawChainFile; //open raw file, shared with the tasks of the writer thread
+
+	//Chains appended to the raw file RawChainsName(file_name). Values are buffered in batches of about raw_batch_bytes bytes per chain, each full batch is
+	//written by the background thread as a single value record
+	class RawChainWriter : public ChainWriter{
+		public:
+		RawChainWriter(std::string const & file_name, bool const & resume = false);
+		~RawChainWriter();
+		unsigned int add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+							   unsigned int const & first_iter = 0, ScalarType const & rows = 0, bool const & resume = false) override;
+		void flush() override;
+		void close() override;
+		void resize(unsigned int const & id, unsigned int const & n_iter) override;
+		void release() override;
+		private:
+		struct Staged{
+			unsigned int chain;     //id of the chain in the file
+			std::size_t iter_bytes; //bytes added by each iteration
+			unsigned int batch_iter;
+			unsigned int first_iter;
+			unsigned int n_iter{0};
+			std::vector<unsigned char> buffer;
+		};
+		void push_bytes(unsigned int const & id, void const * values, std::size_t const & elem_size, unsigned int const & iter) override;
+		void sync() override;
+		void send(Staged & st);
+		std::shared_ptr<RawChainFile> raw;
+		std::vector<Staged> staged;
+	};
+	inline constexpr ScalarType raw_batch_bytes{4194304};
+
+	//Writer of the chains of the sampler that writes file, whose name is file_name
+	std::unique_ptr<ChainWriter> MakeChainWriter(ChainFormat const & format, FileType & file, std::string const & file_name, bool const & resume = false);
+
+
+	class ChainReader{
+		public:
+		virtual ~ChainReader() = default;
+		//Values of n_iter consecutive iterations starting from first_iter, a (n_iter x elements saved by each iteration) matrix. The elements of a matrix
+		//are numbered row by row. stored_iter is the number of iterations of the chain
+		virtual MatRow iterations(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter) = 0;
+		//Chains of n_elem consecutive elements starting from first, a (n_elem x stored_iter) matrix. For matrices, they have to be whole rows
+		virtual MatRow elements(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter) = 0;
+		//Values of n_iter consecutive iterations starting from first_iter, as they were saved. Used for the packed graphs
+		virtual std::vector<unsigned char> bytes(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter) = 0;
+		//If the chains of the elements are stored contiguously in memory, e.g a memory mapped chain-major copy, returns the chains of n_elem consecutive
+		//elements starting from first, as (n_elem x stored_iter) row major values. Returns nullptr otherwise
+		virtual double const * view(unsigned int const &, unsigned int const &, unsigned int const &) const{
+			return nullptr;
+		}
+	};
+
+	//Chain saved as a dataset of the .h5 file. The chain-major copy written by TransposeChain() is used for elements() if available, it is memory mapped
+	//when possible
+	class HDF5ChainReader : public ChainReader{
+		public:
+		HDF5ChainReader(FileType & file, std::string const & group, std::string const & name);
+		~HDF5ChainReader();
+		HDF5ChainReader(HDF5ChainReader const &) = delete;
+		HDF5ChainReader & operator=(HDF5ChainReader const &) = delete;
+		MatRow iterations(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter) override;
+		MatRow elements(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter) override;
+		std::vector<unsigned char> bytes(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter) override;
+		double const * view(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter) const override;
+		private:
+		DatasetType dataset{-1};
+		DatasetType dataset_t{-1}; //chain-major copy
+		MappedDataset mapped;
+	};
+
+	struct RawChainIndex; //records of a raw file
+
+	//Chain saved in a raw file, the file is memory mapped and shared by the readers of all its chains
+	class RawChainReader : public ChainReader{
+		public:
+		RawChainReader(std::shared_ptr<const RawChainIndex> const & _raw, std::string const & name);
+		MatRow iterations(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter) override;
+		MatRow elements(unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter) override;
+		std::vector<unsigned char> bytes(unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter) override;
+		private:
+		//Copies the values of n_iter iterations starting from first_iter in out
+		void copy(unsigned int const & first_iter, unsigned int const & n_iter, unsigned char * out) const;
+		std::shared_ptr<const RawChainIndex> raw;
+		unsigned int chain;
+	};
+
+	//Maps and indexes the raw file file_name
+	std::shared_ptr<const RawChainIndex> OpenRawChains(std::string const & file_name);
+	//True if the raw file contains the chain name
+	bool HasRawChain(RawChainIndex const & raw, std::string const & name);
+
+	//Reader of the chain name saved in group, in the format given by GetChainFormat()
+	std::unique_ptr<ChainReader> MakeChainReader(FileType & file, std::string const & group, std::string const & name);
+	//True if the chain name was saved in group, in any format
+	bool HasChain(FileType & file, std::string const & group, std::string const & name);
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef __CONVERGENCEDIAGNOSTICS_HPP__
+#define __CONVERGENCEDIAGNOSTICS_HPP__
+
+#include "include_headers.h"
+#include <array>
+#include <limits>
+
+/*
+	Convergence diagnostics of scalar summaries of the chain, updated while sampling.
+	The effective sample size is estimated by batch means: values are grouped in consecutive batches and the asymptotic variance of the mean is b*Var(batch means),
+	where b is the batch size. Only the sums of at most max_batches batches are kept, when they are full adjacent batches are merged and the batch size is doubled.
+	Hence the number of batches is always between max_batches/2 and max_batches and the memory is constant.
+	Split-Rhat (Gelman et al., Bayesian Data Analysis, 3rd edition) is computed splitting each chain in two halves, the batches are used to compute the mean and the
+	variance of each half. It is meaningful also for a single chain.
+*/
+
+namespace diagnostics{
+
+	class BatchMeans{
+		public:
+		BatchMeans(unsigned int const & _max_batches = 64):max_batches(std::max(_max_batches + _max_batches%2, 4u)){
+			sums.reserve(max_batches);
+			sums_sq.reserve(max_batches);
+		}
+		void update(double const & x);
+		//Number of values in complete batches, the only ones that are used
+		inline unsigned int size() const{
+			return sums.size()*batch_size;
+		}
+		double mean() const;
+		double variance() const;
+		//Effective sample size of the values in complete batches. It is equal to size() if they are all equal
+		double ess() const;
+		//Mean, variance and length of the two halves of the complete batches. If their number is odd, the last batch is not used
+		std::array<double, 6> halves() const;
+		//Batch size, partial batch and sums of the complete batches. Its length depends on the number of batches
+		std::vector<double> get_state() const;
+		void set_state(std::vector<double> const & state);
+		private:
+		//Mean and variance of batches in [first, last)
+		std::pair<double, double> moments(unsigned int const & first, unsigned int const & last) const;
+		unsigned int max_batches;
+		std::vector<double> sums;
+		std::vector<double> sums_sq;
+		double partial_sum{0};
+		double partial_sq{0};
+		unsigned int partial_count{0};
+		unsigned int batch_size{1};
+	};
+
+	inline void BatchMeans::update(double const & x)
+	{
+		partial_sum += x;
+		partial_sq  += x*x;
+		if(++partial_count < batch_size)
+			return;
+		sums.push_back(partial_sum);
+		sums_sq.push_back(partial_sq);
+		partial_sum = partial_sq = 0.0;
+		partial_count = 0;
+		if(sums.size() == max_batches){ //merge adjacent batches
+			for(unsigned int k = 0; k < max_batches/2; ++k){
+				sums[k]    = sums[2*k] + sums[2*k+1];
+				sums_sq[k] = sums_sq[2*k] + sums_sq[2*k+1];
+			}
+			sums.resize(max_batches/2);
+			sums_sq.resize(max_batches/2);
+			batch_size *= 2;
+		}
+	}
+
+	inline std::pair<double, double> BatchMeans::moments(unsigned int const & first, unsigned int const & last) const
+	{
+		const double n_values = static_cast<double>((last - first)*batch_size);
+		if(n_values < 2)
+			return std::make_pair(0.0, 0.0);
+		const double s  = std::accumulate(sums.cbegin() + first, sums.cbegin() + last, 0.0);
+		const double s2 = std::accumulate(sums_sq.cbegin() + first, sums_sq.cbegin() + last, 0.0);
+		const double m  = s/n_values;
+		return std::make_pair(m, std::max( (s2 - n_values*m*m)/(n_values - 1.0), 0.0 ));
+	}
+
+	inline double BatchMeans::mean() const{
+		return moments(0, sums.size()).first;
+	}
+
+	inline double BatchMeans::variance() const{
+		return moments(0, sums.size()).second;
+	}
+
+	inline double BatchMeans::ess() const
+	{
+		const unsigned int n_batches = sums.size();
+		if(n_batches < 2)
+			return static_cast<double>(size());
+		const double var = this->variance();
+		const double m = this->mean();
+		double var_batch{0}; //variance of the batch means
+		for(auto const & s : sums)
+			var_batch += (s/batch_size - m)*(s/batch_size - m);
+		var_batch /= (n_batches - 1);
+		if(var <= 0 || var_batch <= 0)
+			return static_cast<double>(size());
+		return size()*var/(batch_size*var_batch);
+	}
+
+	inline std::array<double, 6> BatchMeans::halves() const
+	{
+		const unsigned int h = sums.size()/2;
+		auto [m1, v1] = moments(0, h);
+		auto [m2, v2] = moments(h, 2*h);
+		const double len = static_cast<double>(h*batch_size);
+		return {m1, v1, len, m2, v2, len};
+	}
+
+	inline std::vector<double> BatchMeans::get_state() const
+	{
+		std::vector<double> state{static_cast<double>(batch_size), static_cast<double>(partial_count), partial_sum, partial_sq};
+		state.insert(state.end(), sums.cbegin(), sums.cend());
+		state.insert(state.end(), sums_sq.cbegin(), sums_sq.cend());
+		return state;
+	}
+
+	inline void BatchMeans::set_state(std::vector<double> const & state)
+	{
+		if(state.size() < 4 || state.size()%2 != 0 || (state.size() - 4)/2 >= max_batches)
+			throw std::runtime_error("Error in BatchMeans::set_state(), the size of the state is not coherent");
+		const unsigned int n_batches = (state.size() - 4)/2;
+		batch_size    = static_cast<unsigned int>(state[0]);
+		partial_count = static_cast<unsigned int>(state[1]);
+		partial_sum   = state[2];
+		partial_sq    = state[3];
+		sums.assign(state.cbegin() + 4, state.cbegin() + 4 + n_batches);
+		sums_sq.assign(state.cbegin() + 4 + n_batches, state.cend());
+	}
+
+	//Split-Rhat of a scalar, given one BatchMeans for each chain
+	inline double split_rhat(std::vector<BatchMeans const *> const & chains)
+	{
+		std::vector<double> means;
+		std::vector<double> vars;
+		double N{std::numeric_limits<double>::max()};
+		for(auto const & chain : chains){
+			const std::array<double, 6> h = chain->halves();
+			means.insert(means.end(), {h[0], h[3]});
+			vars.insert(vars.end(), {h[1], h[4]});
+			N = std::min(N, h[2]);
+		}
+		const unsigned int M = means.size();
+		if(N < 2 || M < 2)
+			return std::numeric_limits<double>::infinity();
+		const double W = std::accumulate(vars.cbegin(), vars.cend(), 0.0)/M;
+		const double grand_mean = std::accumulate(means.cbegin(), means.cend(), 0.0)/M;
+		double B_over_N{0};
+		for(auto const & m : means)
+			B_over_N += (m - grand_mean)*(m - grand_mean);
+		B_over_N /= (M - 1);
+		if(W <= 0)
+			return (B_over_N > 0) ? std::numeric_limits<double>::infinity() : 1.0;
+		return std::sqrt( ((N - 1.0)/N*W + B_over_N)/W );
+	}
+
+	//Total effective sample size (sum over the chains) and split-Rhat of each monitored scalar. chains[k][s] is the s-th scalar of the k-th chain
+	inline std::tuple<std::vector<double>, std::vector<double>> compute(std::vector<std::vector<BatchMeans>> const & chains)
+	{
+		const unsigned int n_scalars = chains.front().size();
+		std::vector<double> ess(n_scalars, 0.0);
+		std::vector<double> rhat(n_scalars, 0.0);
+		for(unsigned int s = 0; s < n_scalars; ++s){
+			std::vector<BatchMeans const *> scalar_chains;
+			for(auto const & chain : chains){
+				ess[s] += chain[s].ess();
+				scalar_chains.push_back(&chain[s]);
+			}
+			rhat[s] = split_rhat(scalar_chains);
+		}
+		return std::make_tuple(ess, rhat);
+	}
+}
+
+#endif
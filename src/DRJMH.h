@@ -30,6 +30,9 @@ class DoubleReversibleJumpsMH : public ReversibleJumpsMH<GraphStructure, T> {
 						 			 ReversibleJumpsMH<GraphStructure, T>(_ptr_prior, _p, _trGwishSampler, _sigma, _MCiterPrior), Waux(_p){}
 		//Methods
 		ReturnType operator()(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, sample::GSL_RNG const & engine = sample::GSL_RNG() );
+		std::unique_ptr<GGM<GraphStructure, T>> clone()const override{
+			return std::make_unique<DoubleReversibleJumpsMH>(*this);
+		}
 	protected:
 		PrecisionType Waux; 
 };
@@ -46,8 +49,14 @@ DoubleReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsi
 
 	sample::runif rand;
 	double log_acceptance_ratio{0}; 
+	//Check if data is changing or not. if not, do not need to factorize every time. It is needed by informed proposals too
+	if(!this->data_factorized){
+		this->D_plus_U = this->Kprior.get_inv_scale() + this->beta*data;	
+		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
+		this->data_factorized = true;
+	}
 	//1) Propose a new graph
-	auto [Gnew, log_GraphMove_proposal, mv_type] = this->propose_new_graph(Gold, alpha, engine);
+	auto [Gnew, log_GraphMove_proposal, mv_type] = this->propose(Gold, alpha, n, engine);
 	MoveType inverse_mv_type;
 	(mv_type == MoveType::Add) ? (inverse_mv_type = MoveType::Remove) : (inverse_mv_type = MoveType::Add);
 	//2) Sample auxiliary matrix according to Gnew
@@ -73,12 +82,6 @@ DoubleReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsi
 		return( -0.5*res );
 	}; //This lambda function computes trace(A*B)
 
-	//Check if data is changing or not. if not, do not need to factorize every time
-	if(!this->data_factorized){
-		this->D_plus_U = this->Kprior.get_inv_scale() + data;	
-		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
-		this->data_factorized = true;
-	}
 	
 	double log_GraphPr_ratio(this->ptr_prior->log_ratio(Gnew, Gold));
 	double log_LL_GWishPr_ratio(  TraceProd( Knew.get_matrix() - this->Kprior.get_matrix() , this->D_plus_U)  );
@@ -99,6 +102,8 @@ DoubleReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsi
 	}
 
 	double acceptance_ratio = std::min(1.0, std::exp(log_acceptance_ratio)); 
+	this->adapt_sigma(acceptance_ratio);
+	this->last_acceptance = acceptance_ratio;
 	//6) Perform the move and return
 	int accepted;
 	if( rand(engine) < acceptance_ratio ){//Accepted
@@ -110,7 +115,7 @@ DoubleReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsi
 	}
 	//If the move is accepted, Gold is the new graph
 	this->Kprior.set_matrix(Gold_complete, 
-		utils::rgwish<CompleteSkeleton, T, utils::ScaleForm::CholUpper_InvScale, utils::MeanNorm>(Gold_complete, this->Kprior.get_shape() + n, this->chol_inv_DplusU , this->trGwishSampler, engine ) ); 
+		utils::rgwish<CompleteSkeleton, T, utils::ScaleForm::CholUpper_InvScale, utils::MeanNorm>(Gold_complete, this->Kprior.get_shape() + this->beta*n, this->chol_inv_DplusU , this->trGwishSampler, engine ) ); 
 	this->Kprior.compute_Chol();
 	return std::make_tuple(this->Kprior.get_matrix(),accepted);
 
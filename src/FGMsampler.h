@@ -15,7 +15,8 @@ class FGMsampler : public SamplerTraits
 	using GGMType 	    = std::unique_ptr<GGM<GraphStructure, T>>;
 	//using RetType 	    = std::tuple<RetBeta, RetMu, RetK, RetGraph, RetTaueps>;
 
-	FGMsampler( MatCol const & _data, Parameters const & _params, Hyperparameters const & _hy_params, 
+	//Chains run concurrently share the same _data, see FunctionalData
+	FGMsampler( FunctionalDataPtr const & _data, Parameters const & _params, Hyperparameters const & _hy_params, 
 			    Init<GraphStructure, T> const & _init, GGMType & _GGM_method, std::string const & _file_name = "FGMresult", unsigned int _seed = 0, bool _print_pb = true ):
 			    data(_data), params(_params), hy_params(_hy_params), ptr_GGM_method(std::move(_GGM_method)) ,init(_init),
 				p(_init.Beta0.rows()), n(_init.Beta0.cols()), grid_pts(_params.Basemat.rows()), engine(_seed), print_pb(_print_pb), file_name(_file_name)
@@ -23,12 +24,19 @@ class FGMsampler : public SamplerTraits
 	 	this->check();
 	 	file_name += ".h5";
 	} 
+	FGMsampler( MatCol const & _data, Parameters const & _params, Hyperparameters const & _hy_params, 
+			    Init<GraphStructure, T> const & _init, GGMType & _GGM_method, std::string const & _file_name = "FGMresult", unsigned int _seed = 0, bool _print_pb = true ):
+			    FGMsampler(std::make_shared<const FunctionalData>(_data, _params.Basemat), _params, _hy_params, _init, _GGM_method, _file_name, _seed, _print_pb){}
 
 	int run();
+	//Used when more than one chain is run concurrently
+	void set_control(ChainControl const & _control){
+		control = _control;
+	}
 
 	private:
 	void check() const;
-	MatCol data; //grid_pts x n
+	FunctionalDataPtr data;
 	Parameters params;
 	Hyperparameters hy_params;
 	GGMType ptr_GGM_method;
@@ -41,19 +49,24 @@ class FGMsampler : public SamplerTraits
 	int visited{0};
 	bool print_pb;
 	std::string file_name;
+	ChainControl control;
 };
 
 
 template<template <typename> class GraphStructure, typename T >
 void FGMsampler<GraphStructure, T >::check() const{
-	if(data.rows() != grid_pts) //check for grid_pts
+	if(data->grid_pts != grid_pts) //check for grid_pts
 		throw std::runtime_error("Error, incoerent number of grid points");
-	if(data.cols() != n) //check for n
+	if(data->n != n || data->tbase_base.rows() != p) //check for n
 		throw std::runtime_error("Error, incoerent number of data");
 	if( ptr_GGM_method->get_inv_scale().cols() != p || params.Basemat.cols() != p || 
 		p != init.mu0.size() || p != init.K0.cols() || init.K0.cols() != init.K0.rows() || 
 		p != init.G0.get_complete_size()) //check for p
 			throw std::runtime_error("Error, incoerent number of basis");
+	if(params.n_speculative > 1) //consecutive graph moves are given different data, they can not be evaluated speculatively
+		throw std::runtime_error("Error, n_speculative is not available for FGM sampler, set it equal to 1");
+	if(params.n_replicas > 1) //tempered replicas would target different data, since Beta is drawn given the cold chain only
+		throw std::runtime_error("Error, n_replicas is not available for FGM sampler, set it equal to 1");
 }
 
 
@@ -70,7 +83,7 @@ int FGMsampler<GraphStructure, T >::run()
 	const double&  b_tau_eps = this->hy_params.b_tau_eps;
 	const double&  sigma_mu  = this->hy_params.sigma_mu;
 	const double&  p_addrm   = this->hy_params.p_addrm; 
-	const auto &[niter, nburn, thin, thinG, MCiterPrior, MCiterPost,Basemat, ptr_groups, iter_to_store, iter_to_storeG, threshold] = this->params;
+	const auto &[niter, nburn, thin, thinG, MCiterPrior, MCiterPost,Basemat, ptr_groups, iter_to_store, iter_to_storeG, threshold, n_speculative, n_replicas, max_temperature, swap_every, adapt_sigma, target_acceptance, store_chain, lower_qtl, upper_qtl, target_ess, target_rhat, check_every, report_diagnostics, checkpoint_every, resume, keyframe_every, sketch_capacity, chain_format, flush_every] = this->params;
 	MatCol Beta = init.Beta0; //p x n
 	VecCol mu = init.mu0; // p
 	double tau_eps = init.tau_eps0; //scalar
@@ -94,85 +107,146 @@ int FGMsampler<GraphStructure, T >::run()
 	sample::rmvnorm rmv; //Covariance parametrization
 	sample::rgamma  rGamma;
 
-	//Define all those quantities that can be compute once
-	const MatRow tbase_base = Basemat.transpose()*Basemat; // p x p
-	const MatCol tbase_data = Basemat.transpose()*data;	 //  p x n
-	const double Sdata(data.cwiseProduct(data).sum()); // Sum_i(<yi, yi>) sum of the inner products of each data 
-	const double Sdata_btaueps(Sdata+b_tau_eps);
+	//Define all those quantities that can be compute once. Those that depend only on the data are shared by all chains
+	const MatRow & tbase_base = data->tbase_base; // p x p
+	const MatCol & tbase_data = data->tbase_data; //  p x n
+	const double Sdata_btaueps(data->Sdata + b_tau_eps);
 	const double a_tau_eps_post = (n*r + a_tau_eps)*0.5;	
 	const MatRow Irow(MatRow::Identity(p,p));
 	const MatRow one_over_sigma_mu((1/sigma_mu)*Irow);
 									
 
-	//Open file
-	HDF5conversion::FileType file;
-	file = H5Fcreate(file_name.data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-	if(file < 0)
-		throw std::runtime_error("Cannot create the file. The most probable reason is that the execution was stopped before closing a file having the same name of the one that was asked to be generated. Delete the old file or change the name of the new one");
-
-	int bi_dim_rank = 2; //for 2-dim datasets. Beta are matrices
-	int one_dim_rank = 1;//for 1-dim datasets. All other quantities
-	//Print info file
-	HDF5conversion::DataspaceType dataspace_info;
-	HDF5conversion::ScalarType Dim_info = 4;
-	dataspace_info = H5Screate_simple(one_dim_rank, &Dim_info, NULL);
-	HDF5conversion::DatasetType  dataset_info;
-	dataset_info  = H5Dcreate(file,"/Info", H5T_NATIVE_UINT, dataspace_info, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_info < 0)
-		throw std::runtime_error("Error, can not create dataset for Info");
-	{
-		std::vector< unsigned int > info{p,n,iter_to_store,iter_to_storeG};
-		unsigned int * buffer_info = info.data();		
-		HDF5conversion::StatusType status = H5Dwrite(dataset_info, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer_info);
+	//Rao-Blackwellized probabilities of inclusion, see GGM::add_expected_graph()
+	std::vector<double> plinks_rb(n_graph_elem, 0.0);
+	double rb_normalization{0};
+	//Sketch of the saved graphs, it tracks the most visited ones with bounded memory. Probabilities of inclusion of the saved graphs are exact, they are 
+	//accumulated link by link. See HDF5conversion::GraphSketch
+	HDF5conversion::GraphSketch sketch(n_graph_elem, sketch_capacity);
+	std::vector<double> plinks_sketch(n_graph_elem, 0.0);
+	double sketch_normalization{0};
+	//Online summaries of the saved values. Precision matrices are weighted by their waiting times
+	summaries::OnlineSummary summary_Beta(p*n, lower_qtl, upper_qtl);
+	summaries::OnlineSummary summary_Mu(p, lower_qtl, upper_qtl);
+	summaries::OnlineSummary summary_TauEps(1, lower_qtl, upper_qtl);
+	summaries::OnlineSummary summary_K(prec_elem, lower_qtl, upper_qtl);
+	//Convergence diagnostics of tau_eps, of the graph size and of the log-likelihood of the graphical model, see ChainControl::converged(). They are computed
+	//only if they are used, as in GGMsampler
+	const bool track_diagnostics{target_ess > 0 || report_diagnostics};
+	std::vector<diagnostics::BatchMeans> series(3);
+	//A checkpoint can be resumed only by a sampler that writes the same datasets
+	const std::vector<double> checkpoint_settings{static_cast<double>(niter), static_cast<double>(nburn), static_cast<double>(thin), static_cast<double>(thinG), static_cast<double>(store_chain), static_cast<double>(keyframe_every), static_cast<double>(sketch_capacity), static_cast<double>(track_diagnostics)};
+	int iter_start{0};
+
+	//Open file, it is closed even if the sampling throws. In live mode it is written in SWMR mode, so that it can be read while sampling. See HDF5conversion::SamplerOutput
+	const bool live(flush_every > 0);
+	HDF5conversion::SamplerOutput output(file_name, "FGMsampler", {p,n,iter_to_store,iter_to_storeG,static_cast<unsigned int>(niter)}, chain_format, live, resume, 
+										 checkpoint_every > 0); //the last entry of info is the number of performed iterations
+
+	//Restore the state saved by the last checkpoint, the seed of the engine is restored too so that speculative streams are the same
+	if(resume){
+		auto [state, rng_state] = output.read_checkpoint();
+		if(HDF5conversion::CheckpointEntry(state, "Settings") != checkpoint_settings)
+			throw std::runtime_error("Error, the sampling can be resumed only with the same niter, burnin, thin, thinG, store_chain, keyframe_every and sketch_capacity of the interrupted one");
+		const std::vector<double> & counters = HDF5conversion::CheckpointEntry(state, "Counters", 5);
+		iter_start 		 = static_cast<int>(counters[0]);
+		it_saved 		 = static_cast<unsigned int>(counters[1]);
+		it_savedG 		 = static_cast<unsigned int>(counters[2]);
+		total_accepted 	 = static_cast<int>(counters[3]);
+		rb_normalization = counters[4];
+		engine.set_seed(static_cast<unsigned int>(HDF5conversion::CheckpointEntry(state, "Seed", 1)[0]));
+		engine.set_state(rng_state);
+		Beta 	= Eigen::Map<const MatCol>(HDF5conversion::CheckpointEntry(state, "Beta", p*n).data(), p, n);
+		mu 		= Eigen::Map<const VecCol>(HDF5conversion::CheckpointEntry(state, "Mu", p).data(), p);
+		tau_eps = HDF5conversion::CheckpointEntry(state, "TauEps", 1)[0];
+		G = graph_from_checkpoint(HDF5conversion::CheckpointEntry(state, "Graph", n_graph_elem), G);
+		K = Eigen::Map<const MatRow>(HDF5conversion::CheckpointEntry(state, "Precision", p*p).data(), p, p);
+		GGM_method.init_precision(G,K);
+		const std::vector<double> & scale = HDF5conversion::CheckpointEntry(state, "ProposalScale", 2);
+		if(scale[0] > 0)
+			GGM_method.set_proposal_scale(scale[0]);
+		GGM_method.set_n_adapted(static_cast<unsigned int>(scale[1]));
+		plinks_rb = HDF5conversion::CheckpointEntry(state, "PlinksRB", n_graph_elem);
+		if(sketch_capacity > 0){
+			sketch.set_state(HDF5conversion::CheckpointEntry(state, "Sketch"));
+			plinks_sketch = HDF5conversion::CheckpointEntry(state, "SketchLinks", n_graph_elem + 1);
+			sketch_normalization = plinks_sketch.back();
+			plinks_sketch.pop_back();
+		}
+		summary_Beta.set_state(HDF5conversion::CheckpointEntry(state, "SummaryBeta"));
+		summary_Mu.set_state(HDF5conversion::CheckpointEntry(state, "SummaryMu"));
+		summary_TauEps.set_state(HDF5conversion::CheckpointEntry(state, "SummaryTauEps"));
+		summary_K.set_state(HDF5conversion::CheckpointEntry(state, "SummaryPrecision"));
+		for(unsigned int s = 0; s < series.size(); ++s)
+			series[s].set_state(HDF5conversion::CheckpointEntry(state, "Series" + std::to_string(s)));
+		if(print_pb && control.is_main())
+			Rcpp::Rcout<<"Sampling resumed from iteration "<<iter_start<<std::endl;
 	}
-	//Print what sampler has been used
-	HDF5conversion::DatasetType  dataset_version;
-	HDF5conversion::DataspaceType dataspace_version = H5Screate(H5S_NULL);
-	dataset_version = H5Dcreate(file, "/Sampler", H5T_STD_I32LE, dataspace_version, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_version < 0)
-		throw std::runtime_error("Error, can not create dataset for Sampler");
-	HDF5conversion::WriteString(dataset_version, "FGMsampler");
-	//Create dataspaces
-	HDF5conversion::DataspaceType dataspace_Beta, dataspace_Mu, dataspace_Prec, dataspace_TauEps, dataspace_Graph;
-	HDF5conversion::ScalarType Dim_beta_ds[2] = {p, n*iter_to_store}; 
-	HDF5conversion::ScalarType Dim_mu_ds = p*iter_to_store;
-	HDF5conversion::ScalarType Dim_K_ds = prec_elem*iter_to_storeG;
-	HDF5conversion::ScalarType Dim_G_ds = n_graph_elem*iter_to_storeG;
-	HDF5conversion::ScalarType Dim_taueps_ds = iter_to_store;
-
-	dataspace_Beta   = H5Screate_simple(bi_dim_rank,   Dim_beta_ds,   NULL);
-	dataspace_Mu     = H5Screate_simple(one_dim_rank, &Dim_mu_ds,     NULL);
-	dataspace_TauEps = H5Screate_simple(one_dim_rank, &Dim_taueps_ds, NULL);
-	dataspace_Prec   = H5Screate_simple(one_dim_rank, &Dim_K_ds,      NULL);
-	dataspace_Graph  = H5Screate_simple(one_dim_rank, &Dim_G_ds,      NULL);
-
-	//Create dataset
-	HDF5conversion::DatasetType  dataset_Beta, dataset_Mu, dataset_Prec, dataset_TauEps, dataset_Graph;
-	dataset_Beta  = H5Dcreate(file,"/Beta", H5T_NATIVE_DOUBLE, dataspace_Beta, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Beta < 0)
-		throw std::runtime_error("Error, can not create dataset for Beta");
-	dataset_Mu = H5Dcreate(file,"/Mu", H5T_NATIVE_DOUBLE, dataspace_Mu, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Mu < 0)
-		throw std::runtime_error("Error, can not create dataset for Mu");
-	dataset_TauEps  = H5Dcreate(file,"/TauEps", H5T_NATIVE_DOUBLE, dataspace_TauEps, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_TauEps < 0)
-		throw std::runtime_error("Error, can not create dataset for TauEps");
-	dataset_Prec = H5Dcreate(file,"/Precision", H5T_NATIVE_DOUBLE, dataspace_Prec, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Prec < 0)
-		throw std::runtime_error("Error, can not create dataset for Precision");
-	dataset_Graph = H5Dcreate(file,"/Graphs", H5T_NATIVE_UINT, dataspace_Graph, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Graph < 0)
-		throw std::runtime_error("Error, can not create dataset for Graphs");
+	if(keyframe_every > 0) //only the changed links are saved, instead of the chain of the graphs
+		output.add_graph_log(n_graph_elem, iter_to_storeG, keyframe_every, it_savedG);
+	//Chains are created, or reopened if resumed, and written in batches starting from the first value that was not saved yet. See HDF5conversion::ChainWriter
+	unsigned int id_Beta{0}, id_Mu{0}, id_TauEps{0}, id_Prec{0}, id_Graph{0};
+	if(store_chain){ //otherwise only the online summaries of the parameters are saved
+		id_Beta   = output.add_chain("/Beta", H5T_NATIVE_DOUBLE, n, iter_to_store, it_saved, p); //(p x n*iter_to_store)
+		id_Mu 	  = output.add_chain("/Mu", H5T_NATIVE_DOUBLE, p, iter_to_store, it_saved);
+		id_TauEps = output.add_chain("/TauEps", H5T_NATIVE_DOUBLE, 1, iter_to_store, it_saved);
+		id_Prec   = output.add_chain("/Precision", H5T_NATIVE_DOUBLE, prec_elem, iter_to_storeG, it_savedG);
+	}
+	if(keyframe_every == 0)
+		id_Graph = output.add_chain("/Graphs", H5T_NATIVE_UCHAR, HDF5conversion::PackedSize(n_graph_elem), iter_to_storeG, it_savedG);
+	//Waiting times of saved graphs. They are all equal to one for discrete time algorithms
+	const unsigned int id_Weights = output.add_chain("/Weights", H5T_NATIVE_DOUBLE, 1, iter_to_storeG, it_savedG);
+	output.start();
 
 	//Setup for progress bar, need to specify the total number of iterations
 	pBar bar(niter);
+	bar.update(iter_start);
+	const unsigned int base_seed(engine.get_seed());
+	//Adaptation of the proposal scale is active during burn-in only
+	bool adapting(adapt_sigma && nburn > 0);
+	GGM_method.set_adaptation(adapting, target_acceptance);
+	unsigned int n_checks{0};
+	int iter_done{niter};
+	//Saves the state reached after iteration iter, the sampling is resumed from the next one
+	auto write_checkpoint = [&](int const & iter){
+		const std::vector<T> adj(G.get_adj_list());
+		const double scale{GGM_method.get_proposal_scale()};
+		HDF5conversion::CheckpointType state{
+			{"Settings", checkpoint_settings},
+			{"Counters", {static_cast<double>(iter + 1), static_cast<double>(it_saved), static_cast<double>(it_savedG), static_cast<double>(total_accepted), rb_normalization}},
+			{"Seed", {static_cast<double>(base_seed)}},
+			{"Beta", std::vector<double>(Beta.data(), Beta.data() + Beta.size())},
+			{"Mu", std::vector<double>(mu.data(), mu.data() + mu.size())},
+			{"TauEps", {tau_eps}},
+			{"Graph", std::vector<double>(adj.cbegin(), adj.cend())},
+			{"Precision", std::vector<double>(K.data(), K.data() + K.size())},
+			{"ProposalScale", {scale, static_cast<double>(GGM_method.get_n_adapted())}},
+			{"PlinksRB", plinks_rb},
+			{"SummaryBeta", summary_Beta.get_state()},
+			{"SummaryMu", summary_Mu.get_state()},
+			{"SummaryTauEps", summary_TauEps.get_state()},
+			{"SummaryPrecision", summary_K.get_state()}
+		};
+		for(unsigned int s = 0; s < series.size(); ++s)
+			state["Series" + std::to_string(s)] = series[s].get_state();
+		if(sketch_capacity > 0){
+			state["Sketch"] = sketch.get_state();
+			state["SketchLinks"] = plinks_sketch;
+			state["SketchLinks"].push_back(sketch_normalization);
+		}
+		output.write_checkpoint(state, engine.get_state());
+	};
 	 
 	//Start MCMC loop
-	for(int iter = 0; iter < niter; iter++){
+	for(int iter = iter_start; iter < niter; iter++){
 		
+		//Freeze the proposal scale at the end of burn-in
+		if(adapting && iter >= nburn){
+			adapting = false;
+			GGM_method.set_adaptation(false);
+		}
 		//Show progress bar
 		bar.update(1);
-		if(print_pb){
+		if(print_pb && control.is_main()){
 			bar.print(); 	
 		}
 		int accepted_mv{0};
@@ -209,66 +283,118 @@ int FGMsampler<GraphStructure, T >::run()
 		
 
 		//Graphical Step
+		const Graph G_old(G);
 		GGM_method.data_factorized = false; //Need to tell it that matrix U is changing at every iteration and that has to be factorized everytime
 		std::tie(K, accepted_mv) = GGM_method(U, n, G, p_addrm, engine); //G is modified inside the function.
 		total_accepted += accepted_mv;
 
 		//Check for user interruption
-		try{
-		  Rcpp::checkUserInterrupt();
-		}
-		catch(Rcpp::internal::InterruptedException e){ //Close all files before leaving
-			Rcpp::Rcout<<"Execution stopped during iter "<<iter<<"/"<<niter<<std::endl;
-			H5Dclose(dataset_Graph);
-			H5Dclose(dataset_Beta);
-			H5Dclose(dataset_TauEps);
-			H5Dclose(dataset_Prec);
-			H5Dclose(dataset_Mu);
-			H5Dclose(dataset_info);
-			H5Dclose(dataset_version);
-			H5Fclose(file);
+		if(control.interrupted()){ //Close all files before leaving
+			if(control.is_main())
+				Rcpp::Rcout<<"Execution stopped during iter "<<iter<<"/"<<niter<<std::endl;
+			output.interrupt({it_saved, it_savedG, static_cast<unsigned int>(iter)});
 			return -1;
 		}
 		
 		//Save
 		if(iter >= nburn){
+			//Rao-Blackwellized probabilities of inclusion use all iterations after burn-in
+			const double rb_weight{GGM_method.get_waiting_time()};
+			GGM_method.add_expected_graph(plinks_rb, G_old, G, rb_weight);
+			rb_normalization += rb_weight;
 			if((iter - nburn)%thin == 0 && it_saved < iter_to_store){
+				summary_Beta.update(Eigen::Map<const VecCol>(Beta.data(), Beta.size())); //Beta is summarized column by column
+				summary_Mu.update(mu);
+				summary_TauEps.update(tau_eps);
 				//Save on file
-				HDF5conversion::AddMatrix(dataset_Beta,   Beta,    it_saved);	
-				HDF5conversion::AddVector(dataset_Mu,     mu,      it_saved);	
-				HDF5conversion::AddScalar(dataset_TauEps, tau_eps, it_saved);
+				if(store_chain){
+					const MatRow Beta_row(Beta); //hdf5 stores matrices row-wise
+					output.push(id_Beta,   Beta_row.data(), it_saved);
+					output.push(id_Mu,     mu.data(),       it_saved);
+					output.push(id_TauEps, &tau_eps,        it_saved);
+				}
 				it_saved++;
 
 			}
 			if((iter - nburn)%thinG == 0 && it_savedG < iter_to_storeG){
 
 				//Save on file
-				std::vector<unsigned int> adj_file;
-				if constexpr( ! std::is_same_v<T, unsigned int>){
-					std::vector<T> adj_nouint(G.get_adj_list());
-					adj_file.resize(adj_nouint.size());
-					std::transform(adj_nouint.begin(), adj_nouint.end(), adj_file.begin(), [](T x) { return (unsigned int)x;});
-				}
-				else{
-					adj_file = G.get_adj_list();
-				}
+				std::vector<unsigned char> packed_G(HDF5conversion::PackGraph(G.get_adj_list())); //one bit per link
 				VecCol UpperK{utils::get_upper_part(K)};
-				HDF5conversion::AddVector(dataset_Prec, UpperK, it_savedG);	
-				HDF5conversion::AddUintVector(dataset_Graph, adj_file, it_savedG);
+				double waiting_time{GGM_method.get_waiting_time()};
+				summary_K.update(UpperK, waiting_time);
+				if(store_chain)
+					output.push(id_Prec, UpperK.data(), it_savedG);
+				if(keyframe_every > 0)
+					output.push_graph(packed_G, it_savedG);
+				else
+					output.push(id_Graph, packed_G.data(), it_savedG);
+				output.push(id_Weights, &waiting_time, it_savedG);
+				if(sketch_capacity > 0){
+					sketch.add(packed_G);
+					for(unsigned int j = 0; j < n_graph_elem; ++j)
+						if((packed_G[j/8] >> (j%8)) & 1u)
+							plinks_sketch[j] += waiting_time;
+					sketch_normalization += waiting_time;
+				}
 				it_savedG++;
 
 			}
+			//Convergence diagnostics
+			if(track_diagnostics){
+				series[0].update(tau_eps);
+				series[1].update(G.get_n_links());
+				series[2].update(utils::log_likelihood_GGM(K, U, n));
+				if((iter - nburn + 1)%check_every == 0 && control.converged(n_checks++, series, target_ess, target_rhat)){
+					iter_done = iter + 1;
+					if(print_pb && control.is_main())
+						Rcpp::Rcout<<std::endl<<"Target effective sample size reached, sampling stopped after "<<iter_done<<" iterations"<<std::endl;
+					break;
+				}
+			}
 		}
+		if(checkpoint_every > 0 && (iter + 1)%checkpoint_every == 0)
+			write_checkpoint(iter);
+		if(live && (iter + 1)%flush_every == 0) //values saved so far become visible to the readers of the file
+			output.publish({it_saved, it_savedG, static_cast<unsigned int>(iter + 1)});
 	}
-
-	H5Dclose(dataset_Graph);
-	H5Dclose(dataset_Beta);
-	H5Dclose(dataset_TauEps);
-	H5Dclose(dataset_Prec);
-	H5Dclose(dataset_Mu);
-	H5Dclose(dataset_info);
-	H5Dclose(dataset_version);
-	H5Fclose(file);
+	if(print_pb && control.is_main() && n_checks > 0){
+		auto [ess, rhat] = control.get_diagnostics();
+		Rcpp::Rcout<<std::endl<<"Effective sample size (tau_eps, graph size, log-likelihood): "<<ess[0]<<", "<<ess[1]<<", "<<ess[2]<<std::endl;
+		Rcpp::Rcout<<"Split-Rhat (tau_eps, graph size, log-likelihood): "<<rhat[0]<<", "<<rhat[1]<<", "<<rhat[2]<<std::endl;
+	}
+	const double tuned_sigma{GGM_method.get_proposal_scale()}; //0 if the algorithm has no proposal scale
+	if(adapt_sigma && tuned_sigma > 0 && print_pb && control.is_main())
+		Rcpp::Rcout<<std::endl<<"Tuned sigmaG = "<<tuned_sigma<<std::endl;
+	//Update the number of saved and performed iterations, they are smaller than expected if the sampling stopped early
+	output.complete({p,n,it_saved,it_savedG,static_cast<unsigned int>(iter_done)});
+	HDF5conversion::FileType & file = output.get_file();
+	if(adapt_sigma && tuned_sigma > 0) //Save the tuned proposal scale
+		HDF5conversion::WriteScalarDataset(file, "/SigmaG", tuned_sigma);
+	if(rb_normalization > 0)
+		HDF5conversion::WriteMatrixDataset(file, "/PlinksRB", utils::plinks_from_adj(plinks_rb, rb_normalization, ptr_groups));
+	if(sketch_capacity > 0){
+		HDF5conversion::WriteGraphSketch(file, sketch);
+		if(sketch_normalization > 0)
+			HDF5conversion::WriteMatrixDataset(file, "/SketchPlinks", utils::plinks_from_adj(plinks_sketch, sketch_normalization, ptr_groups));
+	}
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryBeta", summary_Beta.get_summary());
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryMu", summary_Mu.get_summary());
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryTauEps", summary_TauEps.get_summary());
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryPrecision", summary_K.get_summary());
+	MatRow qtl_levels(1,2);
+	qtl_levels << lower_qtl, upper_qtl;
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryQuantiles", qtl_levels);
+	//Diagnostics of this chain only. Columns are tau_eps, graph size and log-likelihood, rows are effective sample size and split-Rhat
+	if(track_diagnostics){
+		MatRow chain_diagnostics(2,3);
+		for(unsigned int s = 0; s < series.size(); ++s){
+			chain_diagnostics(0,s) = series[s].ess();
+			chain_diagnostics(1,s) = diagnostics::split_rhat({&series[s]});
+		}
+		HDF5conversion::WriteMatrixDataset(file, "/Diagnostics", chain_diagnostics);
+	}
+	output.close();
 
 	return total_accepted;
 }
@@ -74,12 +74,20 @@ class FLMParameters : public FLMsamplerTraits{
 	MatCol Basemat; //grid_pts x p
 	unsigned int iter_to_store;
 	double trGwishSampler;
+	unsigned int checkpoint_every{0}; //number of iterations between two checkpoints of the state of the sampler, 0 means no checkpoints
+	bool resume{false}; //if true, the sampling restarts from the last checkpoint saved in the file
+	HDF5conversion::ChainFormat chain_format{HDF5conversion::ChainFormat::HDF5}; //format of the saved chains, see HDF5conversion::ChainWriter
+	unsigned int flush_every{0}; //if positive, the file is written in SWMR mode and the saved values are made visible to its readers every flush_every iterations. See HDF5conversion::StartLiveWriting()
 	friend std::ostream & operator<<(std::ostream &str, FLMParameters & pm){
 		str<<"niter = "<<pm.niter<<std::endl;
 		str<<"nburn = "<<pm.nburn<<std::endl;
 		str<<"thin  = "<<pm.thin<<std::endl;
 		str<<"Basemat: "<<std::endl<<pm.Basemat<<std::endl;
 		str<<"iter_to_store  = "<<pm.iter_to_store<<std::endl;
+		str<<"checkpoint_every = "<<pm.checkpoint_every<<std::endl;
+		str<<"resume = "<<pm.resume<<std::endl;
+		str<<"chain_format = "<<((pm.chain_format == HDF5conversion::ChainFormat::Raw) ? "raw" : "hdf5")<<std::endl;
+		str<<"flush_every = "<<pm.flush_every<<std::endl;
 		return str;
 	} 
 };
@@ -17,7 +17,8 @@ class FLMsampler : public FLMsamplerTraits
 										//std::tuple<RetBeta, RetMu, RetTauK, RetTaueps> , 
 										//std::tuple<RetBeta, RetMu, RetK, RetTaueps>    > ;
 	public:
-	FLMsampler( MatCol const & _data, FLMParameters const & _params, FLMHyperparameters const & _hy_params, 
+	//Chains run concurrently share the same _data, see FunctionalData
+	FLMsampler( FunctionalDataPtr const & _data, FLMParameters const & _params, FLMHyperparameters const & _hy_params, 
 			    InitFLM const & _init,  std::string const & _file_name = "FLMresult", unsigned int _seed = 0, bool _print_pb = true):
 			    data(_data), params(_params), hy_params(_hy_params) ,init(_init),
 				p(_init.Beta0.rows()), n(_init.Beta0.cols()), grid_pts(_params.Basemat.rows()), engine(_seed), print_pb(_print_pb), file_name(_file_name)
@@ -25,12 +26,19 @@ class FLMsampler : public FLMsamplerTraits
 	 	this->check();
 	 	file_name += ".h5";
 	} 
+	FLMsampler( MatCol const & _data, FLMParameters const & _params, FLMHyperparameters const & _hy_params, 
+			    InitFLM const & _init,  std::string const & _file_name = "FLMresult", unsigned int _seed = 0, bool _print_pb = true):
+			    FLMsampler(std::make_shared<const FunctionalData>(_data, _params.Basemat), _params, _hy_params, _init, _file_name, _seed, _print_pb){}
 
 	int run();
+	//Used when more than one chain is run concurrently
+	void set_control(ChainControl const & _control){
+		control = _control;
+	}
 
 	private:
 	void check() const;
-	MatCol data; //grid_pts x n
+	FunctionalDataPtr data;
 	FLMParameters params;
 	FLMHyperparameters hy_params;
 	InitFLM init;
@@ -40,13 +48,14 @@ class FLMsampler : public FLMsamplerTraits
 	sample::GSL_RNG engine;
 	bool print_pb;
 	std::string file_name;
+	ChainControl control;
 };
 
 template< GraphForm Graph >
 void FLMsampler<Graph>::check() const{
-	if(data.rows() != grid_pts) //check for grid_pts
+	if(data->grid_pts != grid_pts) //check for grid_pts
 		throw std::runtime_error("Error, incoerent number of grid points");
-	if(data.cols() != n) //check for n
+	if(data->n != n || data->tbase_base.rows() != p) //check for n
 		throw std::runtime_error("Error, incoerent number of data");
 	if( params.Basemat.cols() != p || p != init.mu0.size() ) //check for p
 			throw std::runtime_error("Error, incoerent number of basis");
@@ -68,7 +77,7 @@ int FLMsampler<Graph>::run() //typename FLMsampler<Graph>::RetType
 	const double&  b_tauK    = this->hy_params.b_tauK; 
 	const double&  bK    	 = this->hy_params.bK; 
 	const MatCol&  DK    	 = this->hy_params.DK; 
-	const auto &[niter, nburn, thin, Basemat, iter_to_store, threshold] = this->params;
+	const auto &[niter, nburn, thin, Basemat, iter_to_store, threshold, checkpoint_every, resume, chain_format, flush_every] = this->params;
 	unsigned int prec_elem{0}; //What is the number of elemets in the precision matrix to be saved? It depends on the template parameter. 
 	std::string sampler_version = "FLMsampler_";
 	if constexpr(Graph == GraphForm::Diagonal){ 
@@ -91,84 +100,78 @@ int FLMsampler<Graph>::run() //typename FLMsampler<Graph>::RetType
 	sample::rmvnorm rmv; //Covariance parametrization
 	sample::rgamma  rgamma;
 
-	//Define all those quantities that can be compute once
-	const MatRow tbase_base = Basemat.transpose()*Basemat; // p x p
-	const MatCol tbase_data = Basemat.transpose()*data;	 //  p x n
-	const double Sdata(data.cwiseProduct(data).sum()); // Sum_i(<yi, yi>) sum of the inner products of each data 
-	const double Sdata_btaueps(Sdata+b_tau_eps);
+	//Define all those quantities that can be compute once. Those that depend only on the data are shared by all chains
+	const MatRow & tbase_base = data->tbase_base; // p x p
+	const MatCol & tbase_data = data->tbase_data; //  p x n
+	const double Sdata_btaueps(data->Sdata + b_tau_eps);
 	const double a_tau_eps_post = (n*r + a_tau_eps)*0.5;	
 	const double a_tauK_post = (n + a_tauK)*0.5;	
 	const MatRow Irow(MatRow::Identity(p,p));
 	const VecCol one_over_sigma_mu_vec(VecCol::Constant(p,1/sigma_mu));
 	const MatRow one_over_sigma_mu_mat((1/sigma_mu)*Irow);
 	
-	//Open file
-	HDF5conversion::FileType file;
-	file = H5Fcreate(file_name.data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT); 
-	if(file < 0)
-		throw std::runtime_error("Cannot create the file. The most probable reason is that the execution was stopped before closing a file having the same name of the one that was asked to be generated. Delete the old file or change the name of the new one");
-
-	int bi_dim_rank = 2; //for 2-dim datasets. Beta are matrices
-	int one_dim_rank = 1;//for 1-dim datasets. All other quantities
-	//Print file info
-	HDF5conversion::DataspaceType dataspace_info;
-	HDF5conversion::ScalarType Dim_info = 4;
-	dataspace_info = H5Screate_simple(one_dim_rank, &Dim_info, NULL);
-	HDF5conversion::DatasetType  dataset_info;
-	dataset_info  = H5Dcreate(file,"/Info", H5T_NATIVE_UINT, dataspace_info, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_info < 0)
-		throw std::runtime_error("Error can not create dataset for Info");
-	{
-		std::vector< unsigned int > info{p,n,iter_to_store,iter_to_store};
-		unsigned int * buffer_info = info.data();		
-		HDF5conversion::StatusType status = H5Dwrite(dataset_info, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer_info);
+	//A checkpoint can be resumed only by a sampler that writes the same datasets
+	const std::vector<double> checkpoint_settings{static_cast<double>(niter), static_cast<double>(nburn), static_cast<double>(thin)};
+	int iter_start{0};
+	unsigned int it_saved{0};
+	
+	//Open file, it is closed even if the sampling throws. In live mode it is written in SWMR mode, so that it can be read while sampling. See HDF5conversion::SamplerOutput
+	const bool live(flush_every > 0);
+	HDF5conversion::SamplerOutput output(file_name, sampler_version, {p,n,iter_to_store,iter_to_store}, chain_format, live, resume, checkpoint_every > 0);
+
+	//Restore the state saved by the last checkpoint
+	if(resume){
+		auto [state, rng_state] = output.read_checkpoint();
+		if(HDF5conversion::CheckpointEntry(state, "Settings") != checkpoint_settings)
+			throw std::runtime_error("Error, the sampling can be resumed only with the same niter, burnin and thin of the interrupted one");
+		const std::vector<double> & counters = HDF5conversion::CheckpointEntry(state, "Counters", 2);
+		iter_start = static_cast<int>(counters[0]);
+		it_saved   = static_cast<unsigned int>(counters[1]);
+		engine.set_seed(static_cast<unsigned int>(HDF5conversion::CheckpointEntry(state, "Seed", 1)[0]));
+		engine.set_state(rng_state);
+		Beta 	= Eigen::Map<const MatCol>(HDF5conversion::CheckpointEntry(state, "Beta", p*n).data(), p, n);
+		mu 		= Eigen::Map<const VecCol>(HDF5conversion::CheckpointEntry(state, "Mu", p).data(), p);
+		tau_eps = HDF5conversion::CheckpointEntry(state, "TauEps", 1)[0];
+		if constexpr(Graph == GraphForm::Diagonal)
+			tauK = Eigen::Map<const VecCol>(HDF5conversion::CheckpointEntry(state, "Precision", p).data(), p);
+		else
+			K = Eigen::Map<const MatRow>(HDF5conversion::CheckpointEntry(state, "Precision", p*p).data(), p, p);
+		if(print_pb && control.is_main())
+			Rcpp::Rcout<<"Sampling resumed from iteration "<<iter_start<<std::endl;
 	}
-	//Print what sampler has been used
-	HDF5conversion::DatasetType  dataset_version;
-	HDF5conversion::DataspaceType dataspace_version = H5Screate(H5S_NULL);
-	dataset_version = H5Dcreate(file, "/Sampler", H5T_STD_I32LE, dataspace_version, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_version < 0)
-		throw std::runtime_error("Error, can not create dataset for Sampler");
-	HDF5conversion::WriteString(dataset_version, sampler_version);
-	//Create dataspaces
-	HDF5conversion::DataspaceType dataspace_Beta, dataspace_Mu, dataspace_Prec, dataspace_TauEps;
-	HDF5conversion::ScalarType Dim_beta_ds[2] = {p, n*iter_to_store}; 
-	HDF5conversion::ScalarType Dim_mu_ds = p*iter_to_store;
-	HDF5conversion::ScalarType Dim_K_ds = prec_elem*iter_to_store;
-	HDF5conversion::ScalarType Dim_taueps_ds = iter_to_store;
-
-	dataspace_Beta = H5Screate_simple(bi_dim_rank,   Dim_beta_ds,     NULL);
-	dataspace_Mu = H5Screate_simple(one_dim_rank, &Dim_mu_ds,         NULL);
-	dataspace_TauEps = H5Screate_simple(one_dim_rank, &Dim_taueps_ds, NULL);
-	dataspace_Prec = H5Screate_simple(one_dim_rank, &Dim_K_ds, NULL);
-
-	//Create dataset
-	HDF5conversion::DatasetType  dataset_Beta, dataset_Mu, dataset_Prec, dataset_TauEps;
-	dataset_Beta  = H5Dcreate(file,"/Beta", H5T_NATIVE_DOUBLE, dataspace_Beta, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Beta < 0)
-		throw std::runtime_error("Error can not create dataset for Beta ");
-	dataset_Mu = H5Dcreate(file,"/Mu", H5T_NATIVE_DOUBLE, dataspace_Mu, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Mu < 0)
-		throw std::runtime_error("Error can not create dataset for Mu");
-	//SURE_ASSERT(dataset_Mu>=0,"Cannot create dataset for Mu");
-	dataset_TauEps  = H5Dcreate(file,"/TauEps", H5T_NATIVE_DOUBLE, dataspace_TauEps, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_TauEps < 0)
-		throw std::runtime_error("Error can not create dataset for TauEps");
-	dataset_Prec = H5Dcreate(file,"/Precision", H5T_NATIVE_DOUBLE, dataspace_Prec, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataspace_Prec < 0)
-		throw std::runtime_error("Error can not create dataset for Precision");
-
+	//Chains are created, or reopened if resumed, and written in batches starting from the first value that was not saved yet. See HDF5conversion::ChainWriter
+	const unsigned int id_Beta   = output.add_chain("/Beta", H5T_NATIVE_DOUBLE, n, iter_to_store, it_saved, p); //(p x n*iter_to_store)
+	const unsigned int id_Mu 	 = output.add_chain("/Mu", H5T_NATIVE_DOUBLE, p, iter_to_store, it_saved);
+	const unsigned int id_Prec   = output.add_chain("/Precision", H5T_NATIVE_DOUBLE, prec_elem, iter_to_store, it_saved);
+	const unsigned int id_TauEps = output.add_chain("/TauEps", H5T_NATIVE_DOUBLE, 1, iter_to_store, it_saved);
+	output.start();
 
 
 	//Setup for progress bar, need to specify the total number of iterations
 	pBar bar(niter);
+	bar.update(iter_start);
+	//Saves the state reached after iteration iter, the sampling is resumed from the next one
+	auto write_checkpoint = [&](int const & iter){
+		HDF5conversion::CheckpointType state{
+			{"Settings", checkpoint_settings},
+			{"Counters", {static_cast<double>(iter + 1), static_cast<double>(it_saved)}},
+			{"Seed", {static_cast<double>(engine.get_seed())}},
+			{"Beta", std::vector<double>(Beta.data(), Beta.data() + Beta.size())},
+			{"Mu", std::vector<double>(mu.data(), mu.data() + mu.size())},
+			{"TauEps", {tau_eps}}
+		};
+		if constexpr(Graph == GraphForm::Diagonal)
+			state["Precision"] = std::vector<double>(tauK.data(), tauK.data() + tauK.size());
+		else
+			state["Precision"] = std::vector<double>(K.data(), K.data() + K.size());
+		output.write_checkpoint(state, engine.get_state());
+	};
 	 
 	//Start MCMC loop
-	unsigned int it_saved{0};
-	for(int iter = 0; iter < niter; iter++){
+	for(int iter = iter_start; iter < niter; iter++){
 		//Show progress bar
 		bar.update(1);
-		if(print_pb){
+		if(print_pb && control.is_main()){
 		 bar.print(); 
 		}
 
@@ -217,10 +220,11 @@ int FLMsampler<Graph>::run() //typename FLMsampler<Graph>::RetType
 
 				if((iter - nburn)%thin == 0 && it_saved < iter_to_store){
 
-					HDF5conversion::AddMatrix(dataset_Beta,   Beta,    it_saved);	
-					HDF5conversion::AddVector(dataset_Mu,     mu,      it_saved);	
-					HDF5conversion::AddVector(dataset_Prec,   tauK,    it_saved);	
-					HDF5conversion::AddScalar(dataset_TauEps, tau_eps, it_saved);
+					const MatRow Beta_row(Beta); //hdf5 stores matrices row-wise
+					output.push(id_Beta,   Beta_row.data(), it_saved);
+					output.push(id_Mu,     mu.data(),       it_saved);
+					output.push(id_Prec,   tauK.data(),     it_saved);
+					output.push(id_TauEps, &tau_eps,        it_saved);
 					it_saved++;
 
 				}
@@ -268,10 +272,11 @@ int FLMsampler<Graph>::run() //typename FLMsampler<Graph>::RetType
 				if((iter - nburn)%thin == 0 && it_saved < iter_to_store){
 
 					VecCol UpperK{utils::get_upper_part(K)};
-					HDF5conversion::AddMatrix(dataset_Beta,   Beta,    it_saved);	
-					HDF5conversion::AddVector(dataset_Mu,     mu,      it_saved);	
-					HDF5conversion::AddVector(dataset_Prec,   UpperK,  it_saved);	
-					HDF5conversion::AddScalar(dataset_TauEps, tau_eps, it_saved);
+					const MatRow Beta_row(Beta); //hdf5 stores matrices row-wise
+					output.push(id_Beta,   Beta_row.data(), it_saved);
+					output.push(id_Mu,     mu.data(),       it_saved);
+					output.push(id_Prec,   UpperK.data(),   it_saved);
+					output.push(id_TauEps, &tau_eps,        it_saved);
 					it_saved++;
 
 				}
@@ -279,29 +284,19 @@ int FLMsampler<Graph>::run() //typename FLMsampler<Graph>::RetType
 		}
 
 		//Check for User interruption
-		try{
-		  Rcpp::checkUserInterrupt();
-		}
-		catch(Rcpp::internal::InterruptedException e){ //Close all files before leaving
-			Rcpp::Rcout<<"Execution stopped during iter "<<iter<<"/"<<niter<<std::endl;
-			H5Dclose(dataset_Beta);
-			H5Dclose(dataset_TauEps);
-			H5Dclose(dataset_Prec);
-			H5Dclose(dataset_Mu);
-			H5Dclose(dataset_info);
-			H5Dclose(dataset_version);
-			H5Fclose(file);
+		if(control.interrupted()){ //Close all files before leaving
+			if(control.is_main())
+				Rcpp::Rcout<<"Execution stopped during iter "<<iter<<"/"<<niter<<std::endl;
+			output.interrupt({it_saved, it_saved, static_cast<unsigned int>(iter)});
 			return -1;
 		}
+		if(checkpoint_every > 0 && (iter + 1)%checkpoint_every == 0)
+			write_checkpoint(iter);
+		if(live && (iter + 1)%flush_every == 0) //values saved so far become visible to the readers of the file
+			output.publish({it_saved, it_saved, static_cast<unsigned int>(iter + 1)});
 	}
-
-	H5Dclose(dataset_Beta);
-	H5Dclose(dataset_TauEps);
-	H5Dclose(dataset_Prec);
-	H5Dclose(dataset_Mu);
-	H5Dclose(dataset_info);
-	H5Dclose(dataset_version);
-	H5Fclose(file);
+	output.complete();
+	output.close();
 	return 0;
 }
 
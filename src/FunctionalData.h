@@ -0,0 +1,31 @@
+#ifndef __FUNCTIONALDATA_HPP__
+#define __FUNCTIONALDATA_HPP__
+
+#include "include_headers.h"
+
+/*
+	Quantities of the functional samplers, FGMsampler and FLMsampler, that depend only on the data and on the basis. They are computed once and the samplers
+	hold them through a shared pointer to const, so that the chains run by chains::run_chains() share a single copy and only read it.
+	The data themselves are not kept, the samplers only need their projection on the basis and the sum of their squared norms.
+*/
+
+struct FunctionalData{
+	using MatRow = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+	using MatCol = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+	//data is grid_pts x n, Basemat is grid_pts x p
+	FunctionalData(MatCol const & data, MatCol const & Basemat):grid_pts(data.rows()), n(data.cols()), tbase_base(Basemat.transpose()*Basemat),
+																tbase_data(Basemat.transpose()*data), Sdata(data.cwiseProduct(data).sum())
+	{
+		if(Basemat.rows() != data.rows())
+			throw std::runtime_error("Error, data and Basemat do not have the same number of grid points");
+	}
+	const unsigned int grid_pts;
+	const unsigned int n;
+	const MatRow tbase_base; //p x p
+	const MatCol tbase_data; //p x n
+	const double Sdata;		 //Sum_i(<yi, yi>) sum of the inner products of each data
+};
+
+using FunctionalDataPtr = std::shared_ptr<const FunctionalData>;
+
+#endif
@@ -34,6 +34,12 @@ enum class MoveType{
 	Add, Remove
 };
 
+//States how the ratio of GWishart normalizing constants of two graphs differing by one link is computed. 
+//MC uses the Monte Carlo estimate of both constants, Approx uses the closed form provided by GWishart::log_normalizing_constat_ratio()
+enum class ConstantRatio{
+	MC, Approx
+};
+
 template<template <typename> class GraphStructure = GraphType, typename T = unsigned int>
 class GGM : public GGMTraits<GraphStructure, T> {
 	
@@ -60,8 +66,10 @@ class GGM : public GGMTraits<GraphStructure, T> {
 				ptr_prior(std::move(_ptr_prior)),  Kprior( _b, _D ), trGwishSampler(_trGwishSampler) {}
 		GGM(PriorPtr& _ptr_prior,unsigned int const & _p, double const & _trGwishSampler): 
 				ptr_prior(std::move(_ptr_prior)), Kprior(_p), trGwishSampler(_trGwishSampler) {}
-		GGM(GGM & _ggm):
-				ptr_prior(_ggm.ptr_prior->clone()), Kprior(_ggm.Kprior), trGwishSampler(_ggm.trGwishSampler){}
+		GGM(GGM const & _ggm):
+				data_factorized(_ggm.data_factorized), ptr_prior(_ggm.ptr_prior->clone()), Kprior(_ggm.Kprior), trGwishSampler(_ggm.trGwishSampler), 
+				positions(_ggm.positions), selected_link(_ggm.selected_link), D_plus_U(_ggm.D_plus_U), chol_inv_DplusU(_ggm.chol_inv_DplusU), n_tries(_ggm.n_tries), proposed_pos(_ggm.proposed_pos), last_acceptance(_ggm.last_acceptance), beta(_ggm.beta),
+				adapt_scale(_ggm.adapt_scale), target_acceptance(_ggm.target_acceptance), n_adapted(_ggm.n_adapted){}
 		GGM(GGM &&) = default;
 
 		//Operators
@@ -82,6 +90,43 @@ class GGM : public GGMTraits<GraphStructure, T> {
 		MatCol get_inv_scale()const{
 			return Kprior.get_inv_scale();
 		}
+		//Setters
+		//Number of candidate links scored by the locally-informed multiple-try proposal. 0 or 1 means that propose_new_graph() is used
+		inline void set_n_tries(unsigned int const & _n_tries){
+			n_tries = _n_tries;
+		}
+		//Inverse temperature of the likelihood, used by parallel tempering. Raising the likelihood to beta is equivalent to use beta*U as data and beta*n 
+		//as number of observations, hence the posterior inverse scale matrix has to be factorized again
+		inline void set_inverse_temperature(double const & _beta){
+			beta = _beta;
+			data_factorized = false;
+		}
+		inline double get_inverse_temperature()const{
+			return beta;
+		}
+		//Robbins-Monro adaptation of the proposal scale. While it is active, algorithms having a proposal scale update it after every move so that
+		//the acceptance probability approaches target. Samplers activate it during burn-in only
+		inline void set_adaptation(bool const & _adapt_scale, double const & _target_acceptance = 0.234){
+			adapt_scale = _adapt_scale;
+			target_acceptance = _target_acceptance;
+		}
+		//Scale of the proposal of the free elements of the precision matrix. It is 0 for algorithms that do not have one
+		virtual double get_proposal_scale()const{
+			return 0.0;
+		}
+		virtual void set_proposal_scale(double const &){}
+		//Number of adaptation steps already performed. Saved by checkpoints together with the proposal scale, so that a resumed burn-in continues with the same step size
+		inline unsigned int get_n_adapted()const{
+			return n_adapted;
+		}
+		inline void set_n_adapted(unsigned int const & _n_adapted){
+			n_adapted = _n_adapted;
+		}
+		//Rao-Blackwellized estimate of the posterior probabilities of inclusion. Given Gold and the proposed link e, e belongs to the next graph with probability 
+		//equal to the acceptance probability if it was proposed for addition, one minus it if it was proposed for removal, the other links do not change.
+		//Adds weight times the expected adjacency list after the last move to plinks_adj. Gold and Gnew are the graphs before and after the move. 
+		//Algorithms that do not have an acceptance probability (BD) add the adjacency list of Gnew.
+		void add_expected_graph(std::vector<double> & plinks_adj, Graph const & Gold, Graph const & Gnew, double const & weight = 1.0)const;
 		//Initialize precision matrix
 		inline void init_precision(Graph & G, MatRow const & mat){
 			Kprior.set_matrix(G.completeview(), mat);
@@ -98,8 +143,48 @@ class GGM : public GGMTraits<GraphStructure, T> {
 		//This method takes the current graph (both form are accepted) and the probability of selecting an addition and return a tuple,
 		//with the proposed new graph, a double that is the (log) proposal ratio and the type of selected move
 		std::tuple<Graph, double, MoveType>  propose_new_graph(Graph & Gold, double alpha, sample::GSL_RNG const & engine = sample::GSL_RNG()); 
+		//Locally-informed multiple-try proposal. A set of n_tries candidate links is drawn uniformly and each candidate e is scored in parallel with the 
+		//balanced weight w_e(G) = sqrt( pi(G+-e|data)/pi(G|data) ), computed by log_posterior_ratio_approx(). The link to be changed is selected proportionally 
+		//to its weight. The reverse move uses the same candidates, hence the log proposal ratio is log(w_e(Gnew)/W(Gnew)) - log(w_e(Gold)/W(Gold)), 
+		//where W is the sum of the weights of all candidates. D_plus_U has to be already factorized.
+		std::tuple<Graph, double, MoveType>  propose_informed_graph(Graph & Gold, unsigned int const & n, sample::GSL_RNG const & engine = sample::GSL_RNG());
+		//Uses propose_informed_graph() if multiple tries are set, propose_new_graph() otherwise
+		inline std::tuple<Graph, double, MoveType> propose(Graph & Gold, double alpha, unsigned int const & n, sample::GSL_RNG const & engine = sample::GSL_RNG()){
+			if(n_tries > 1 && positions.size() > 1)
+				return propose_informed_graph(Gold, n, engine);
+			else
+				return propose_new_graph(Gold, alpha, engine);
+		}
+		
+		//Closed form approximation of log(I_Gnew(b,D)/I_Gold(b,D)) for the normalizing constants of GWishart K, where Gnew differs from Gold only for link. 
+		//In block graphs, link is a block link and the contributions of all the links in the changed block are summed up
+		double log_constant_ratio_approx(PrecisionType const & K, Graph const & Gnew, MoveType Move, std::pair<unsigned int, unsigned int> const & link)const;
+		//Same as before, the changed link is the one selected by the last call of propose_new_graph()
+		inline double log_constant_ratio_approx(PrecisionType const & K, Graph const & Gnew, MoveType Move)const{
+			return log_constant_ratio_approx(K, Gnew, Move, selected_link);
+		}
+		//Closed form approximation of log( pi(Gnew|data)/pi(G|data) ), where Gnew is obtained changing the link in position pos of G. Kpost is the posterior GWishart.
+		//Gnew is not built
+		double log_posterior_ratio_approx(Graph const & G, IdxType const & pos, PrecisionType const & Kpost)const;
+		//Same as before, link (given by pos_to_ij()) is added or removed according to Move
+		double log_posterior_ratio_approx(Graph const & G, std::pair<unsigned int, unsigned int> const & link, MoveType Move, PrecisionType const & Kpost)const;
+		//Waiting time of the current graph. Continuous time algorithms use it to weight the saved samples, it is always one for discrete time algorithms
+		virtual double get_waiting_time()const{
+			return 1.0;
+		}
+		//Continuous time algorithms can not be tempered, their jump chain is not invariant wrt the posterior
+		virtual bool is_continuous_time()const{
+			return false;
+		}
+		//Polymorphic copy, every replica of parallel tempering needs its own method
+		virtual std::unique_ptr<GGM> clone()const = 0;
 		
 		virtual ReturnType operator()(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, sample::GSL_RNG const & engine = sample::GSL_RNG()) = 0;
+		//Speculative execution of consecutive moves starting from Gold, the j-th move uses its own stream engines[j]. It returns the outcome of the performed moves, 
+		//that are all the ones up to the first accepted (included).
+		//This default version performs the moves sequentially, algorithms whose graph move does not depend on the current precision matrix evaluate them concurrently
+		virtual std::vector<ReturnType> speculative_moves(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, 
+														  std::deque<sample::GSL_RNG> const & engines);
 		virtual ~GGM() = default;
 
 		bool data_factorized = false;
@@ -111,7 +196,15 @@ class GGM : public GGMTraits<GraphStructure, T> {
 		std::pair<unsigned int, unsigned int> selected_link; 
 		MatCol D_plus_U;
 		MatCol chol_inv_DplusU;
-		
+		unsigned int n_tries{0};
+		IdxType proposed_pos{0}; //position in the adjacency list of the link changed by the last proposal
+		double last_acceptance{-1.0}; //acceptance probability of the last move, negative if the algorithm does not have one
+		double beta{1.0}; //inverse temperature, 1 means no tempering
+		bool adapt_scale{false};
+		double target_acceptance{0.234};
+		unsigned int n_adapted{0}; //number of adaptation steps already performed, it defines the Robbins-Monro step size
+		//Returns the graph obtained by adding or removing the link in position pos of G and the type of move
+		std::pair<Graph, MoveType> change_link(Graph const & G, IdxType const & pos)const;
 };
 
 
@@ -169,6 +262,7 @@ GGM<GraphStructure, T>::propose_new_graph(typename GGMTraits<GraphStructure, T>:
 			
 			unsigned int selected{zeros[rand_int(engine, zeros.size())]};
 			adj_list[selected] = 1; //set value in ad_list to true, i.e create a link
+			proposed_pos = selected;
 			selected_link = Gold.pos_to_ij(selected);
 			if constexpr(internal_type_traits::isCompleteGraph<GraphStructure,T>::value){
 				return std::make_tuple( Graph (adj_list),  log_proposal_Graph, Move );
@@ -199,6 +293,7 @@ GGM<GraphStructure, T>::propose_new_graph(typename GGMTraits<GraphStructure, T>:
 
 		unsigned int selected{ones[rand_int(engine, ones.size())]};
 		adj_list[selected] = 0; //set value in ad_list to true, i.e create a link
+		proposed_pos = selected;
 		selected_link = Gold.pos_to_ij(selected);
 		if constexpr(internal_type_traits::isCompleteGraph<GraphStructure,T>::value){
 			return std::make_tuple( Graph (adj_list), log_proposal_Graph, Move );
@@ -210,6 +305,125 @@ GGM<GraphStructure, T>::propose_new_graph(typename GGMTraits<GraphStructure, T>:
 }
 
 
+template<template <typename> class GraphStructure, typename T>
+double GGM<GraphStructure, T>::log_constant_ratio_approx(PrecisionType const & K, typename GGMTraits<GraphStructure, T>::Graph const & Gnew, MoveType Move, 
+														  std::pair<unsigned int, unsigned int> const & link)const{
+	
+	double res{0};
+	if constexpr(internal_type_traits::isCompleteGraph<GraphStructure,T>::value){
+		res = K.log_normalizing_constat_ratio(link.first, link.second);
+	}
+	else{
+		const std::vector< std::pair<unsigned int, unsigned int> > L(Gnew.map_to_complete(link.first, link.second));
+		for(auto const & link : L){
+			if(link.first != link.second)
+				res += K.log_normalizing_constat_ratio(link.first, link.second);
+		}
+	}
+	//Ratio is I_{G+e}/I_G, it has to be inverted when removing
+	return (Move == MoveType::Add) ? res : -res;
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+std::vector<typename GGMTraits<GraphStructure, T>::ReturnType>
+GGM<GraphStructure, T>::speculative_moves(MatCol const & data, unsigned int const & n, typename GGMTraits<GraphStructure, T>::Graph & Gold, double alpha, 
+										  std::deque<sample::GSL_RNG> const & engines){
+	std::vector<ReturnType> res;
+	for(auto const & eng : engines){
+		res.push_back( (*this)(data, n, Gold, alpha, eng) );
+		if(std::get<1>(res.back()) == 1)
+			break;
+	}
+	return res;
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+void GGM<GraphStructure, T>::add_expected_graph(std::vector<double> & plinks_adj, typename GGMTraits<GraphStructure, T>::Graph const & Gold, 
+												typename GGMTraits<GraphStructure, T>::Graph const & Gnew, double const & weight)const{
+	
+	const Graph & G = (last_acceptance < 0) ? Gnew : Gold;
+	const std::vector<T> adj(G.get_adj_list());
+	for(IdxType j = 0; j < adj.size(); ++j)
+		plinks_adj[j] += weight*static_cast<double>(adj[j]);
+	if(last_acceptance >= 0)
+		plinks_adj[proposed_pos] += (adj[proposed_pos]) ? -weight*last_acceptance : weight*last_acceptance;
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+std::pair< typename GGMTraits<GraphStructure, T>::Graph, MoveType>
+GGM<GraphStructure, T>::change_link(typename GGMTraits<GraphStructure, T>::Graph const & G, IdxType const & pos)const{
+
+	using Graph = GraphStructure<T>;
+	std::vector<unsigned int> adj_list(G.get_adj_list());
+	const MoveType Move = (adj_list[pos] == 0) ? MoveType::Add : MoveType::Remove;
+	adj_list[pos] = (Move == MoveType::Add) ? 1 : 0;
+	if constexpr(internal_type_traits::isCompleteGraph<GraphStructure,T>::value)
+		return std::make_pair( Graph (adj_list), Move );
+	else
+		return std::make_pair( Graph (adj_list, G.get_ptr_groups()), Move );
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+double GGM<GraphStructure, T>::log_posterior_ratio_approx(typename GGMTraits<GraphStructure, T>::Graph const & G, IdxType const & pos, PrecisionType const & Kpost)const{
+	
+	const std::pair<unsigned int, unsigned int> link(G.pos_to_ij(pos));
+	return log_posterior_ratio_approx(G, link, (G(link.first, link.second) == 0) ? MoveType::Add : MoveType::Remove, Kpost);
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+double GGM<GraphStructure, T>::log_posterior_ratio_approx(typename GGMTraits<GraphStructure, T>::Graph const & G, std::pair<unsigned int, unsigned int> const & link, 
+														  MoveType Move, PrecisionType const & Kpost)const{
+	//The closed form only depends on the groups of the graph, G can be used in place of the new graph
+	return ptr_prior->log_ratio_link(G, link, Move == MoveType::Add) + log_constant_ratio_approx(Kpost, G, Move, link) - log_constant_ratio_approx(Kprior, G, Move, link);
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+std::tuple< typename GGMTraits<GraphStructure, T>::Graph, double, MoveType> 
+GGM<GraphStructure, T>::propose_informed_graph(typename GGMTraits<GraphStructure, T>::Graph & Gold, unsigned int const & n, sample::GSL_RNG const & engine ){
+
+	sample::runif rand;
+	sample::runif_int rand_int;
+	PrecisionType Kpost(Kprior.get_shape() + beta*n , D_plus_U, chol_inv_DplusU );
+
+	//1) Draw the candidates uniformly without replacement (partial Fisher-Yates shuffle). They do not depend on Gold, the reverse move can use the same ones
+	const IdxType n_candidates( std::min(static_cast<IdxType>(n_tries), positions.size()) );
+	std::vector<unsigned int> candidates(positions);
+	for(IdxType i = 0; i < n_candidates; ++i)
+		std::swap(candidates[i], candidates[i + rand_int(engine, candidates.size() - i)]);
+	candidates.resize(n_candidates);
+
+	//2) Score the candidates wrt Gold and select one of them proportionally to its weight
+	std::vector<double> log_w_old(n_candidates);
+	#pragma omp parallel for shared(log_w_old)
+	for(IdxType i = 0; i < n_candidates; ++i)
+		log_w_old[i] = 0.5*log_posterior_ratio_approx(Gold, candidates[i], Kpost);
+	const double log_W_old(utils::logSumExp(log_w_old));
+	const double u(rand(engine));
+	double cumulative_w{0};
+	IdxType selected{0};
+	for(; selected < n_candidates - 1; ++selected){
+		cumulative_w += std::exp(log_w_old[selected] - log_W_old);
+		if(u < cumulative_w)
+			break;
+	}
+	auto [Gnew, Move] = change_link(Gold, candidates[selected]);
+	selected_link = Gold.pos_to_ij(candidates[selected]);
+	proposed_pos = candidates[selected];
+
+	//3) Score the same candidates wrt Gnew, they give the probability of the reverse move
+	std::vector<double> log_w_new(n_candidates);
+	#pragma omp parallel for shared(log_w_new)
+	for(IdxType i = 0; i < n_candidates; ++i)
+		log_w_new[i] = 0.5*log_posterior_ratio_approx(Gnew, candidates[i], Kpost);
+	const double log_proposal_Graph = (log_w_new[selected] - utils::logSumExp(log_w_new)) - (log_w_old[selected] - log_W_old);
+	return std::make_tuple( std::move(Gnew), log_proposal_Graph, Move );
+}
 
 
 #endif
\ No newline at end of file
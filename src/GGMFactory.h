@@ -5,20 +5,22 @@
 #include "AddRemoveMH.h"
 #include "RJMH.h"
 #include "DRJMH.h"
+#include "BDMCMC.h"
 
 
 enum class GGMAlgorithm{
 	MH,
 	RJ,
-	DRJ
+	DRJ,
+	BD
 };
 
 template< GGMAlgorithm algo = GGMAlgorithm::MH, 
 		  template <typename> class GraphStructure = GraphType, typename T = unsigned int , typename... Args  >
 std::unique_ptr< GGM<GraphStructure, T> > Create_GGM(Args&&... args){
 
-	static_assert(algo == GGMAlgorithm::MH || algo == GGMAlgorithm::RJ || algo == GGMAlgorithm::DRJ,
-			      "Error, only possible algorithms are MH, RJ and DRJ");
+	static_assert(algo == GGMAlgorithm::MH || algo == GGMAlgorithm::RJ || algo == GGMAlgorithm::DRJ || algo == GGMAlgorithm::BD,
+			      "Error, only possible algorithms are MH, RJ, DRJ and BD");
 	static_assert(std::is_same_v<bool, T> || std::is_same_v<int, T>  || std::is_same_v<unsigned int, T>,
 				  "Error, the only type available for the graphs with are bool, unsigned int and int .");	
 	if constexpr(algo == GGMAlgorithm::MH)
@@ -27,6 +29,8 @@ std::unique_ptr< GGM<GraphStructure, T> > Create_GGM(Args&&... args){
 		return std::make_unique< ReversibleJumpsMH<GraphStructure, T> >(std::forward<Args>(args)...);
 	else if constexpr(algo == GGMAlgorithm::DRJ)
 		return std::make_unique< DoubleReversibleJumpsMH<GraphStructure, T> > (std::forward<Args>(args)...);
+	else if constexpr(algo == GGMAlgorithm::BD)
+		return std::make_unique< BirthDeathMCMC<GraphStructure, T> > (std::forward<Args>(args)...);
 
 }
 
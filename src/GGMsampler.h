@@ -27,6 +27,10 @@ class GGMsampler : public SamplerTraits
 	 	file_name += ".h5";
 	} 
 	int run();
+	//Used when more than one chain is run concurrently
+	void set_control(ChainControl const & _control){
+		control = _control;
+	}
 
 	private:
 	void check();
@@ -43,6 +47,7 @@ class GGMsampler : public SamplerTraits
 	int visited{0};
 	bool print_bp;
 	std::string file_name;
+	ChainControl control;
 
 };
 
@@ -67,7 +72,7 @@ int GGMsampler<GraphStructure, T >::run()
 	// Declare all parameters (makes use of C++17 structured bindings)
 	const unsigned int & r = grid_pts;
 	const double&  p_addrm   = this->hy_params.p_addrm; 
-	const auto &[niter, nburn, thin, thinG, MCiterPrior, MCiterPost, Basemat, ptr_groups, iter_to_store, iter_to_storeG, threshold] = this->params;
+	const auto &[niter, nburn, thin, thinG, MCiterPrior, MCiterPost, Basemat, ptr_groups, iter_to_store, iter_to_storeG, threshold, n_speculative, n_replicas, max_temperature, swap_every, adapt_sigma, target_acceptance, store_chain, lower_qtl, upper_qtl, target_ess, target_rhat, check_every, report_diagnostics, checkpoint_every, resume, keyframe_every, sketch_capacity, chain_format, flush_every] = this->params;
 	MatRow K = init.K0; 
 	Graph  G = init.G0;
 	GGM_method.init_precision(G,K); 
@@ -90,109 +95,255 @@ int GGMsampler<GraphStructure, T >::run()
 	//Define all those quantities that can be compute once
 	const MatRow Irow(MatRow::Identity(p,p));
 						
-	//Open file
-	HDF5conversion::FileType file;
-	file = H5Fcreate(file_name.data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-	if(file < 0)
-		throw std::runtime_error("Cannot create the file. The most probable reason is that the execution was stopped before closing a file having the same name of the one that was asked to be generated. Delete the old file or change the name of the new one");
-	int one_dim_rank = 1;//for 1-dim datasets. All other quantities
-	
-	//Print info file
-	HDF5conversion::DataspaceType dataspace_info;
-	HDF5conversion::ScalarType Dim_info = 4;
-	dataspace_info = H5Screate_simple(one_dim_rank, &Dim_info, NULL);
-	HDF5conversion::DatasetType  dataset_info;
-	dataset_info  = H5Dcreate(file,"/Info", H5T_NATIVE_UINT, dataspace_info, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_info < 0)
-		throw std::runtime_error("Error, can not create dataset for Info ");
-	{
-		std::vector< unsigned int > info{p,n,iter_to_store,iter_to_store};
-		unsigned int * buffer_info = info.data();		
-		HDF5conversion::StatusType status = H5Dwrite(dataset_info, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer_info);
+	//Rao-Blackwellized probabilities of inclusion, see GGM::add_expected_graph(). Moves evaluated speculatively or by tempered replicas do not expose 
+	//their acceptance probability, the visited graph is used in that case
+	std::vector<double> plinks_rb(n_graph_elem, 0.0);
+	double rb_normalization{0};
+	//Sketch of the saved graphs, it tracks the most visited ones with bounded memory. Probabilities of inclusion of the saved graphs are exact, they are 
+	//accumulated link by link. See HDF5conversion::GraphSketch
+	HDF5conversion::GraphSketch sketch(n_graph_elem, sketch_capacity);
+	std::vector<double> plinks_sketch(n_graph_elem, 0.0);
+	double sketch_normalization{0};
+	//Online summaries of the saved precision matrices, weighted by their waiting times
+	summaries::OnlineSummary summary_K(prec_elem, lower_qtl, upper_qtl);
+	//Convergence diagnostics of the graph size and of the log-likelihood, see ChainControl::converged(). They are computed only if they are used, to stop
+	//the sampling early or to be reported at the end, since the log-likelihood requires a determinant at every iteration
+	const bool track_diagnostics{target_ess > 0 || report_diagnostics};
+	std::vector<diagnostics::BatchMeans> series(2);
+	//A checkpoint can be resumed only by a sampler that writes the same datasets
+	const std::vector<double> checkpoint_settings{static_cast<double>(niter), static_cast<double>(nburn), static_cast<double>(thin), static_cast<double>(thinG), static_cast<double>(store_chain), static_cast<double>(keyframe_every), static_cast<double>(sketch_capacity), static_cast<double>(track_diagnostics)};
+	int iter_start{0};
+						
+	//Open file, it is closed even if the sampling throws. In live mode it is written in SWMR mode, so that it can be read while sampling. See HDF5conversion::SamplerOutput
+	const bool live(flush_every > 0);
+	HDF5conversion::SamplerOutput output(file_name, "GGMsampler", {p,n,iter_to_store,iter_to_store,static_cast<unsigned int>(niter)}, chain_format, live, resume, 
+										 checkpoint_every > 0); //the last entry of info is the number of performed iterations
+
+	//Restore the state saved by the last checkpoint, the seed of the engine is restored too so that speculative streams are the same
+	if(resume){
+		auto [state, rng_state] = output.read_checkpoint();
+		if(HDF5conversion::CheckpointEntry(state, "Settings") != checkpoint_settings)
+			throw std::runtime_error("Error, the sampling can be resumed only with the same niter, burnin, thin, thinG, store_chain, keyframe_every and sketch_capacity of the interrupted one");
+		const std::vector<double> & counters = HDF5conversion::CheckpointEntry(state, "Counters", 4);
+		iter_start 		 = static_cast<int>(counters[0]);
+		it_saved 		 = static_cast<unsigned int>(counters[1]);
+		total_accepted 	 = static_cast<int>(counters[2]);
+		rb_normalization = counters[3];
+		engine.set_seed(static_cast<unsigned int>(HDF5conversion::CheckpointEntry(state, "Seed", 1)[0]));
+		engine.set_state(rng_state);
+		G = graph_from_checkpoint(HDF5conversion::CheckpointEntry(state, "Graph", n_graph_elem), G);
+		K = Eigen::Map<const MatRow>(HDF5conversion::CheckpointEntry(state, "Precision", p*p).data(), p, p);
+		GGM_method.init_precision(G,K);
+		const std::vector<double> & scale = HDF5conversion::CheckpointEntry(state, "ProposalScale", 2);
+		if(scale[0] > 0)
+			GGM_method.set_proposal_scale(scale[0]);
+		GGM_method.set_n_adapted(static_cast<unsigned int>(scale[1]));
+		plinks_rb = HDF5conversion::CheckpointEntry(state, "PlinksRB", n_graph_elem);
+		if(sketch_capacity > 0){
+			sketch.set_state(HDF5conversion::CheckpointEntry(state, "Sketch"));
+			plinks_sketch = HDF5conversion::CheckpointEntry(state, "SketchLinks", n_graph_elem + 1);
+			sketch_normalization = plinks_sketch.back();
+			plinks_sketch.pop_back();
+		}
+		summary_K.set_state(HDF5conversion::CheckpointEntry(state, "SummaryPrecision"));
+		for(unsigned int s = 0; s < series.size(); ++s)
+			series[s].set_state(HDF5conversion::CheckpointEntry(state, "Series" + std::to_string(s)));
+		if(print_bp && control.is_main())
+			Rcpp::Rcout<<"Sampling resumed from iteration "<<iter_start<<std::endl;
 	}
-	//Print what sampler has been used
-	HDF5conversion::DatasetType  dataset_version;
-	HDF5conversion::DataspaceType dataspace_version = H5Screate(H5S_NULL);
-	dataset_version = H5Dcreate(file, "/Sampler", H5T_STD_I32LE, dataspace_version, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_version < 0)
-		throw std::runtime_error("Error, can not create dataset for Sampler");
-	HDF5conversion::WriteString(dataset_version, "GGMsampler");
-	//Create dataspaces
-	HDF5conversion::DataspaceType dataspace_Prec, dataspace_Graph;
-	HDF5conversion::ScalarType Dim_K_ds = prec_elem*iter_to_store;
-	HDF5conversion::ScalarType Dim_G_ds = n_graph_elem*iter_to_store;
-
-	dataspace_Prec  = H5Screate_simple(one_dim_rank, &Dim_K_ds, NULL);
-	dataspace_Graph = H5Screate_simple(one_dim_rank, &Dim_G_ds, NULL);
-
-	//Create dataset
-	HDF5conversion::DatasetType  dataset_Prec, dataset_Graph;
-	dataset_Prec = H5Dcreate(file,"/Precision", H5T_NATIVE_DOUBLE, dataspace_Prec, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Prec < 0)
-		throw std::runtime_error("Error, can not create dataset for Precision");
-	dataset_Graph = H5Dcreate(file,"/Graphs", H5T_NATIVE_UINT, dataspace_Graph, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	if(dataset_Graph < 0)
-		throw std::runtime_error("Error, can not create dataset for Graphs");
-	
+	if(keyframe_every > 0) //only the changed links are saved, instead of the chain of the graphs
+		output.add_graph_log(n_graph_elem, iter_to_store, keyframe_every, it_saved);
+	//Chains are created, or reopened if resumed, and written in batches starting from the first value that was not saved yet. See HDF5conversion::ChainWriter
+	unsigned int id_Prec{0}, id_Graph{0};
+	if(store_chain) //otherwise only the online summary of the precision matrix is saved
+		id_Prec = output.add_chain("/Precision", H5T_NATIVE_DOUBLE, prec_elem, iter_to_store, it_saved);
+	if(keyframe_every == 0)
+		id_Graph = output.add_chain("/Graphs", H5T_NATIVE_UCHAR, HDF5conversion::PackedSize(n_graph_elem), iter_to_store, it_saved);
+	//Waiting times of saved graphs. They are all equal to one for discrete time algorithms
+	const unsigned int id_Weights = output.add_chain("/Weights", H5T_NATIVE_DOUBLE, 1, iter_to_store, it_saved);
+	output.start();
 
 	//Setup for progress bar, need to specify the total number of iterations
 	pBar bar(niter);
+	bar.update(iter_start);
+	//Speculative execution, every iteration has its own stream generated from the seed of the main engine
+	const unsigned int base_seed(engine.get_seed());
+	//Adaptation of the proposal scale is active during burn-in only. Replicas inherit it from GGM_method
+	bool adapting(adapt_sigma && nburn > 0);
+	GGM_method.set_adaptation(adapting, target_acceptance);
+	//Parallel tempering, replicas are copies of the initialized method. Speculative execution is not used in this case.
+	//After a resume all replicas restart from the state of the cold chain
+	std::unique_ptr<ParallelTempering<GraphStructure, T>> replicas;
+	if(n_replicas > 1)
+		replicas = std::make_unique<ParallelTempering<GraphStructure, T>>(GGM_method, G, K, n_replicas, max_temperature, swap_every, 
+																		  (resume) ? sample::stream_seed(base_seed, iter_start) : base_seed);
+	const bool exact_rb(!replicas && n_speculative <= 1);
+	unsigned int n_checks{0};
+	bool converged{false};
+	int iter_done{niter};
+	//Saves the state reached after iteration iter, the sampling is resumed from the next one
+	auto write_checkpoint = [&](int const & iter, Graph const & G_iter){
+		const std::vector<T> adj_iter(G_iter.get_adj_list());
+		const double scale{(replicas) ? replicas->get_proposal_scale() : GGM_method.get_proposal_scale()};
+		HDF5conversion::CheckpointType state{
+			{"Settings", checkpoint_settings},
+			{"Counters", {static_cast<double>(iter + 1), static_cast<double>(it_saved), static_cast<double>(total_accepted), rb_normalization}},
+			{"Seed", {static_cast<double>(base_seed)}},
+			{"Graph", std::vector<double>(adj_iter.cbegin(), adj_iter.cend())},
+			{"Precision", std::vector<double>(K.data(), K.data() + K.size())},
+			{"ProposalScale", {scale, static_cast<double>(GGM_method.get_n_adapted())}},
+			{"PlinksRB", plinks_rb},
+			{"SummaryPrecision", summary_K.get_state()}
+		};
+		for(unsigned int s = 0; s < series.size(); ++s)
+			state["Series" + std::to_string(s)] = series[s].get_state();
+		if(sketch_capacity > 0){
+			state["Sketch"] = sketch.get_state();
+			state["SketchLinks"] = plinks_sketch;
+			state["SketchLinks"].push_back(sketch_normalization);
+		}
+		output.write_checkpoint(state, engine.get_state());
+	};
 	 
 	//Start MCMC loop
-	for(int iter = 0; iter < niter; iter++){
+	for(int iter = iter_start; iter < niter && !converged; ){
 		
-		//Show progress bar
-		bar.update(1);
-		if(print_bp){
-			bar.print(); 
+		//Freeze the proposal scale at the end of burn-in
+		if(adapting && iter >= nburn){
+			adapting = false;
+			if(replicas)
+				replicas->set_adaptation(false);
+			else
+				GGM_method.set_adaptation(false);
 		}
-
-		int accepted_mv{0};
-
-		//Graphical Step
-		std::tie(K, accepted_mv) = GGM_method(data, n, G, p_addrm, engine); //G is modified inside the function.
-		total_accepted += accepted_mv;
-
-		//Check for User interruption
-		try{
-			Rcpp::checkUserInterrupt();
+		//Graphical Step. With speculative execution, more than one iteration may be performed. 
+		//The graph of all of them but the last is G_start, since they were refused
+		const Graph G_start(G);
+		std::vector<typename GGMTraits<GraphStructure, T>::ReturnType> moves;
+		if(replicas)
+			moves.push_back((*replicas)(data, n, G, p_addrm, iter)); //G is set equal to the graph of the cold chain
+		else if(n_speculative > 1){
+			std::deque<sample::GSL_RNG> engines;
+			for(int j = iter; j < std::min(iter + (int)n_speculative, (adapting) ? nburn : niter); ++j) //adapted moves do not go beyond burn-in
+				engines.emplace_back(sample::stream_seed(base_seed, j));
+			moves = GGM_method.speculative_moves(data, n, G, p_addrm, engines); //G is modified inside the function.
 		}
-		catch(Rcpp::internal::InterruptedException e){ //Close all files before leaving
-			Rcpp::Rcout<<"Execution stopped during iter "<<iter<<"/"<<niter<<std::endl;
-			H5Dclose(dataset_Graph);
-			H5Dclose(dataset_Prec);
-			H5Dclose(dataset_info);
-			H5Dclose(dataset_version);
-			H5Fclose(file);
-			return -1;
-		}
-
-		//Save
-		if(iter >= nburn){
-			if((iter - nburn)%thinG == 0 && it_saved < iter_to_store ){ 
+		else
+			moves.push_back(GGM_method(data, n, G, p_addrm, engine)); //G is modified inside the function.
 
-			//Save on file
-			std::vector<unsigned int> adj_file;
-			if constexpr( ! std::is_same_v<T, unsigned int>){
-				std::vector<T> adj_nouint(G.get_adj_list());
-				adj_file.resize(adj_nouint.size());
-				std::transform(adj_nouint.begin(), adj_nouint.end(), adj_file.begin(), [](T x) { return (unsigned int)x;});
+		for(unsigned int m = 0; m < moves.size(); ++m, ++iter){
+			//Show progress bar
+			bar.update(1);
+			if(print_bp && control.is_main()){
+				bar.print(); 
 			}
-			else{
-				adj_file = G.get_adj_list();
+			int accepted_mv{0};
+			std::tie(K, accepted_mv) = moves[m];
+			total_accepted += accepted_mv;
+			const Graph & G_iter = (m == moves.size() - 1) ? G : G_start;
+
+			//Check for User interruption
+			if(control.interrupted()){ //Close all files before leaving
+				if(control.is_main())
+					Rcpp::Rcout<<"Execution stopped during iter "<<iter<<"/"<<niter<<std::endl;
+				output.interrupt({it_saved, it_saved, static_cast<unsigned int>(iter)});
+				return -1;
 			}
-			VecCol UpperK{utils::get_upper_part(K)};
-			HDF5conversion::AddVector(dataset_Prec, UpperK, it_saved);	
-			HDF5conversion::AddUintVector(dataset_Graph, adj_file, it_saved);
-			it_saved++;
+
+			//Save
+			if(iter >= nburn){
+				//Rao-Blackwellized probabilities of inclusion use all iterations after burn-in
+				const double rb_weight{(replicas) ? replicas->get_waiting_time() : GGM_method.get_waiting_time()};
+				if(exact_rb)
+					GGM_method.add_expected_graph(plinks_rb, G_start, G, rb_weight);
+				else{
+					const std::vector<T> adj_iter(G_iter.get_adj_list());
+					for(unsigned int j = 0; j < n_graph_elem; ++j)
+						plinks_rb[j] += rb_weight*static_cast<double>(adj_iter[j]);
+				}
+				rb_normalization += rb_weight;
+				if((iter - nburn)%thinG == 0 && it_saved < iter_to_store ){ 
+
+				//Save on file
+				std::vector<unsigned char> packed_G(HDF5conversion::PackGraph(G_iter.get_adj_list())); //one bit per link
+				VecCol UpperK{utils::get_upper_part(K)};
+				double waiting_time{(replicas) ? replicas->get_waiting_time() : GGM_method.get_waiting_time()};
+				summary_K.update(UpperK, waiting_time);
+				if(store_chain)
+					output.push(id_Prec, UpperK.data(), it_saved);
+				if(keyframe_every > 0)
+					output.push_graph(packed_G, it_saved);
+				else
+					output.push(id_Graph, packed_G.data(), it_saved);
+				output.push(id_Weights, &waiting_time, it_saved);
+				if(sketch_capacity > 0){
+					sketch.add(packed_G);
+					for(unsigned int j = 0; j < n_graph_elem; ++j)
+						if((packed_G[j/8] >> (j%8)) & 1u)
+							plinks_sketch[j] += waiting_time;
+					sketch_normalization += waiting_time;
+				}
+				it_saved++;
+				}
+				//Convergence diagnostics
+				if(track_diagnostics){
+					series[0].update(G_iter.get_n_links());
+					series[1].update(utils::log_likelihood_GGM(K, data, n));
+					if((iter - nburn + 1)%check_every == 0 && control.converged(n_checks++, series, target_ess, target_rhat)){
+						converged = true;
+						iter_done = iter + 1;
+						break;
+					}
+				}
 			}
+			if(checkpoint_every > 0 && (iter + 1)%checkpoint_every == 0)
+				write_checkpoint(iter, G_iter);
+			if(live && (iter + 1)%flush_every == 0) //values saved so far become visible to the readers of the file
+				output.publish({it_saved, it_saved, static_cast<unsigned int>(iter + 1)});
+		}
+	}
+	if(converged && print_bp && control.is_main())
+		Rcpp::Rcout<<std::endl<<"Target effective sample size reached, sampling stopped after "<<iter_done<<" iterations"<<std::endl;
+	if(print_bp && control.is_main() && n_checks > 0){
+		auto [ess, rhat] = control.get_diagnostics();
+		Rcpp::Rcout<<std::endl<<"Effective sample size (graph size, log-likelihood): "<<ess[0]<<", "<<ess[1]<<std::endl;
+		Rcpp::Rcout<<"Split-Rhat (graph size, log-likelihood): "<<rhat[0]<<", "<<rhat[1]<<std::endl;
+	}
+	if(replicas && print_bp && control.is_main()){
+		Rcpp::Rcout<<std::endl<<"Swap acceptance rates between adjacent temperatures:";
+		for(auto const & rate : replicas->get_swap_rates())
+			Rcpp::Rcout<<" "<<rate;
+		Rcpp::Rcout<<std::endl;
+	}
+	const double tuned_sigma{(replicas) ? replicas->get_proposal_scale() : GGM_method.get_proposal_scale()}; //0 if the algorithm has no proposal scale
+	if(adapt_sigma && tuned_sigma > 0 && print_bp && control.is_main())
+		Rcpp::Rcout<<std::endl<<"Tuned sigmaG = "<<tuned_sigma<<std::endl;
+	//Update the number of saved and performed iterations, they are smaller than expected if the sampling stopped early
+	output.complete({p,n,it_saved,it_saved,static_cast<unsigned int>(iter_done)});
+	HDF5conversion::FileType & file = output.get_file();
+	if(adapt_sigma && tuned_sigma > 0) //Save the tuned proposal scale
+		HDF5conversion::WriteScalarDataset(file, "/SigmaG", tuned_sigma);
+	if(rb_normalization > 0)
+		HDF5conversion::WriteMatrixDataset(file, "/PlinksRB", utils::plinks_from_adj(plinks_rb, rb_normalization, ptr_groups));
+	if(sketch_capacity > 0){
+		HDF5conversion::WriteGraphSketch(file, sketch);
+		if(sketch_normalization > 0)
+			HDF5conversion::WriteMatrixDataset(file, "/SketchPlinks", utils::plinks_from_adj(plinks_sketch, sketch_normalization, ptr_groups));
+	}
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryPrecision", summary_K.get_summary());
+	MatRow qtl_levels(1,2);
+	qtl_levels << lower_qtl, upper_qtl;
+	HDF5conversion::WriteMatrixDataset(file, "/SummaryQuantiles", qtl_levels);
+	//Diagnostics of this chain only. Columns are graph size and log-likelihood, rows are effective sample size and split-Rhat
+	if(track_diagnostics){
+		MatRow chain_diagnostics(2,2);
+		for(unsigned int s = 0; s < series.size(); ++s){
+			chain_diagnostics(0,s) = series[s].ess();
+			chain_diagnostics(1,s) = diagnostics::split_rhat({&series[s]});
 		}
+		HDF5conversion::WriteMatrixDataset(file, "/Diagnostics", chain_diagnostics);
 	}
-	H5Dclose(dataset_Graph);
-	H5Dclose(dataset_Prec);
-	H5Dclose(dataset_info);
-	H5Dclose(dataset_version);
-	H5Fclose(file);
+	output.close();
 
 
 	return total_accepted;
@@ -8,6 +8,7 @@
 #include <gsl/gsl_cdf.h> 	 //For cumulative density functions
 #include <gsl/gsl_bspline.h> //For spline operations
 #include <gsl/gsl_linalg.h> //For cholesky decomposition
+#include <cstring>
 
 //Important note:
 // rmvnorm_prec / rmvnorm / rwish_old / rwish functions access directly to data() buffer of eigen matrix. This implies that the matrix passed as input
@@ -81,11 +82,30 @@ namespace sample{
 			inline unsigned int get_seed() const{
 				return seed;
 			}
+			//Internal state of the generator. Restoring it with set_state() continues the same stream of random numbers, it is used to resume a sampling
+			std::vector<unsigned char> get_state() const{
+				const unsigned char * state = static_cast<const unsigned char *>(gsl_rng_state(r));
+				return std::vector<unsigned char>(state, state + gsl_rng_size(r));
+			}
+			void set_state(std::vector<unsigned char> const & state){
+				if(state.size() != gsl_rng_size(r))
+					throw std::runtime_error("Error, the saved state does not match the type of the random engine");
+				std::memcpy(gsl_rng_state(r), state.data(), state.size());
+			}
 		private:
 			gsl_rng * r; 
 			unsigned int seed;
 	};
 
+	//Seed of the stream used by iteration iter, it only depends on the seed of the main engine. It is used when each iteration needs its own 
+	//independent stream, for example in speculative execution of graph moves. Never returns 0, that would ask GSL_RNG for a random seed
+	inline unsigned int stream_seed(unsigned int const & seed, unsigned int const & iter){
+		std::seed_seq seq = {seed, iter};
+		std::vector<unsigned int> seeds(1);
+		seq.generate(seeds.begin(), seeds.end());
+		return (seeds[0] == 0) ? 1 : seeds[0];
+	}
+
 	struct runif
 	{
 		double operator()(GSL_RNG const & engine)const{
@@ -18,6 +18,8 @@ struct GWishartTraits{
 	using CholTypeCol = Eigen::LLT<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>, Eigen::Lower>;
 	using ColType     = Eigen::Matrix<double, Eigen::Dynamic, 1>;
 	using RowType     = Eigen::Matrix<double, 1, Eigen::Dynamic>;
+	//Number of independent streams used by the MC estimate of the normalizing constant. It is fixed so that the estimate does not depend on the number of threads
+	static constexpr unsigned int MC_chunks = 32;
 };
 
 /*
@@ -248,7 +250,18 @@ class GWishart : public GWishartTraits{
 			return true;	
 		}
 		template<template <typename> class CompleteStructure = GraphType, typename Type = unsigned int>
-		long double log_normalizing_constat(const CompleteStructure<Type> & G, unsigned int const & MCiteration = 100, sample::GSL_RNG const & engine = sample::GSL_RNG() ); 
+		long double log_normalizing_constat(const CompleteStructure<Type> & G, unsigned int const & MCiteration = 100, sample::GSL_RNG const & engine = sample::GSL_RNG() );
+		//Closed form approximation of log( I_{G+e}(b,D)/I_G(b,D) ) where G+e is obtained by adding link e = (i,j) to G. Only b and the entries of D related to i and j are involved,
+		//the result is exact when G has only vertices i and j and it does not depend on the rest of the graph.
+		inline double log_normalizing_constat_ratio(unsigned int const & i, unsigned int const & j)const{
+			const double Dii(D(i,i));
+			const double Djj(D(j,j));
+			const double Dij(D(i,j));
+			return ( 	utils::log_2 + 0.5*utils::log_pi +
+						std::lgamma(0.5*(b+1)) - std::lgamma(0.5*b) +
+						0.5*b*( std::log(Dii) + std::log(Djj) ) -
+						0.5*(b+1)*std::log(Dii*Djj - Dij*Dij) );
+		}
 		//Public member stating if the matrix is factorized or not, i.e if U is such that data=U.transpose()*U
 		bool 		isFactorized;
 	private:
@@ -323,20 +336,22 @@ long double GWishart::log_normalizing_constat(const CompleteStructure<Type> & G,
 		for(unsigned int j = 0; j < N ; ++j)
 			H.col(j) = T.col(j) / T(j,j);
 
-		std::vector<double> vec_ss_nonfree;
-		std::vector<double> vec_ss_nonfree_result; //useful for parallel case, does not harm in sequential case (no unuseful copies are done)
-		
-
-		#pragma omp parallel private(vec_ss_nonfree),shared(vec_ss_nonfree_result)
-		{
-			int n_threads{1};
-			#ifdef PARALLELEXEC
-				n_threads = omp_get_num_threads();
-			#endif
-			vec_ss_nonfree.reserve(MCiteration/n_threads);
+		//The MC iterations are split in a fixed number of chunks, each one drawing from its own stream whose seed only depends on engine. Chunks are 
+		//reduced in their order, hence the estimate does not depend on the number of threads nor on how chunks are scheduled
+		const unsigned int MC_seed(gsl_rng_get(engine()));
+		const unsigned int n_chunks(std::max(1u, std::min(MC_chunks, MCiteration)));
+		std::vector< std::vector<double> > chunk_ss_nonfree(n_chunks);
+		std::vector<unsigned int> chunk_nan(n_chunks, 0);
+		auto run_chunk = [&](unsigned int const & chunk){
+			const sample::GSL_RNG thread_engine(sample::stream_seed(MC_seed, chunk));
+			std::vector<double> & vec_ss_nonfree = chunk_ss_nonfree[chunk];
+			unsigned int & number_nan = chunk_nan[chunk];
+			const unsigned int first_iter( (unsigned long)MCiteration*chunk/n_chunks );
+			const unsigned int last_iter( (unsigned long)MCiteration*(chunk+1)/n_chunks );
+			vec_ss_nonfree.reserve(last_iter - first_iter);
 			//Start MC for loop
 
-			for(IdxType iter = 0; iter < MCiteration/n_threads; ++ iter){
+			for(IdxType iter = first_iter; iter < last_iter; ++ iter){
 
 				MatRow Psi(MatRow::Zero(N,N));
 				double sq_sum_nonfree{0}; //In the end it has to be exp(-1/2 sum( psi_nonfree_ij^2 )). I accumulate the sum of non free elements squared every time they are generated
@@ -349,10 +364,10 @@ long double GWishart::log_normalizing_constat(const CompleteStructure<Type> & G,
 				citerator it_nu = nu.cbegin();
 				for(unsigned int i = 0; i < N_free_elements; ++i){
 					if(time_to_diagonal == 0){
-						vector_free_element[i] = std::sqrt(rchisq(engine, (double)(b+(*it_nu)) ));
+						vector_free_element[i] = std::sqrt(rchisq(thread_engine, (double)(b+(*it_nu)) ));
 					}
 					else
-						vector_free_element[i] = rnorm(engine);
+						vector_free_element[i] = rnorm(thread_engine);
 
 					if(time_to_diagonal++ == *it_nu){
 						time_to_diagonal = 0;
@@ -474,19 +489,29 @@ long double GWishart::log_normalizing_constat(const CompleteStructure<Type> & G,
 				}
 			}
 
-			#ifdef PARALLELEXEC
-				#pragma omp barrier
-				#pragma omp critical
-				{
-					vec_ss_nonfree_result.insert(vec_ss_nonfree_result.end(), 
-												 std::make_move_iterator(vec_ss_nonfree.begin()), std::make_move_iterator(vec_ss_nonfree.end())
-												);
-				}	
-			#endif				
-		}
-		#ifndef PARALLELEXEC
-			std::swap(vec_ss_nonfree_result, vec_ss_nonfree);
+		};
+		//When called from a parallel region (for example by one of the concurrent estimates of AddRemoveMH), chunks are tasks of the enclosing team
+		#ifdef PARALLELEXEC
+			if(omp_in_parallel()){
+				#pragma omp taskloop grainsize(1)
+				for(unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+					run_chunk(chunk);
+			}
+			else{
+				#pragma omp parallel for schedule(dynamic)
+				for(unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+					run_chunk(chunk);
+			}
+		#else
+			for(unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+				run_chunk(chunk);
 		#endif
+		std::vector<double> vec_ss_nonfree_result;
+		vec_ss_nonfree_result.reserve(MCiteration);
+		for(unsigned int chunk = 0; chunk < n_chunks; ++chunk){
+			vec_ss_nonfree_result.insert(vec_ss_nonfree_result.end(), chunk_ss_nonfree[chunk].cbegin(), chunk_ss_nonfree[chunk].cend());
+			number_nan += chunk_nan[chunk];
+		}
 		result_MC = -std::log(vec_ss_nonfree_result.size()) + utils::logSumExp(vec_ss_nonfree_result);
 		//Step 5: Compute constant term and return
 		long double result_const_term{0};
@@ -0,0 +1,229 @@
+#include "GraphLog.h"
+
+namespace HDF5conversion{
+
+	//Reads count values of a linear dataset of unsigned int, starting from position first
+	static std::vector<unsigned int> ReadUints(DatasetType & dataset, ScalarType const & first, ScalarType const & count)
+	{
+		std::vector<unsigned int> result(count);
+		if(count == 0)
+			return result;
+		ScalarType stride = 1;
+		ScalarType n_blocks = 1;
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &first, &stride, &n_blocks, &count);
+		MemspaceType memspace = H5Screate_simple(1, &count, NULL);
+		status = H5Dread(dataset, H5T_NATIVE_UINT, memspace, dataspace_sub, H5P_DEFAULT, result.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error, can not read the event log of the graphs");
+		return result;
+	}
+
+	//Writes values in a linear dataset of unsigned int starting from position first, the dataset is extended if needed
+	static void WriteUints(DatasetType & dataset, std::vector<unsigned int> & values, ScalarType const & first)
+	{
+		ScalarType count = values.size();
+		ScalarType stride = 1;
+		ScalarType n_blocks = 1;
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		ExtendDataset(dataset, dataspace_sub, first + count);
+		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &first, &stride, &n_blocks, &count);
+		MemspaceType memspace = H5Screate_simple(1, &count, NULL);
+		status = H5Dwrite(dataset, H5T_NATIVE_UINT, memspace, dataspace_sub, H5P_DEFAULT, values.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error, can not write the event log of the graphs");
+	}
+
+	static unsigned int ReadKeyframeEvery(DatasetType & dataset_keyframes)
+	{
+		unsigned int keyframe_every{0};
+		hid_t attr = H5Aopen(dataset_keyframes, "KeyframeEvery", H5P_DEFAULT);
+		if(attr < 0 || H5Aread(attr, H5T_NATIVE_UINT, &keyframe_every) < 0 || keyframe_every == 0)
+			throw std::runtime_error("Error, can not read the distance between two keyframes of the event log");
+		H5Aclose(attr);
+		return keyframe_every;
+	}
+
+	//Indices of the bits that are different in a and b, they have the same size
+	static std::vector<unsigned int> FlippedLinks(std::vector<unsigned char> const & a, std::vector<unsigned char> const & b)
+	{
+		std::vector<unsigned int> flipped;
+		for(std::size_t i = 0; i < a.size(); ++i){
+			const unsigned char diff = a[i] ^ b[i];
+			for(unsigned int k = 0; diff >> k; ++k)
+				if((diff >> k) & 1u)
+					flipped.push_back(8*i + k);
+		}
+		return flipped;
+	}
+
+	void GraphLogWriter::create(FileType & file, unsigned int const & n_elem, unsigned int const & iter_to_store, unsigned int const & _keyframe_every)
+	{
+		keyframe_every = std::max(_keyframe_every, 1u);
+		//The number of events is not known, the dataset is created empty with chunks of about chunk_bytes bytes
+		dataset_events 	  = CreateChainDataset(file, "/GraphEvents", H5T_NATIVE_UINT, 1, chunk_bytes/sizeof(unsigned int));
+		ResizeChainDataset(dataset_events, 0);
+		dataset_offsets   = CreateChainDataset(file, "/GraphEventOffsets", H5T_NATIVE_UINT, 1, iter_to_store);
+		dataset_keyframes = CreateChainDataset(file, "/GraphKeyframes", H5T_NATIVE_UCHAR, PackedSize(n_elem), (iter_to_store + keyframe_every - 1)/keyframe_every);
+		DataspaceType dataspace_attr = H5Screate(H5S_SCALAR);
+		hid_t attr = H5Acreate(dataset_keyframes, "KeyframeEvery", H5T_NATIVE_UINT, dataspace_attr, H5P_DEFAULT, H5P_DEFAULT);
+		if(attr < 0 || H5Awrite(attr, H5T_NATIVE_UINT, &keyframe_every) < 0)
+			throw std::runtime_error("Error, can not write the distance between two keyframes of the event log");
+		H5Aclose(attr);
+		H5Sclose(dataspace_attr);
+		n_events = 0;
+		n_added = 0;
+		last.clear();
+	}
+
+	void GraphLogWriter::open(FileType & file, unsigned int const & n_elem, unsigned int const & n_saved)
+	{
+		dataset_events 	  = OpenDataset(file, "/GraphEvents");
+		dataset_offsets   = OpenDataset(file, "/GraphEventOffsets");
+		dataset_keyframes = OpenDataset(file, "/GraphKeyframes");
+		keyframe_every = ReadKeyframeEvery(dataset_keyframes);
+		n_added = n_saved;
+		n_events = 0;
+		last.clear();
+		if(n_saved > 0){
+			n_events = ReadUints(dataset_offsets, n_saved - 1, 1)[0];
+			const unsigned int keyframe = (n_saved - 1)/keyframe_every;
+			last = ReadPackedGraphs(dataset_keyframes, PackedSize(n_elem), keyframe, 1);
+			const unsigned int first_event = ReadUints(dataset_offsets, keyframe*keyframe_every, 1)[0];
+			for(auto const & j : ReadUints(dataset_events, first_event, n_events - first_event))
+				last[j/8] ^= static_cast<unsigned char>(1u << (j%8));
+		}
+	}
+
+	void GraphLogWriter::add(std::vector<unsigned char> & packed, unsigned int const & iter)
+	{
+		if(iter != n_added)
+			throw std::runtime_error("Error, graphs have to be added to the event log in order");
+		if(!last.empty()){
+			std::vector<unsigned int> flipped(FlippedLinks(last, packed));
+			if(!flipped.empty()){
+				WriteUints(dataset_events, flipped, n_events);
+				n_events += flipped.size();
+			}
+		}
+		std::vector<unsigned int> offset{n_events};
+		WriteUints(dataset_offsets, offset, iter);
+		if(iter%keyframe_every == 0)
+			AddPackedGraph(dataset_keyframes, packed, iter/keyframe_every);
+		last = packed;
+		n_added++;
+	}
+
+	void GraphLogWriter::trim()
+	{
+		ResizeChainDataset(dataset_events, n_events);
+		ResizeChainDataset(dataset_offsets, n_added);
+		ResizeChainDataset(dataset_keyframes, last.size()*((n_added + keyframe_every - 1)/keyframe_every));
+	}
+
+	void GraphLogWriter::close()
+	{
+		H5Dclose(dataset_events);
+		H5Dclose(dataset_offsets);
+		H5Dclose(dataset_keyframes);
+	}
+
+	bool HasGraphLog(FileType & file, std::string const & group)
+	{
+		return H5Lexists(file, (group + "GraphEvents").data(), H5P_DEFAULT) > 0;
+	}
+
+	std::vector<unsigned char> ReadGraphFromLog(FileType & file, std::string const & group, unsigned int const & n_elem, unsigned int const & iter)
+	{
+		DatasetType dataset_events 	  = OpenDataset(file, group + "GraphEvents");
+		DatasetType dataset_offsets   = OpenDataset(file, group + "GraphEventOffsets");
+		DatasetType dataset_keyframes = OpenDataset(file, group + "GraphKeyframes");
+		const unsigned int keyframe_every = ReadKeyframeEvery(dataset_keyframes);
+		const unsigned int keyframe = iter/keyframe_every;
+		std::vector<unsigned char> packed(ReadPackedGraphs(dataset_keyframes, PackedSize(n_elem), keyframe, 1));
+		const unsigned int first_event = ReadUints(dataset_offsets, keyframe*keyframe_every, 1)[0];
+		const unsigned int last_event  = ReadUints(dataset_offsets, iter, 1)[0];
+		for(auto const & j : ReadUints(dataset_events, first_event, last_event - first_event))
+			packed[j/8] ^= static_cast<unsigned char>(1u << (j%8));
+		H5Dclose(dataset_events);
+		H5Dclose(dataset_offsets);
+		H5Dclose(dataset_keyframes);
+		return packed;
+	}
+
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>>
+	TallyGraphsLog(FileType & file, std::string const & group, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+				   std::vector<double> const & weights)
+	{
+		VecCol GraphSize(VecCol::Zero(stored_iter));
+		std::vector<double> links_weight(n_elem, 0.0);
+		if(tally.get_n_elem() != n_elem)
+			throw std::runtime_error("Error, the tally of the visited graphs has a different number of possible links");
+		if(stored_iter == 0)
+			return std::make_tuple(GraphSize, links_weight);
+		if(!weights.empty() && weights.size() < stored_iter)
+			throw std::runtime_error("Error, the number of weights is smaller than the number of graphs in the event log");
+		DatasetType dataset_events 	  = OpenDataset(file, group + "GraphEvents");
+		DatasetType dataset_offsets   = OpenDataset(file, group + "GraphEventOffsets");
+		DatasetType dataset_keyframes = OpenDataset(file, group + "GraphKeyframes");
+		const std::vector<unsigned int> offsets(ReadUints(dataset_offsets, 0, stored_iter));
+		std::vector<unsigned char> current(ReadPackedGraphs(dataset_keyframes, PackedSize(n_elem), 0, 1));
+		//Events are read in blocks of about chunk_bytes bytes
+		const ScalarType block_events = chunk_bytes/sizeof(unsigned int);
+		std::vector<unsigned int> events;
+		ScalarType events_first{0};
+		//A link contributes the cumulated weight of the graphs from when it is added to when it is removed
+		std::vector<double> added_at(n_elem, 0.0);
+		double cumulated_weight{0};
+		int size{0};
+		for(unsigned int j = 0; j < n_elem; ++j)
+			if((current[j/8] >> (j%8)) & 1u)
+				size++;
+		for(unsigned int i = 0; i < stored_iter; ++i){
+			for(ScalarType e = (i == 0) ? offsets[0] : offsets[i-1]; e < offsets[i]; ++e){
+				if(e < events_first || e >= events_first + events.size()){
+					events_first = e;
+					events = ReadUints(dataset_events, e, std::min(block_events, static_cast<ScalarType>(offsets[stored_iter-1]) - e));
+				}
+				const unsigned int j = events[e - events_first];
+				current[j/8] ^= static_cast<unsigned char>(1u << (j%8));
+				if((current[j/8] >> (j%8)) & 1u){
+					added_at[j] = cumulated_weight;
+					size++;
+				}
+				else{
+					links_weight[j] += cumulated_weight - added_at[j];
+					size--;
+				}
+			}
+			GraphSize(i) = size;
+			tally.add(current);
+			cumulated_weight += weights.empty() ? 1.0 : weights[i];
+		}
+		for(unsigned int j = 0; j < n_elem; ++j) //links in the last graph
+			if((current[j/8] >> (j%8)) & 1u)
+				links_weight[j] += cumulated_weight - added_at[j];
+		H5Dclose(dataset_events);
+		H5Dclose(dataset_offsets);
+		H5Dclose(dataset_keyframes);
+		return std::make_tuple(GraphSize, links_weight);
+	}
+
+	template std::tuple<VecCol, std::vector<double>>
+	TallyGraphsLog<GraphTally>(FileType &, std::string const &, unsigned int const &, unsigned int const &, GraphTally &, std::vector<double> const &);
+	template std::tuple<VecCol, std::vector<double>>
+	TallyGraphsLog<GraphSketch>(FileType &, std::string const &, unsigned int const &, unsigned int const &, GraphSketch &, std::vector<double> const &);
+
+	std::tuple<SampledGraphs, VecCol, std::vector<double>>
+	GetGraphsLog(FileType & file, std::string const & group, unsigned int const & n_elem, unsigned int const & stored_iter, std::vector<double> const & weights)
+	{
+		GraphTally tally(n_elem);
+		auto [GraphSize, links_weight] = TallyGraphsLog(file, group, n_elem, stored_iter, tally, weights);
+		return std::make_tuple(tally.top(), GraphSize, links_weight);
+	}
+}
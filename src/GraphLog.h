@@ -0,0 +1,60 @@
+#ifndef __GRAPHLOG_HPP__
+#define __GRAPHLOG_HPP__
+
+#include "HDF5conversion.h"
+#include "GraphTally.h"
+
+/*
+	Event log of the sampled graphs, an alternative to the snapshots saved in /Graphs by AddPackedGraph(). Consecutive saved graphs differ by few links,
+	hence only the links that changed with respect to the previous saved graph are written. The log is made of three datasets:
+	- /GraphEvents, indices (in the adjacency list) of the flipped links, in the order they were written.
+	- /GraphEventOffsets, for each saved graph, the number of events written up to it. The i-th graph flips events from offset[i-1] to offset[i].
+	- /GraphKeyframes, packed graphs (see PackGraph()) saved every keyframe_every saved graphs, the first one is the first saved graph. keyframe_every is an
+	  attribute of this dataset.
+	The i-th graph is obtained from the keyframe i/keyframe_every applying the following events, hence it can be read without replaying the whole log.
+	The file size scales with the number of changed links rather than with the number of saved graphs times the number of possible links.
+*/
+
+namespace HDF5conversion{
+
+	class GraphLogWriter{
+		public:
+		//Creates the datasets of the log
+		void create(FileType & file, unsigned int const & n_elem, unsigned int const & iter_to_store, unsigned int const & _keyframe_every);
+		//Opens the datasets of an existing log that contains at least n_saved graphs. Next graph to be added is the n_saved-th one. Used to resume a sampling
+		void open(FileType & file, unsigned int const & n_elem, unsigned int const & n_saved);
+		//Adds the iter-th saved graph, packed by PackGraph(). Graphs have to be added in order
+		void add(std::vector<unsigned char> & packed, unsigned int const & iter);
+		//Drops everything that was written after the last added graph, e.g by the interrupted sampling that is being resumed
+		void trim();
+		void close();
+		private:
+		DatasetType dataset_events;
+		DatasetType dataset_offsets;
+		DatasetType dataset_keyframes;
+		unsigned int keyframe_every{1};
+		unsigned int n_events{0};
+		unsigned int n_added{0};
+		std::vector<unsigned char> last; //last added graph
+	};
+
+	//True if group contains an event log of the graphs instead of /Graphs
+	bool HasGraphLog(FileType & file, std::string const & group = "/");
+
+	//Reads the iter-th graph of the log saved in group, starting from the closest previous keyframe. The graph is packed, see UnpackGraph()
+	std::vector<unsigned char> ReadGraphFromLog(FileType & file, std::string const & group, unsigned int const & n_elem, unsigned int const & iter);
+
+	//Replays the first stored_iter graphs of the log saved in group and adds them to tally. Returns the size of each graph and, for each possible link, the sum
+	//of the weights of the graphs that contain it. weights are the waiting times, leave empty if all graphs have weight one.
+	//Links are tracked through their flips, the cost depends on the number of events and not on stored_iter times n_elem. Counter is either GraphTally or GraphSketch
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>>
+	TallyGraphsLog(FileType & file, std::string const & group, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+				   std::vector<double> const & weights = {});
+
+	//As TallyGraphsLog(), but returns also all the visited graphs with their frequency of visit
+	std::tuple<SampledGraphs, VecCol, std::vector<double>>
+	GetGraphsLog(FileType & file, std::string const & group, unsigned int const & n_elem, unsigned int const & stored_iter, std::vector<double> const & weights = {});
+}
+
+#endif
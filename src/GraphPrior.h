@@ -15,6 +15,9 @@ class GraphPrior
 		virtual double Prob(Graph const & G) const = 0;
 		virtual double ratio(Graph const & G_num, Graph const & G_den) const = 0;
 		virtual double log_ratio(Graph const & G_num, Graph const & G_den) const  = 0;
+		//Same as log_ratio(G_new, G), where G_new is obtained by adding (or removing) link to G. The new graph is not built, all priors factorize over 
+		//the links, hence the result does not depend on the other links of G
+		virtual double log_ratio_link(Graph const & G, std::pair<unsigned int, unsigned int> const & link, bool const & add) const = 0;
 		virtual std::unique_ptr< GraphPrior<GraphStructure, T> > clone() const = 0;
 		virtual ~GraphPrior() = default;	
 };
@@ -38,6 +41,9 @@ class UniformPrior : public GraphPrior<GraphStructure, T>
 		double log_ratio(Graph const & G_num, Graph const & G_den) const override{
 			return 0.0;
 		}
+		double log_ratio_link(Graph const &, std::pair<unsigned int, unsigned int> const &, bool const &) const override{
+			return 0.0;
+		}
 		std::unique_ptr< GraphPrior<GraphStructure, T> > clone() const override{
 			return std::make_unique< UniformPrior<GraphStructure, T> >(*this);
 		}
@@ -61,6 +67,9 @@ class TruncatedUniformPrior : public GraphPrior< BlockGraphStructure, T >{
 		double log_ratio(BlockGraphType const & G_num, BlockGraphType const & G_den) const override{
 			return 0.0;
 		}
+		double log_ratio_link(BlockGraphType const &, std::pair<unsigned int, unsigned int> const &, bool const &) const override{
+			return 0.0;
+		}
 		std::unique_ptr< GraphPrior<BlockGraphStructure, T> > clone() const override{
 			return std::make_unique<TruncatedUniformPrior<BlockGraphStructure, T> >(*this);
 		}
@@ -91,6 +100,15 @@ class BernoulliPrior : public GraphPrior<GraphStructure, T>
 			return ( static_cast<int>(G_num.get_n_links() - G_den.get_n_links() )*std::log(theta) + 
 					 static_cast<int>(G_den.get_n_links() - G_num.get_n_links() )*std::log(1 - theta));
 		}
+		//A block link contains all the links between the two groups
+		double log_ratio_link(Graph const & G, std::pair<unsigned int, unsigned int> const & link, bool const & add) const override{
+			double n_changed{1.0};
+			if constexpr(!internal_type_traits::isCompleteGraph<GraphStructure,T>::value){
+				const double size_i(G.get_group_size(link.first)), size_j(G.get_group_size(link.second));
+				n_changed = (link.first == link.second) ? 0.5*size_i*(size_i - 1) : size_i*size_j;
+			}
+			return (add ? n_changed : -n_changed)*(std::log(theta) - std::log(1 - theta));
+		}
 		std::unique_ptr< GraphPrior<GraphStructure, T> > clone() const override{
 			return std::make_unique<BernoulliPrior<GraphStructure, T>>(*this);
 		}
@@ -123,6 +141,9 @@ class TruncatedBernoulliPrior : public GraphPrior< BlockGraphStructure, T>
 			return ( static_cast<int>(G_num.get_n_block_links() - G_den.get_n_block_links() )*std::log(theta) + 
 					 static_cast<int>(G_den.get_n_block_links() - G_num.get_n_block_links() )*std::log(1 - theta));
 		}
+		double log_ratio_link(BlockGraphType const &, std::pair<unsigned int, unsigned int> const &, bool const & add) const override{
+			return (add ? 1.0 : -1.0)*(std::log(theta) - std::log(1 - theta));
+		}
 		std::unique_ptr< GraphPrior<BlockGraphStructure, T> > clone() const override{
 			return std::make_unique<TruncatedBernoulliPrior<BlockGraphStructure, T> >(*this);
 		}
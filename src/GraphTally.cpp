@@ -0,0 +1,497 @@
+#include "GraphTally.h"
+#include "ChainStorage.h"
+#include <bitset>
+#include <cstring>
+
+namespace HDF5conversion{
+
+	//Finalizer of splitmix64, each bit of x affects all bits of the result
+	static inline std::uint64_t MixBits(std::uint64_t x)
+	{
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ULL;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return x;
+	}
+
+	//Hash of a packed graph stored as n_words words
+	static std::uint64_t HashWords(std::uint64_t const * key, std::size_t const & n_words, unsigned int const & n_elem)
+	{
+		std::uint64_t h = MixBits(n_elem);
+		for(std::size_t w = 0; w < n_words; ++w)
+			h = MixBits(h + 0x9e3779b97f4a7c15ULL + key[w]);
+		return h;
+	}
+
+	GraphTally::GraphTally(unsigned int const & _n_elem):n_elem(_n_elem), n_bytes(PackedSize(_n_elem)), n_words((PackedSize(_n_elem) + 7)/8),
+														 slots(16, 0), buffer(std::max(n_words, std::size_t(1)), 0){}
+
+	std::uint64_t GraphTally::hash(std::uint64_t const * key) const
+	{
+		return HashWords(key, n_words, n_elem);
+	}
+
+	void GraphTally::add(unsigned char const * packed, int const & count)
+	{
+		if(count == 0)
+			return;
+		buffer.back() = 0; //bytes after the last one of the graph
+		std::memcpy(buffer.data(), packed, n_bytes);
+		this->insert(buffer.data(), this->hash(buffer.data()), count);
+	}
+
+	void GraphTally::insert(std::uint64_t const * key, std::uint64_t const & h, int const & count)
+	{
+		const std::size_t mask = slots.size() - 1;
+		for(std::size_t s = h & mask; ; s = (s + 1) & mask){
+			if(slots[s] == 0){ //not visited yet
+				keys.insert(keys.end(), key, key + n_words);
+				hashes.push_back(h);
+				counts.push_back(count);
+				slots[s] = counts.size();
+				if(2*counts.size() > slots.size())
+					this->rehash(2*slots.size());
+				return;
+			}
+			const std::size_t i = slots[s] - 1;
+			if(hashes[i] == h && std::equal(key, key + n_words, keys.cbegin() + i*n_words)){
+				counts[i] += count;
+				return;
+			}
+		}
+	}
+
+	void GraphTally::rehash(std::size_t const & new_capacity)
+	{
+		slots.assign(new_capacity, 0);
+		const std::size_t mask = new_capacity - 1;
+		for(std::size_t i = 0; i < counts.size(); ++i){
+			std::size_t s = hashes[i] & mask;
+			while(slots[s] != 0)
+				s = (s + 1) & mask;
+			slots[s] = i + 1;
+		}
+	}
+
+	void GraphTally::merge(GraphTally const & other)
+	{
+		if(other.n_elem != n_elem)
+			throw std::runtime_error("Error, can not merge the visited graphs of graphs with a different number of possible links");
+		keys.reserve(keys.size() + other.keys.size());
+		for(std::size_t i = 0; i < other.counts.size(); ++i)
+			this->insert(other.keys.data() + i*n_words, other.hashes[i], other.counts[i]);
+	}
+
+	SampledGraphs GraphTally::top(std::size_t const & k) const
+	{
+		std::vector<std::size_t> order(counts.size());
+		std::iota(order.begin(), order.end(), 0);
+		const std::size_t n_top = (k == 0) ? order.size() : std::min(k, order.size());
+		if(n_top < order.size()){
+			std::partial_sort(order.begin(), order.begin() + n_top, order.end(), [this](std::size_t const & a, std::size_t const & b){
+				if(counts[a] != counts[b])
+					return counts[a] > counts[b];
+				return std::lexicographical_compare(keys.cbegin() + a*n_words, keys.cbegin() + (a + 1)*n_words, keys.cbegin() + b*n_words, keys.cbegin() + (b + 1)*n_words);
+			});
+		}
+		SampledGraphs SaveG;
+		std::vector<unsigned char> packed(n_bytes);
+		for(std::size_t t = 0; t < n_top; ++t){
+			std::memcpy(packed.data(), keys.data() + order[t]*n_words, n_bytes);
+			SaveG.emplace(UnpackGraph(packed, n_elem), counts[order[t]]);
+		}
+		return SaveG;
+	}
+
+	GraphSketch::GraphSketch(unsigned int const & _n_elem, std::size_t const & _capacity):n_elem(_n_elem), capacity(std::max(_capacity, std::size_t(1))),
+																					 n_bytes(PackedSize(_n_elem)), n_words((PackedSize(_n_elem) + 7)/8),
+																					 buffer(std::max(n_words, std::size_t(1)), 0)
+	{
+		std::size_t n_slots{16};
+		while(n_slots < 2*capacity)
+			n_slots *= 2;
+		slots.assign(n_slots, 0);
+	}
+
+	std::size_t GraphSketch::find(std::uint64_t const * key, std::uint64_t const & h) const
+	{
+		const std::size_t mask = slots.size() - 1;
+		for(std::size_t s = h & mask; slots[s] != 0; s = (s + 1) & mask){
+			const std::size_t i = slots[s] - 1;
+			if(hashes[i] == h && std::equal(key, key + n_words, keys.cbegin() + i*n_words))
+				return i;
+		}
+		return not_found;
+	}
+
+	void GraphSketch::index_insert(std::size_t const & i)
+	{
+		const std::size_t mask = slots.size() - 1;
+		std::size_t s = hashes[i] & mask;
+		while(slots[s] != 0)
+			s = (s + 1) & mask;
+		slots[s] = i + 1;
+	}
+
+	//Linear probing does not allow to simply empty the slot, following graphs that were displaced beyond it are moved back
+	void GraphSketch::index_erase(std::size_t const & i)
+	{
+		const std::size_t mask = slots.size() - 1;
+		std::size_t s = hashes[i] & mask;
+		while(slots[s] != i + 1)
+			s = (s + 1) & mask;
+		for(std::size_t j = (s + 1) & mask; slots[j] != 0; j = (j + 1) & mask){
+			const std::size_t k = hashes[slots[j] - 1] & mask; //slot where the graph in j would like to be
+			const bool reachable = (s <= j) ? (s < k && k <= j) : (s < k || k <= j);
+			if(!reachable){
+				slots[s] = slots[j];
+				s = j;
+			}
+		}
+		slots[s] = 0;
+	}
+
+	void GraphSketch::sift_up(std::size_t pos)
+	{
+		while(pos > 0){
+			const std::size_t parent = (pos - 1)/2;
+			if(counts[heap[parent]] <= counts[heap[pos]])
+				return;
+			std::swap(heap[parent], heap[pos]);
+			heap_pos[heap[parent]] = parent;
+			heap_pos[heap[pos]] = pos;
+			pos = parent;
+		}
+	}
+
+	void GraphSketch::sift_down(std::size_t pos)
+	{
+		while(true){
+			std::size_t smallest = pos;
+			for(std::size_t child = 2*pos + 1; child <= 2*pos + 2 && child < heap.size(); ++child)
+				if(counts[heap[child]] < counts[heap[smallest]])
+					smallest = child;
+			if(smallest == pos)
+				return;
+			std::swap(heap[smallest], heap[pos]);
+			heap_pos[heap[smallest]] = smallest;
+			heap_pos[heap[pos]] = pos;
+			pos = smallest;
+		}
+	}
+
+	void GraphSketch::append(std::uint64_t const * key, std::uint64_t const & h, int const & count, int const & error)
+	{
+		const std::size_t i = counts.size();
+		keys.insert(keys.end(), key, key + n_words);
+		hashes.push_back(h);
+		counts.push_back(count);
+		errors.push_back(error);
+		heap_pos.push_back(heap.size());
+		heap.push_back(i);
+		this->index_insert(i);
+		this->sift_up(heap.size() - 1);
+	}
+
+	void GraphSketch::add(unsigned char const * packed, int const & count)
+	{
+		if(count <= 0)
+			return;
+		buffer.back() = 0;
+		std::memcpy(buffer.data(), packed, n_bytes);
+		const std::uint64_t h = HashWords(buffer.data(), n_words, n_elem);
+		total += count;
+		const std::size_t found = this->find(buffer.data(), h);
+		if(found != not_found){
+			counts[found] += count;
+			this->sift_down(heap_pos[found]);
+		}
+		else if(counts.size() < capacity)
+			this->append(buffer.data(), h, count, 0);
+		else{ //the least visited graph is replaced, its frequency is an upper bound for the visits of the new one that were not counted
+			const std::size_t i = heap[0];
+			this->index_erase(i);
+			std::copy(buffer.cbegin(), buffer.cbegin() + n_words, keys.begin() + i*n_words);
+			hashes[i] = h;
+			errors[i] = counts[i];
+			counts[i] += count;
+			this->index_insert(i);
+			this->sift_down(0);
+		}
+	}
+
+	void GraphSketch::merge(GraphSketch const & other)
+	{
+		if(other.n_elem != n_elem)
+			throw std::runtime_error("Error, can not merge the sketches of graphs with a different number of possible links");
+		//A graph that is not tracked by a full sketch may have been visited as many times as its least visited graph
+		const int min_this  = (counts.size() == capacity) ? counts[heap[0]] : 0;
+		const int min_other = (other.counts.size() == other.capacity) ? other.counts[other.heap[0]] : 0;
+		std::vector<std::uint64_t> merged_keys(keys);
+		std::vector<std::uint64_t> merged_hashes(hashes);
+		std::vector<int> merged_counts(counts);
+		std::vector<int> merged_errors(errors);
+		for(std::size_t i = 0; i < counts.size(); ++i){
+			const std::size_t j = other.find(keys.data() + i*n_words, hashes[i]);
+			merged_counts[i] += (j != not_found) ? other.counts[j] : min_other;
+			merged_errors[i] += (j != not_found) ? other.errors[j] : min_other;
+		}
+		for(std::size_t j = 0; j < other.counts.size(); ++j){
+			if(this->find(other.keys.data() + j*n_words, other.hashes[j]) != not_found)
+				continue;
+			merged_keys.insert(merged_keys.end(), other.keys.cbegin() + j*n_words, other.keys.cbegin() + (j + 1)*n_words);
+			merged_hashes.push_back(other.hashes[j]);
+			merged_counts.push_back(other.counts[j] + min_this);
+			merged_errors.push_back(other.errors[j] + min_this);
+		}
+		//Only the capacity most visited graphs are kept
+		std::vector<std::size_t> order(merged_counts.size());
+		std::iota(order.begin(), order.end(), 0);
+		if(order.size() > capacity){
+			std::nth_element(order.begin(), order.begin() + capacity, order.end(), [&merged_counts](std::size_t const & a, std::size_t const & b){
+				return merged_counts[a] > merged_counts[b];
+			});
+			order.resize(capacity);
+		}
+		const long long merged_total = total + other.total;
+		*this = this->empty_copy();
+		total = merged_total;
+		for(auto const & i : order)
+			this->append(merged_keys.data() + i*n_words, merged_hashes[i], merged_counts[i], merged_errors[i]);
+	}
+
+	SketchedGraphs GraphSketch::top(std::size_t const & k) const
+	{
+		std::vector<std::size_t> order(counts.size());
+		std::iota(order.begin(), order.end(), 0);
+		const std::size_t n_top = (k == 0) ? order.size() : std::min(k, order.size());
+		std::partial_sort(order.begin(), order.begin() + n_top, order.end(), [this](std::size_t const & a, std::size_t const & b){
+			if(counts[a] != counts[b])
+				return counts[a] > counts[b];
+			return std::lexicographical_compare(keys.cbegin() + a*n_words, keys.cbegin() + (a + 1)*n_words, keys.cbegin() + b*n_words, keys.cbegin() + (b + 1)*n_words);
+		});
+		SketchedGraphs result;
+		result.reserve(n_top);
+		std::vector<unsigned char> packed(n_bytes);
+		for(std::size_t t = 0; t < n_top; ++t){
+			std::memcpy(packed.data(), keys.data() + order[t]*n_words, n_bytes);
+			result.emplace_back(UnpackGraph(packed, n_elem), counts[order[t]], errors[order[t]]);
+		}
+		return result;
+	}
+
+	//Words are split in two halves of 32 bits, that are represented exactly by a double
+	std::vector<double> GraphSketch::get_state() const
+	{
+		std::vector<double> state{static_cast<double>(n_elem), static_cast<double>(capacity), static_cast<double>(total), static_cast<double>(counts.size())};
+		state.reserve(4 + counts.size()*(2 + 2*n_words));
+		state.insert(state.end(), counts.cbegin(), counts.cend());
+		state.insert(state.end(), errors.cbegin(), errors.cend());
+		for(auto const & word : keys){
+			state.push_back(static_cast<double>(word & 0xffffffffULL));
+			state.push_back(static_cast<double>(word >> 32));
+		}
+		return state;
+	}
+
+	void GraphSketch::set_state(std::vector<double> const & state)
+	{
+		if(state.size() < 4 || state[0] != n_elem || state[1] != capacity)
+			throw std::runtime_error("Error in GraphSketch::set_state(), the state was saved by a sketch with different capacity or number of possible links");
+		const std::size_t n_graphs = static_cast<std::size_t>(state[3]);
+		if(state.size() != 4 + n_graphs*(2 + 2*n_words))
+			throw std::runtime_error("Error in GraphSketch::set_state(), the size of the state is not coherent");
+		*this = this->empty_copy();
+		total = static_cast<long long>(state[2]);
+		auto it = state.cbegin() + 4 + 2*n_graphs;
+		for(std::size_t i = 0; i < n_graphs; ++i){
+			for(std::size_t w = 0; w < n_words; ++w, it += 2)
+				buffer[w] = static_cast<std::uint64_t>(it[0]) | (static_cast<std::uint64_t>(it[1]) << 32);
+			this->append(buffer.data(), HashWords(buffer.data(), n_words, n_elem), static_cast<int>(state[4 + i]), static_cast<int>(state[4 + n_graphs + i]));
+		}
+	}
+
+	void WriteGraphSketch(FileType & file, GraphSketch const & sketch)
+	{
+		const std::size_t n_graphs = sketch.size();
+		std::vector<unsigned char> packed(n_graphs*sketch.n_bytes);
+		MatRow counts(2, n_graphs);
+		for(std::size_t i = 0; i < n_graphs; ++i){
+			std::memcpy(packed.data() + i*sketch.n_bytes, sketch.keys.data() + i*sketch.n_words, sketch.n_bytes);
+			counts(0,i) = sketch.counts[i];
+			counts(1,i) = sketch.errors[i];
+		}
+		ScalarType dim = packed.size();
+		DataspaceType dataspace = H5Screate_simple(1, &dim, NULL);
+		DatasetType dataset = H5Dcreate(file, "/SketchGraphs", H5T_NATIVE_UCHAR, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset SketchGraphs");
+		if(dim > 0 && H5Dwrite(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, packed.data()) < 0)
+			throw std::runtime_error("Error, can not write dataset SketchGraphs");
+		H5Dclose(dataset);
+		H5Sclose(dataspace);
+		WriteMatrixDataset(file, "/SketchCounts", counts);
+		MatRow info(1,2);
+		info << static_cast<double>(sketch.total), static_cast<double>(sketch.capacity);
+		WriteMatrixDataset(file, "/SketchInfo", info);
+	}
+
+	bool HasGraphSketch(FileType & file, std::string const & group)
+	{
+		return H5Lexists(file, (group + "SketchGraphs").data(), H5P_DEFAULT) > 0;
+	}
+
+	GraphSketch ReadGraphSketch(FileType & file, std::string const & group, unsigned int const & n_elem)
+	{
+		DatasetType dataset_info = OpenDataset(file, group + "SketchInfo");
+		MatRow info(1,2);
+		if(H5Dread(dataset_info, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, info.data()) < 0)
+			throw std::runtime_error("Error, can not read SketchInfo");
+		H5Dclose(dataset_info);
+		GraphSketch sketch(n_elem, static_cast<std::size_t>(info(0,1)));
+		DatasetType dataset_graphs = OpenDataset(file, group + "SketchGraphs");
+		DataspaceType dataspace = H5Dget_space(dataset_graphs);
+		ScalarType dim{0};
+		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+		H5Sclose(dataspace);
+		if(dim % sketch.n_bytes != 0 && sketch.n_bytes > 0)
+			throw std::runtime_error("Error, the graphs of the sketch do not have the expected number of possible links");
+		const std::size_t n_graphs = (sketch.n_bytes > 0) ? dim/sketch.n_bytes : 0;
+		std::vector<unsigned char> packed(dim);
+		if(dim > 0 && H5Dread(dataset_graphs, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, packed.data()) < 0)
+			throw std::runtime_error("Error, can not read SketchGraphs");
+		H5Dclose(dataset_graphs);
+		MatRow counts(2, n_graphs);
+		DatasetType dataset_counts = OpenDataset(file, group + "SketchCounts");
+		if(n_graphs > 0 && H5Dread(dataset_counts, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, counts.data()) < 0)
+			throw std::runtime_error("Error, can not read SketchCounts");
+		H5Dclose(dataset_counts);
+		if(n_graphs > sketch.capacity)
+			throw std::runtime_error("Error, the sketch contains more graphs than its capacity");
+		sketch.total = static_cast<long long>(info(0,0));
+		for(std::size_t i = 0; i < n_graphs; ++i){
+			sketch.buffer.back() = 0;
+			std::memcpy(sketch.buffer.data(), packed.data() + i*sketch.n_bytes, sketch.n_bytes);
+			sketch.append(sketch.buffer.data(), HashWords(sketch.buffer.data(), sketch.n_words, n_elem), static_cast<int>(counts(0,i)), static_cast<int>(counts(1,i)));
+		}
+		return sketch;
+	}
+
+	//Core of TallyGraphsChain(), read(first, n_iter) returns the packed graphs of n_iter iterations starting from first
+	template<class Counter, class Read>
+	static std::tuple<VecCol, std::vector<double>>
+	TallyPackedGraphs(Read && read, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+					  std::vector<double> const & weights, ScalarType const & max_bytes)
+	{
+		VecCol GraphSize(VecCol::Zero(stored_iter));
+		std::vector<double> links_weight(n_elem, 0.0);
+		const ScalarType n_bytes = PackedSize(n_elem);
+		const ScalarType iter_block = std::clamp(max_bytes/std::max(n_bytes, ScalarType(1)), ScalarType(1), std::max(static_cast<ScalarType>(stored_iter), ScalarType(1)));
+		//Frequencies of a GraphTally do not depend on the order of the visits, each thread fills its own tally and they are merged at the end.
+		//The space-saving sketch depends on it, graphs enter a GraphSketch in iteration order. Sizes are computed by iteration and weights are summed
+		//by link, so that each sum follows the iteration order too. Results do not depend on the number of threads
+		constexpr bool exact_counts = std::is_same_v<Counter, GraphTally>;
+		int n_threads{1};
+		#ifdef PARALLELEXEC
+			if constexpr(exact_counts)
+				n_threads = omp_get_max_threads();
+		#endif
+		std::vector<Counter> tally_thread(n_threads, tally.empty_copy());
+		for(ScalarType first = 0; first < stored_iter; first += iter_block){
+			const ScalarType n_iter = std::min(iter_block, stored_iter - first);
+			const std::vector<unsigned char> packed(read(first, n_iter));
+			#pragma omp parallel for schedule(static)
+			for(ScalarType i = 0; i < n_iter; ++i){
+				unsigned char const * G = packed.data() + i*n_bytes;
+				int size{0};
+				for(ScalarType b = 0; b < n_bytes; ++b)
+					size += std::bitset<8>(G[b]).count();
+				GraphSize(first + i) = size;
+			}
+			#pragma omp parallel for schedule(static)
+			for(ScalarType b = 0; b < n_bytes; ++b){
+				for(ScalarType i = 0; i < n_iter; ++i){
+					const unsigned char byte = packed[i*n_bytes + b];
+					if(byte == 0)
+						continue;
+					const double weight = weights.empty() ? 1.0 : weights[first + i];
+					for(unsigned int k = 0; k < 8 && 8*b + k < n_elem; ++k)
+						if((byte >> k) & 1u)
+							links_weight[8*b + k] += weight;
+				}
+			}
+			if constexpr(exact_counts){
+				#pragma omp parallel for num_threads(n_threads) schedule(static)
+				for(ScalarType i = 0; i < n_iter; ++i){
+					unsigned int thread_id{0};
+					#ifdef PARALLELEXEC
+						thread_id = omp_get_thread_num();
+					#endif
+					tally_thread[thread_id].add(packed.data() + i*n_bytes);
+				}
+			}
+			else{
+				for(ScalarType i = 0; i < n_iter; ++i)
+					tally.add(packed.data() + i*n_bytes);
+			}
+		}
+		if constexpr(exact_counts){
+			for(auto & tally_t : tally_thread){
+				tally.merge(tally_t);
+				tally_t = tally.empty_copy();
+			}
+		}
+		return std::make_tuple(GraphSize, links_weight);
+	}
+
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+					 std::vector<double> const & weights, ScalarType const & max_bytes)
+	{
+		if(tally.get_n_elem() != n_elem)
+			throw std::runtime_error("Error, the tally of the visited graphs has a different number of possible links");
+		if(!weights.empty() && weights.size() < stored_iter)
+			throw std::runtime_error("Error, the number of weights is smaller than the number of stored graphs");
+		if(!IsPackedGraph(dataset)){ //older files, one unsigned int per link
+			VecCol GraphSize(VecCol::Zero(stored_iter));
+			std::vector<double> links_weight(n_elem, 0.0);
+			for(unsigned int i = 0; i < stored_iter; ++i){
+				std::vector<unsigned int> adj = ReadUintVector(dataset, n_elem, i);
+				const double weight = weights.empty() ? 1.0 : weights[i];
+				for(unsigned int j = 0; j < n_elem; ++j)
+					links_weight[j] += weight*adj[j];
+				GraphSize(i) = std::accumulate(adj.cbegin(), adj.cend(), 0);
+				tally.add(PackGraph(adj));
+			}
+			return std::make_tuple(GraphSize, links_weight);
+		}
+		const ScalarType n_bytes = PackedSize(n_elem);
+		return TallyPackedGraphs([&dataset, &n_bytes](ScalarType const & first, ScalarType const & n_iter){return ReadPackedGraphs(dataset, n_bytes, first, n_iter);},
+								 n_elem, stored_iter, tally, weights, max_bytes);
+	}
+
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain(ChainReader & chain, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+					 std::vector<double> const & weights, ScalarType const & max_bytes)
+	{
+		if(tally.get_n_elem() != n_elem)
+			throw std::runtime_error("Error, the tally of the visited graphs has a different number of possible links");
+		if(!weights.empty() && weights.size() < stored_iter)
+			throw std::runtime_error("Error, the number of weights is smaller than the number of stored graphs");
+		return TallyPackedGraphs([&chain, &stored_iter](ScalarType const & first, ScalarType const & n_iter){return chain.bytes(first, n_iter, stored_iter);},
+								 n_elem, stored_iter, tally, weights, max_bytes);
+	}
+
+	template std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain<GraphTally>(DatasetType &, unsigned int const &, unsigned int const &, GraphTally &, std::vector<double> const &, ScalarType const &);
+	template std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain<GraphSketch>(DatasetType &, unsigned int const &, unsigned int const &, GraphSketch &, std::vector<double> const &, ScalarType const &);
+	template std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain<GraphTally>(ChainReader &, unsigned int const &, unsigned int const &, GraphTally &, std::vector<double> const &, ScalarType const &);
+	template std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain<GraphSketch>(ChainReader &, unsigned int const &, unsigned int const &, GraphSketch &, std::vector<double> const &, ScalarType const &);
+}
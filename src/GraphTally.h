@@ -0,0 +1,147 @@
+#ifndef __GRAPHTALLY_HPP__
+#define __GRAPHTALLY_HPP__
+
+#include "HDF5conversion.h"
+#include <cstdint>
+
+/*
+	Frequencies of visit of the sampled graphs, keyed by their packed representation (see PackGraph()). It replaces the std::map of unpacked adjacency lists,
+	that compares whole vectors of unsigned int at each insertion and holds a copy of 32 bits per possible link for each visited graph.
+	Graphs are stored contiguously in insertion order, as arrays of 64-bit words, together with their hash and their frequency. The table is an open addressing
+	one with linear probing, its slots only hold the index of a graph. The capacity is a power of two and the load is kept below one half.
+	The hash mixes the words of the graph with the finalizer of splitmix64, the whole graph is compared only if the hashes match.
+	Tallies filled by different threads are summed by merge().
+	When the number of distinct graphs is too large to be stored, GraphSketch keeps only capacity graphs by means of the Space-Saving algorithm (Metwally, Agrawal
+	and El Abbadi, 2005). A graph that is not tracked replaces the least visited one and inherits its frequency, that becomes the error of the new graph. Hence
+	frequencies are overestimated by at most their error, that is bounded by the number of visits over capacity, and every graph visited more often than that
+	is tracked. Sketches are merged as in Agarwal et al. (2013), the bound holds for the total number of visits of the merged sketches.
+*/
+
+namespace HDF5conversion{
+
+	class GraphTally{
+		public:
+		GraphTally(unsigned int const & _n_elem = 0);
+		//Adds count visits of the packed graph made of the PackedSize(n_elem) bytes starting from packed
+		void add(unsigned char const * packed, int const & count = 1);
+		void add(std::vector<unsigned char> const & packed, int const & count = 1){
+			this->add(packed.data(), count);
+		}
+		//Adds the visits counted by other, it has to have the same number of possible links
+		void merge(GraphTally const & other);
+		//Number of distinct graphs
+		inline std::size_t size() const{
+			return counts.size();
+		}
+		inline unsigned int get_n_elem() const{
+			return n_elem;
+		}
+		//Returns the k most visited graphs, unpacked, with their frequency. All graphs are returned if k is zero. Ties are broken by the packed representation,
+		//so that the result does not depend on the order of the visits
+		SampledGraphs top(std::size_t const & k = 0) const;
+		//Empty tally for the same number of possible links
+		GraphTally empty_copy() const{
+			return GraphTally(n_elem);
+		}
+		private:
+		std::uint64_t hash(std::uint64_t const * key) const;
+		void insert(std::uint64_t const * key, std::uint64_t const & h, int const & count);
+		void rehash(std::size_t const & new_capacity);
+		unsigned int n_elem;
+		std::size_t n_bytes;
+		std::size_t n_words;
+		std::vector<std::uint64_t> keys;   //graph i is made of the words from i*n_words to (i+1)*n_words
+		std::vector<std::uint64_t> hashes;
+		std::vector<int> counts;
+		std::vector<std::uint32_t> slots;  //index of the graph plus one, zero if the slot is empty
+		std::vector<std::uint64_t> buffer; //graph being added, padded with zeros
+	};
+
+	//Graphs tracked by a GraphSketch, from the most visited one. Each one comes with its estimated frequency of visit and the maximum overestimation of it
+	using SketchedGraphs = std::vector< std::tuple<std::vector<unsigned int>, int, int> >;
+
+	class GraphSketch{
+		public:
+		GraphSketch(unsigned int const & _n_elem = 0, std::size_t const & _capacity = 1);
+		//Adds count visits of the packed graph made of the PackedSize(n_elem) bytes starting from packed
+		void add(unsigned char const * packed, int const & count = 1);
+		void add(std::vector<unsigned char> const & packed, int const & count = 1){
+			this->add(packed.data(), count);
+		}
+		//Adds the visits summarized by other, it has to have the same number of possible links. The capacity of this sketch is kept
+		void merge(GraphSketch const & other);
+		//Number of tracked graphs, at most capacity
+		inline std::size_t size() const{
+			return counts.size();
+		}
+		inline std::size_t get_capacity() const{
+			return capacity;
+		}
+		inline unsigned int get_n_elem() const{
+			return n_elem;
+		}
+		//Total number of visits, the error of each graph is at most get_total()/get_capacity()
+		inline long long get_total() const{
+			return total;
+		}
+		//Returns the k most visited graphs, all the tracked ones if k is zero. Ties are broken as in GraphTally::top()
+		SketchedGraphs top(std::size_t const & k = 0) const;
+		//Empty sketch with the same capacity and number of possible links
+		GraphSketch empty_copy() const{
+			return GraphSketch(n_elem, capacity);
+		}
+		//Everything needed to continue the updates, used for checkpoints of the sampler
+		std::vector<double> get_state() const;
+		void set_state(std::vector<double> const & state);
+		private:
+		static constexpr std::size_t not_found = static_cast<std::size_t>(-1);
+		std::size_t find(std::uint64_t const * key, std::uint64_t const & h) const;
+		//Adds a graph that is not tracked, there has to be room for it
+		void append(std::uint64_t const * key, std::uint64_t const & h, int const & count, int const & error);
+		void index_insert(std::size_t const & i);
+		void index_erase(std::size_t const & i);
+		void sift_up(std::size_t pos);
+		void sift_down(std::size_t pos);
+		unsigned int n_elem;
+		std::size_t capacity;
+		std::size_t n_bytes;
+		std::size_t n_words;
+		long long total{0};
+		std::vector<std::uint64_t> keys;   //as in GraphTally
+		std::vector<std::uint64_t> hashes;
+		std::vector<int> counts;
+		std::vector<int> errors;
+		std::vector<std::size_t> heap;     //min-heap of the graphs by count, the root is the one to be replaced
+		std::vector<std::size_t> heap_pos; //position of each graph in heap
+		std::vector<std::uint32_t> slots;  //as in GraphTally, the capacity of the table is fixed
+		std::vector<std::uint64_t> buffer;
+		friend void WriteGraphSketch(FileType & file, GraphSketch const & sketch);
+		friend GraphSketch ReadGraphSketch(FileType & file, std::string const & group, unsigned int const & n_elem);
+	};
+
+	//Adds to tally the first stored_iter graphs of dataset, either packed or stored one unsigned int per link. Returns the size of each graph and, for each possible
+	//link, the sum of the weights of the graphs that contain it. weights are the waiting times, leave empty if all graphs have weight one.
+	//Packed graphs are read in blocks of at most max_bytes bytes, the iterations of a block are counted in parallel. With a GraphTally each thread fills its own
+	//tally, they are merged at the end. A GraphSketch is filled serially in iteration order, since the graphs it tracks depend on it.
+	//Counter is either GraphTally or GraphSketch, frequencies of the links are exact in both cases
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+					 std::vector<double> const & weights = {}, ScalarType const & max_bytes = 67108864);
+	class ChainReader;
+	//As above, packed graphs are read from a chain saved in any format, see ChainStorage.h
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>>
+	TallyGraphsChain(ChainReader & chain, unsigned int const & n_elem, unsigned int const & stored_iter, Counter & tally,
+					 std::vector<double> const & weights = {}, ScalarType const & max_bytes = 67108864);
+
+	//Writes the sketch as /SketchGraphs, the tracked packed graphs one after the other, /SketchCounts, a 2 x size() matrix of estimated frequencies and errors,
+	//and /SketchInfo, the total number of visits and the capacity
+	void WriteGraphSketch(FileType & file, GraphSketch const & sketch);
+	//True if group contains a sketch written by WriteGraphSketch()
+	bool HasGraphSketch(FileType & file, std::string const & group = "/");
+	//Reads the sketch written by WriteGraphSketch(), n_elem is the number of possible links
+	GraphSketch ReadGraphSketch(FileType & file, std::string const & group, unsigned int const & n_elem);
+}
+
+#endif
@@ -1,6 +1,58 @@
 #include "HDF5conversion.h"
+#include "GraphTally.h"
 
 namespace HDF5conversion{
+
+	DatasetType CreateChainDataset(FileType & file, std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store, 
+								   ScalarType const & rows)
+	{
+		const int rank = (rows > 0) ? 2 : 1;
+		const ScalarType chunk_iter = ChunkIterations(std::max(rows, ScalarType(1)) * block * H5Tget_size(type), iter_to_store);
+		const ScalarType length = block*iter_to_store;
+		const ScalarType chunk_length = std::max(block, ScalarType(1))*chunk_iter;
+		ScalarType dims[2]    = {rows, length};
+		ScalarType maxdims[2] = {rows, H5S_UNLIMITED};
+		ScalarType chunk[2]   = {rows, chunk_length};
+		DataspaceType dataspace = (rank == 2) ? H5Screate_simple(rank, dims, maxdims) : H5Screate_simple(rank, dims + 1, maxdims + 1);
+		hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+		H5Pset_chunk(plist, rank, (rank == 2) ? chunk : chunk + 1);
+		if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0){ //shuffle groups the bytes of the same significance, values of the same chain compress much better
+			H5Pset_shuffle(plist);
+			H5Pset_deflate(plist, 4);
+		}
+		DatasetType dataset = H5Dcreate(file, name.data(), type, dataspace, H5P_DEFAULT, plist, H5P_DEFAULT);
+		H5Pclose(plist);
+		H5Sclose(dataspace);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset for " + name);
+		return dataset;
+	}
+
+	void ResizeChainDataset(DatasetType & dataset, ScalarType const & length)
+	{
+		DataspaceType dataspace = H5Dget_space(dataset);
+		const int rank = H5Sget_simple_extent_ndims(dataspace);
+		ScalarType dims[2];
+		H5Sget_simple_extent_dims(dataspace, dims, NULL);
+		H5Sclose(dataspace);
+		dims[rank-1] = length;
+		if(H5Dset_extent(dataset, dims) < 0)
+			throw std::runtime_error("Error, can not resize the dataset");
+	}
+
+	void ExtendDataset(DatasetType & dataset, DataspaceType & dataspace, ScalarType const & end)
+	{
+		const int rank = H5Sget_simple_extent_ndims(dataspace);
+		ScalarType dims[2];
+		H5Sget_simple_extent_dims(dataspace, dims, NULL);
+		if(dims[rank-1] >= end)
+			return;
+		dims[rank-1] = end;
+		if(H5Dset_extent(dataset, dims) < 0)
+			throw std::runtime_error("Error, the dataset is full and it can not be extended. Only datasets created by CreateChainDataset() can grow");
+		H5Sclose(dataspace);
+		dataspace = H5Dget_space(dataset);
+	}
 	
 	//Takes a bi-dimensional dataset of dimension (p x iter_to_store*n) and adds a column matrix (p x n) starting from position iter
 	void AddMatrix(DatasetType & dataset, MatCol & Mat, unsigned int const & iter) //for Matrices of double (thought for Beta matrices)
@@ -26,6 +78,7 @@ namespace HDF5conversion{
 		H5Sget_simple_extent_dims(dataspace_sub, Dspace_dims, NULL);
 		if(static_cast<ScalarType>(Dspace_dims[0]) != p)
 			throw std::runtime_error("In order to add a (p x n) matrix, the inserted dataset has to have p rows");
+		ExtendDataset(dataset, dataspace_sub, offset[1] + n);
 		//If fine, go on describing the "selection" for that dataspace
 		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, offset, stride, count, block); //define the memory space for the sub matrix (in dataset)
 
@@ -89,6 +142,7 @@ namespace HDF5conversion{
 		int rank = static_cast<int>(H5Sget_simple_extent_ndims(dataspace_sub));
 		if( rank != 1 ) //need to check that the inserted dataset is bi-dimensional (its rank is 2)
 			throw std::runtime_error("It is possible to add a vector only in a one-dimensional dataset");
+		ExtendDataset(dataset, dataspace_sub, offset + p);
 		//If fine, go on describing the "selection" for that dataspace
 		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &offset, &stride, &count, &block); //define the memory space for the sub vector (in dataset)
 
@@ -150,6 +204,7 @@ namespace HDF5conversion{
 		int rank = static_cast<int>(H5Sget_simple_extent_ndims(dataspace_sub));
 		if( rank != 1 ) //need to check that the inserted dataset is bi-dimensional (its rank is 2)
 			throw std::runtime_error("It is possible to add a scalar only in a one-dimensional dataset");
+		ExtendDataset(dataset, dataspace_sub, offset + 1);
 		//If fine, go on describing the "selection" for that dataspace
 		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &offset, &stride, &count, &block); //define the memory space for the sub vector (in dataset)
 
@@ -212,6 +267,7 @@ namespace HDF5conversion{
 		int rank = static_cast<int>(H5Sget_simple_extent_ndims(dataspace_sub));
 		if( rank != 1 ) //need to check that the inserted dataset is bi-dimensional (its rank is 2)
 			throw std::runtime_error("It is possible to add a vector only in a one-dimensional dataset");
+		ExtendDataset(dataset, dataspace_sub, offset + p);
 		//If fine, go on describing the "selection" for that dataspace
 		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &offset, &stride, &count, &block); //define the memory space for the sub vector (in dataset)
 
@@ -256,6 +312,69 @@ namespace HDF5conversion{
 	    return result;
 	}
 
+	std::vector<unsigned int> UnpackGraph(std::vector<unsigned char> const & packed, unsigned int const & n_elem)
+	{
+		std::vector<unsigned int> adj(n_elem);
+		for(unsigned int j = 0; j < n_elem; ++j)
+			adj[j] = (packed[j/8] >> (j%8)) & 1u;
+		return adj;
+	}
+
+	bool IsPackedGraph(DatasetType & dataset)
+	{
+		DataType type = H5Dget_type(dataset);
+		const bool packed = (H5Tget_class(type) == H5T_INTEGER && H5Tget_size(type) == 1);
+		H5Tclose(type);
+		return packed;
+	}
+
+	std::vector<unsigned char> ReadPackedGraphs(DatasetType & dataset, ScalarType const & n_bytes, ScalarType const & first_iter, ScalarType const & n_iter)
+	{
+		std::vector<unsigned char> result(n_bytes*n_iter);
+		ScalarType offset = first_iter*n_bytes;
+		ScalarType count  = 1;
+		ScalarType stride = 1;
+		ScalarType block  = n_bytes*n_iter;
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		if(H5Sget_simple_extent_ndims(dataspace_sub) != 1)
+			throw std::runtime_error("It is possible to read graphs only from a one-dimensional dataset");
+		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &offset, &stride, &count, &block);
+		MemspaceType memspace = H5Screate_simple(1, &block, NULL);
+		status = H5Dread(dataset, H5T_NATIVE_UCHAR, memspace, dataspace_sub, H5P_DEFAULT, result.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error in ReadPackedGraphs(). Can not read from file");
+		return result;
+	}
+
+	void AddPackedGraph(DatasetType & dataset, std::vector<unsigned char> & packed, unsigned int const & iter)
+	{
+		ScalarType n_bytes = static_cast<ScalarType>(packed.size());
+		ScalarType offset = iter*n_bytes; //initial point in complete vector dataset
+		ScalarType count  = 1;
+		ScalarType stride = 1;
+		ScalarType block  = n_bytes;
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		if(H5Sget_simple_extent_ndims(dataspace_sub) != 1)
+			throw std::runtime_error("It is possible to add a graph only in a one-dimensional dataset");
+		ExtendDataset(dataset, dataspace_sub, offset + n_bytes);
+		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &offset, &stride, &count, &block);
+		MemspaceType memspace = H5Screate_simple(1, &n_bytes, NULL);
+		status = H5Dwrite(dataset, H5T_NATIVE_UCHAR, memspace, dataspace_sub, H5P_DEFAULT, packed.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error in AddPackedGraph(). Can not write on file");
+	}
+
+	std::vector<unsigned int> ReadGraph(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & iter)
+	{
+		if(!IsPackedGraph(dataset)) //old files
+			return ReadUintVector(dataset, n_elem, iter);
+		return UnpackGraph(ReadPackedGraphs(dataset, PackedSize(n_elem), iter, 1), n_elem);
+	}
+
 	// Takes a 2-dimnesional dataset (p x stored_iter*n) and extracts the samples values for the spline_index-th coefficients of the curve_index-th curve
 	// In more abstract terms, gets the element in position (spline_index, curve_index) in all the stored_iter matrices that were saved.
 	// spline_index and curve_index are zero-based defined. The first spline is defined by 0 index. The first curve is defined by 0 index
@@ -335,28 +454,195 @@ namespace HDF5conversion{
 		delete [] coord; //check with valgrind, no leak are possible
 		return chain;
 	}
+
+	MatRow GetIterations(DatasetType & dataset, unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter)
+	{
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		const int rank = H5Sget_simple_extent_ndims(dataspace_sub);
+		ScalarType dims[2] = {1, 0}; //a linear dataset is seen as a single row
+		H5Sget_simple_extent_dims(dataspace_sub, (rank == 2) ? dims : dims + 1, NULL);
+		if(stored_iter == 0 || dims[1] % stored_iter != 0 || first_iter + n_iter > stored_iter)
+			throw std::runtime_error("Error in GetIterations(), the requested iterations exceed the dataset dimension");
+		const ScalarType block = dims[1]/stored_iter;
+		//Values are read as they are saved, (rows x n_iter x block)
+		std::vector<double> buffer(dims[0]*n_iter*block);
+		ScalarType start[2] = {0, first_iter*block};
+		ScalarType count[2] = {dims[0], n_iter*block};
+		StatusType status = (rank == 2) ? H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, start, NULL, count, NULL) :
+										  H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, start + 1, NULL, count + 1, NULL);
+		ScalarType n_read = buffer.size();
+		MemspaceType memspace = H5Screate_simple(1, &n_read, NULL);
+		status = H5Dread(dataset, H5T_NATIVE_DOUBLE, memspace, dataspace_sub, H5P_DEFAULT, buffer.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error in GetIterations(), can not read the iterations");
+		MatRow values(n_iter, dims[0]*block);
+		for(ScalarType i = 0; i < dims[0]; ++i)
+			values.middleCols(i*block, block) = Eigen::Map<const MatRow>(buffer.data() + i*n_iter*block, n_iter, block);
+		return values;
+	}
+
+	MatRow GetChains_from_Block(DatasetType & dataset, unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter)
+	{
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		const int rank = H5Sget_simple_extent_ndims(dataspace_sub);
+		ScalarType dims[2] = {1, 0}; //a linear dataset is seen as a single row
+		H5Sget_simple_extent_dims(dataspace_sub, (rank == 2) ? dims : dims + 1, NULL);
+		if(stored_iter == 0 || dims[1] % stored_iter != 0)
+			throw std::runtime_error("Error in GetChains_from_Block(), the length of the dataset is not a multiple of the number of stored iterations");
+		const ScalarType block = dims[1]/stored_iter;
+		if(first + n_elem > dims[0]*block || (rank == 2 && (first % block != 0 || n_elem % block != 0)))
+			throw std::runtime_error("Error in GetChains_from_Block(), the requested chains exceed the dataset dimension or are not made of whole rows");
+		//Values are read as they are saved, (rows x stored_iter x block) for a matrix and (stored_iter x n_elem) for a vector
+		std::vector<double> buffer(static_cast<std::size_t>(n_elem)*stored_iter);
+		StatusType status;
+		if(rank == 2){ //whole rows
+			ScalarType start[2] = {first/block, 0};
+			ScalarType count[2] = {n_elem/block, dims[1]};
+			status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, start, NULL, count, NULL);
+		}
+		else{ //stored_iter blocks of n_elem consecutive values
+			ScalarType start{first}, stride{block}, count{stored_iter}, size{n_elem};
+			status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, &start, &stride, &count, &size);
+		}
+		ScalarType n_read = buffer.size();
+		MemspaceType memspace = H5Screate_simple(1, &n_read, NULL);
+		status = H5Dread(dataset, H5T_NATIVE_DOUBLE, memspace, dataspace_sub, H5P_DEFAULT, buffer.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error in GetChains_from_Block(), can not extract the chains");
+		const ScalarType n_rows = (rank == 2) ? n_elem/block : 1;
+		const ScalarType row_elem = n_elem/n_rows;
+		MatRow chains(n_elem, stored_iter);
+		for(ScalarType i = 0; i < n_rows; ++i)
+			chains.middleRows(i*row_elem, row_elem) = Eigen::Map<const MatRow>(buffer.data() + i*stored_iter*row_elem, stored_iter, row_elem).transpose();
+		return chains;
+	}
+
+	void TransposeChain(FileType & file, std::string const & group, std::string const & name, unsigned int const & stored_iter, ScalarType const & max_bytes,
+						bool const & contiguous)
+	{
+		DatasetType dataset = OpenDataset(file, group + name);
+		DataspaceType dataspace = H5Dget_space(dataset);
+		const int rank = H5Sget_simple_extent_ndims(dataspace);
+		ScalarType dims[2] = {1, 0}; //a linear dataset is seen as a single row
+		H5Sget_simple_extent_dims(dataspace, (rank == 2) ? dims : dims + 1, NULL);
+		H5Sclose(dataspace);
+		if(stored_iter == 0 || dims[1] % stored_iter != 0)
+			throw std::runtime_error("Error in TransposeChain(), the length of " + name + " is not a multiple of the number of stored iterations");
+		const ScalarType rows  = dims[0];
+		const ScalarType block = dims[1]/stored_iter; //elements of each row saved by one iteration
+		const ScalarType n_elem = rows*block;
+		//Chunks hold about chunk_bytes bytes of the chain of one element. The tile covers width iterations, J elements of a row and I rows
+		const ScalarType width = ChunkIterations(sizeof(double), stored_iter);
+		const ScalarType J = std::clamp(max_bytes/(sizeof(double)*width), ScalarType(1), block);
+		const ScalarType I = std::clamp(max_bytes/(sizeof(double)*width*J), ScalarType(1), rows);
+		const std::string name_t(group + ChainMajorName(name));
+		if(H5Lexists(file, name_t.data(), H5P_DEFAULT) > 0)
+			H5Ldelete(file, name_t.data(), H5P_DEFAULT);
+		ScalarType dims_t[2]  = {n_elem, stored_iter};
+		ScalarType chunk_t[2] = {1, width};
+		DataspaceType dataspace_t = H5Screate_simple(2, dims_t, NULL);
+		hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+		if(contiguous){
+			//Allocated at creation, so that its offset in the file is known and fixed, see MappedDataset
+			H5Pset_layout(plist, H5D_CONTIGUOUS);
+			H5Pset_alloc_time(plist, H5D_ALLOC_TIME_EARLY);
+		}
+		else{
+			H5Pset_chunk(plist, 2, chunk_t);
+			if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0){
+				H5Pset_shuffle(plist);
+				H5Pset_deflate(plist, 4);
+			}
+		}
+		DatasetType dataset_t = H5Dcreate(file, name_t.data(), H5T_NATIVE_DOUBLE, dataspace_t, H5P_DEFAULT, plist, H5P_DEFAULT);
+		H5Pclose(plist);
+		if(dataset_t < 0)
+			throw std::runtime_error("Error, can not create dataset for " + name_t);
+		std::vector<double> tile(I*J*width);
+		std::vector<double> tile_t(I*J*width);
+		for(ScalarType i0 = 0; i0 < rows; i0 += I){
+			const ScalarType ni = std::min(I, rows - i0);
+			for(ScalarType j0 = 0; j0 < block; j0 += J){
+				const ScalarType nj = std::min(J, block - j0);
+				for(ScalarType t0 = 0; t0 < stored_iter; t0 += width){
+					const ScalarType nt = std::min(width, stored_iter - t0);
+					//Read ni rows, each one made of nt blocks of nj consecutive elements. The tile is (ni x nt x nj)
+					ScalarType start[2]  = {i0, t0*block + j0};
+					ScalarType stride[2] = {1, block};
+					ScalarType count[2]  = {1, nt};
+					ScalarType size[2]   = {ni, nj};
+					DataspaceType dataspace_sub = H5Dget_space(dataset);
+					StatusType status = (rank == 2) ? H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, start, stride, count, size) :
+													  H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, start + 1, stride + 1, count + 1, size + 1);
+					ScalarType n_read = ni*nt*nj;
+					MemspaceType memspace = H5Screate_simple(1, &n_read, NULL);
+					status = H5Dread(dataset, H5T_NATIVE_DOUBLE, memspace, dataspace_sub, H5P_DEFAULT, tile.data());
+					H5Sclose(memspace);
+					H5Sclose(dataspace_sub);
+					if(status < 0)
+						throw std::runtime_error("Error in TransposeChain(), can not read " + name);
+					//Transpose to (ni x nj x nt), rows of the chain-major dataset
+					for(ScalarType i = 0; i < ni; ++i)
+						for(ScalarType t = 0; t < nt; ++t)
+							for(ScalarType j = 0; j < nj; ++j)
+								tile_t[(i*nj + j)*nt + t] = tile[(i*nt + t)*nj + j];
+					//Write ni blocks of nj rows, row (i,j) is i*block + j
+					ScalarType start_t[2]  = {i0*block + j0, t0};
+					ScalarType stride_t[2] = {block, 1};
+					ScalarType count_t[2]  = {ni, 1};
+					ScalarType size_w[2]   = {nj, nt};
+					status = H5Sselect_hyperslab(dataspace_t, H5S_SELECT_SET, start_t, stride_t, count_t, size_w);
+					memspace = H5Screate_simple(1, &n_read, NULL);
+					status = H5Dwrite(dataset_t, H5T_NATIVE_DOUBLE, memspace, dataspace_t, H5P_DEFAULT, tile_t.data());
+					H5Sclose(memspace);
+					if(status < 0)
+						throw std::runtime_error("Error in TransposeChain(), can not write " + name_t);
+				}
+			}
+		}
+		H5Sclose(dataspace_t);
+		H5Dclose(dataset_t);
+		H5Dclose(dataset);
+	}
+
+	bool HasChainMajor(FileType & file, std::string const & group, std::string const & name)
+	{
+		return H5Lexists(file, (group + ChainMajorName(name)).data(), H5P_DEFAULT) > 0;
+	}
+
+	MatRow GetChains_from_ChainMajor(DatasetType & dataset, unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter)
+	{
+		MatRow chains(n_elem, stored_iter);
+		DataspaceType dataspace_sub = H5Dget_space(dataset);
+		ScalarType dims[2];
+		H5Sget_simple_extent_dims(dataspace_sub, dims, NULL);
+		if(first + n_elem > dims[0] || dims[1] != stored_iter)
+			throw std::runtime_error("Error in GetChains_from_ChainMajor(), the requested chains exceed the dataset dimension");
+		ScalarType start[2] = {first, 0};
+		ScalarType count[2] = {n_elem, stored_iter};
+		StatusType status = H5Sselect_hyperslab(dataspace_sub, H5S_SELECT_SET, start, NULL, count, NULL);
+		ScalarType n_read = count[0]*count[1];
+		MemspaceType memspace = H5Screate_simple(1, &n_read, NULL);
+		status = H5Dread(dataset, H5T_NATIVE_DOUBLE, memspace, dataspace_sub, H5P_DEFAULT, chains.data());
+		H5Sclose(memspace);
+		H5Sclose(dataspace_sub);
+		if(status < 0)
+			throw std::runtime_error("Error in GetChains_from_ChainMajor(), can not extract the chains");
+		return chains;
+	}
 	
 	//Gets a 1-dimension dataset with the stored graphs and returns a tuple with:
 	//map with visited graphs and how many times where visited; Vector with the dimension of the visited graph; number of visited graphs;
 	std::tuple<SampledGraphs, VecCol, int>
-	GetGraphsChain(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & stored_iter)
-	{
-		SampledGraphs SaveG;
-		VecCol GraphSize(VecCol::Zero(stored_iter));
-		int visited{0};
-		for(int i = 0; i < stored_iter; ++i){
-			std::vector<unsigned int> sampledGraph_adj = HDF5conversion::ReadUintVector(dataset, n_elem, i); //Reads the graph from file
-			GraphSize(i) = std::accumulate(sampledGraph_adj.cbegin(), sampledGraph_adj.cend(), 0);
-			auto it = SaveG.find(sampledGraph_adj); //seach if it was already visited
-			if(it == SaveG.end()){ //if not, add
-				SaveG.insert(std::make_pair(sampledGraph_adj, 1));
-				visited++;
-			}
-			else{
-				it->second++;
-			}
-		}
-		return std::make_tuple(SaveG, GraphSize, visited);
+	GetGraphsChain(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & stored_iter, std::size_t const & top_k)
+	{
+		GraphTally tally(n_elem);
+		[[maybe_unused]] auto [GraphSize, links_weight] = TallyGraphsChain(dataset, n_elem, stored_iter, tally);
+		return std::make_tuple(tally.top(top_k), GraphSize, static_cast<int>(tally.size()));
 	}
 
 	/*This function gets a dataset and a std::string. It create an attribute called attribute_name and write the string on it. Do not write more than one string on that attribute. */
@@ -457,12 +743,20 @@ namespace HDF5conversion{
 	GetInfo(std::string const & file_name)
 	{
 		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_info;
-		HDF5conversion::DatasetType dataset_version;
 		//Open file
 		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
 		if(file < 0)
 			throw std::runtime_error("Error in GetInfo(). Can not open the file. The most probable reason is that is was not closed correctly.");
+		auto res = GetInfo(file);
+		H5Fclose(file);
+		return res;
+	}
+
+	std::tuple<std::vector< unsigned int >, std::string >
+	GetInfo(FileType & file)
+	{
+		HDF5conversion::DatasetType dataset_info;
+		HDF5conversion::DatasetType dataset_version;
 		//Open datasets
 		dataset_info  = H5Dopen(file, "/Info", H5P_DEFAULT);
 		if(dataset_info < 0)
@@ -471,7 +765,10 @@ namespace HDF5conversion{
 		if(dataset_version < 0)
 			throw std::runtime_error("Error, can not read what type of sampler was used");
 		
-		std::vector< unsigned int > info(4);
+		//Graphical samplers add the number of performed iterations
+		HDF5conversion::DataspaceType dataspace_info = H5Dget_space(dataset_info);
+		std::vector< unsigned int > info(std::max(H5Sget_simple_extent_npoints(dataspace_info), (hssize_t)4));
+		H5Sclose(dataspace_info);
 		unsigned int * buffer = info.data();
 		HDF5conversion::StatusType status = H5Dread(dataset_info, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer);
 		if(status < 0)
@@ -482,7 +779,6 @@ namespace HDF5conversion{
 		
 		H5Dclose(dataset_info);
 		H5Dclose(dataset_version);
-		H5Fclose(file);
 
 		return std::tie(info, sampler_version);
 	}
@@ -514,4 +810,451 @@ namespace HDF5conversion{
 		return info;
 	}
 
-}
\ No newline at end of file
+	//Name of the group where the k-th chain is stored in a file produced by more than one chain. Chains start counting from 1
+	std::string ChainGroup(unsigned int const & k)
+	{
+		return "/Chain" + std::to_string(k);
+	}
+
+	//Copies the files produced by each chain in groups /Chain1, ... , /ChainK of file_name. /Info and /Sampler of the first chain are also copied in the root group
+	void MergeChains(std::string const & file_name, std::vector<std::string> const & chain_files)
+	{
+		FileType file;
+		file = H5Fcreate(file_name.data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+		if(file < 0)
+			throw std::runtime_error("Error in MergeChains(). Cannot create the file. Delete the old file having the same name or change the name of the new one");
+		StatusType status;
+		for(unsigned int k = 0; k < chain_files.size(); ++k){
+			FileType file_chain = H5Fopen(chain_files[k].data(), H5F_ACC_RDONLY, H5P_DEFAULT);
+			if(file_chain < 0)
+				throw std::runtime_error("Error in MergeChains(). Can not open the file of chain " + std::to_string(k+1));
+			const std::string group_name(ChainGroup(k+1));
+			hid_t group = H5Gcreate(file, group_name.data(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+			if(group < 0)
+				throw std::runtime_error("Error in MergeChains(). Can not create group " + group_name);
+			//Copy all datasets of the root group of the chain file, checkpoints left by older versions are not needed
+			H5G_info_t group_info;
+			status = H5Gget_info(file_chain, &group_info);
+			for(hsize_t i = 0; i < group_info.nlinks; ++i){
+				ssize_t size = H5Lget_name_by_idx(file_chain, ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+				std::string name(size + 1, '\0');
+				H5Lget_name_by_idx(file_chain, ".", H5_INDEX_NAME, H5_ITER_INC, i, &name[0], size + 1, H5P_DEFAULT);
+				name.resize(size);
+				if(name.compare(0, 10, "Checkpoint") == 0)
+					continue;
+				status = H5Ocopy(file_chain, name.data(), group, name.data(), H5P_DEFAULT, H5P_DEFAULT);
+				if(status < 0)
+					throw std::runtime_error("Error in MergeChains(). Can not copy dataset " + name + " of chain " + std::to_string(k+1));
+			}
+			if(k == 0){
+				status = H5Ocopy(file_chain, "/Info", file, "/Info", H5P_DEFAULT, H5P_DEFAULT);
+				if(status < 0)
+					throw std::runtime_error("Error in MergeChains(). Can not copy Info");
+				status = H5Ocopy(file_chain, "/Sampler", file, "/Sampler", H5P_DEFAULT, H5P_DEFAULT);
+				if(status < 0)
+					throw std::runtime_error("Error in MergeChains(). Can not copy Sampler");
+			}
+			H5Gclose(group);
+			H5Fclose(file_chain);
+			const std::string raw_chain(RawChainsName(chain_files[k]));
+			if(std::ifstream(raw_chain).good() && std::rename(raw_chain.data(), RawChainsName(file_name, group_name).data()) != 0)
+				throw std::runtime_error("Error in MergeChains(). Can not rename the raw file of chain " + std::to_string(k+1));
+		}
+		//Save the number of chains
+		unsigned int nchains = chain_files.size();
+		DataspaceType dataspace_nchains = H5Screate(H5S_SCALAR);
+		DatasetType dataset_nchains = H5Dcreate(file, "/NChains", H5T_NATIVE_UINT, dataspace_nchains, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		if(dataset_nchains < 0)
+			throw std::runtime_error("Error in MergeChains(). Can not create dataset for NChains");
+		status = H5Dwrite(dataset_nchains, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &nchains);
+		H5Dclose(dataset_nchains);
+		H5Sclose(dataspace_nchains);
+		H5Fclose(file);
+	}
+
+	std::string RawChainsName(std::string const & file_name, std::string const & group)
+	{
+		std::string base(file_name);
+		if(base.size() > 3 && base.compare(base.size() - 3, 3, ".h5") == 0)
+			base.resize(base.size() - 3);
+		std::string group_name;
+		std::copy_if(group.cbegin(), group.cend(), std::back_inserter(group_name), [](char const & c){return c != '/';});
+		return group_name.empty() ? base + ".chains" : base + "_" + group_name + ".chains";
+	}
+
+	std::string GetFileName(hid_t const & obj)
+	{
+		const ssize_t size = H5Fget_name(obj, NULL, 0);
+		if(size <= 0)
+			return std::string();
+		std::vector<char> name(size + 1, '\0');
+		H5Fget_name(obj, name.data(), name.size());
+		return std::string(name.data());
+	}
+
+	//Number of chains saved in the file. Files produced by a single chain have no /NChains dataset
+	unsigned int GetNChains(std::string const & file_name)
+	{
+		FileType file;
+		file = H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
+		if(file < 0)
+			throw std::runtime_error("Error in GetNChains(). Can not open the file. The most probable reason is that is was not closed correctly.");
+		const unsigned int nchains = GetNChains(file);
+		H5Fclose(file);
+		return nchains;
+	}
+
+	unsigned int GetNChains(FileType & file)
+	{
+		unsigned int nchains{1};
+		if(H5Lexists(file, "/NChains", H5P_DEFAULT) > 0){
+			DatasetType dataset_nchains = H5Dopen(file, "/NChains", H5P_DEFAULT);
+			if(dataset_nchains < 0)
+				throw std::runtime_error("Error, can not open dataset for NChains");
+			StatusType status = H5Dread(dataset_nchains, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &nchains);
+			if(status < 0)
+				throw std::runtime_error("Error, can not read NChains");
+			H5Dclose(dataset_nchains);
+		}
+		return nchains;
+	}
+
+	std::vector<std::string> ChainGroups(unsigned int const & nchains, int const & chain)
+	{
+		if(chain < 0 || chain > static_cast<int>(nchains))
+			throw std::runtime_error("Error, chain has to be 0 (all chains) or between 1 and " + std::to_string(nchains) + ", the number of chains in the file");
+		if(nchains == 1) //Merged files always contain more than one chain
+			return std::vector<std::string>{"/"};
+		std::vector<std::string> groups;
+		if(chain == 0){
+			for(unsigned int k = 1; k <= nchains; ++k)
+				groups.push_back(ChainGroup(k) + "/");
+		}
+		else
+			groups.push_back(ChainGroup(chain) + "/");
+		return groups;
+	}
+
+	//Returns the prefixes of the groups to be read. chain equal to 0 means all the chains, chain equal to k means only the k-th one
+	std::vector<std::string> GetChainGroups(std::string const & file_name, int const & chain)
+	{
+		return ChainGroups(GetNChains(file_name), chain);
+	}
+
+	std::vector<std::string> GetChainGroups(FileType & file, int const & chain)
+	{
+		return ChainGroups(GetNChains(file), chain);
+	}
+
+	//Creates the scalar dataset name in file and writes val in it
+	void WriteScalarDataset(FileType & file, std::string const & name, double const & val)
+	{
+		DataspaceType dataspace = H5Screate(H5S_SCALAR);
+		DatasetType dataset = H5Dcreate(file, name.data(), H5T_NATIVE_DOUBLE, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset " + name);
+		StatusType status = H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &val);
+		if(status < 0)
+			throw std::runtime_error("Error, can not write dataset " + name);
+		H5Dclose(dataset);
+		H5Sclose(dataspace);
+	}
+
+	//Creates the bi-dimensional dataset name in file and writes Mat in it. HDF5 stores row by row, as Mat
+	void WriteMatrixDataset(FileType & file, std::string const & name, MatRow const & Mat)
+	{
+		ScalarType dims[2] = {static_cast<ScalarType>(Mat.rows()), static_cast<ScalarType>(Mat.cols())};
+		DataspaceType dataspace = H5Screate_simple(2, dims, NULL);
+		DatasetType dataset = H5Dcreate(file, name.data(), H5T_NATIVE_DOUBLE, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset " + name);
+		StatusType status = H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, Mat.data());
+		if(status < 0)
+			throw std::runtime_error("Error, can not write dataset " + name);
+		H5Dclose(dataset);
+		H5Sclose(dataspace);
+	}
+
+	//Reads the scalar dataset name of each chain saved in file_name
+	std::vector<double> ReadScalarDataset(std::string const & file_name, std::string const & name)
+	{
+		FileType file;
+		file = H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
+		if(file < 0)
+			throw std::runtime_error("Error in ReadScalarDataset(). Can not open the file. The most probable reason is that is was not closed correctly.");
+		std::vector<double> res = ReadScalarDataset(file, name);
+		H5Fclose(file);
+		return res;
+	}
+
+	std::vector<double> ReadScalarDataset(FileType & file, std::string const & name)
+	{
+		const std::vector<std::string> groups = GetChainGroups(file);
+		std::vector<double> res;
+		for(auto const & group : groups){
+			const std::string path(group + name);
+			if(H5Lexists(file, path.data(), H5P_DEFAULT) <= 0)
+				continue;
+			DatasetType dataset = H5Dopen(file, path.data(), H5P_DEFAULT);
+			if(dataset < 0)
+				throw std::runtime_error("Error, can not open dataset " + path);
+			double val{0};
+			StatusType status = H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &val);
+			if(status < 0)
+				throw std::runtime_error("Error, can not read dataset " + path);
+			H5Dclose(dataset);
+			res.push_back(val);
+		}
+		return res;
+	}
+
+	DatasetType OpenDataset(FileType & file, std::string const & name)
+	{
+		if(H5Lexists(file, name.data(), H5P_DEFAULT) <= 0)
+			throw std::runtime_error("Error, dataset " + name + " is not in the file, the sampling can not be resumed");
+		DatasetType dataset = H5Dopen(file, name.data(), H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not open dataset " + name);
+		return dataset;
+	}
+
+	//Writes size elements of buffer in the one-dimensional dataset name. It is overwritten if it already exists with the same size, otherwise it is created again
+	static void WriteCheckpointEntry(FileType & file, std::string const & name, DataType const & type, void const * buffer, ScalarType const & size)
+	{
+		if(H5Lexists(file, name.data(), H5P_DEFAULT) > 0){
+			DatasetType dataset = H5Dopen(file, name.data(), H5P_DEFAULT);
+			DataspaceType dataspace = H5Dget_space(dataset);
+			const bool same_size(static_cast<ScalarType>(H5Sget_simple_extent_npoints(dataspace)) == size);
+			H5Sclose(dataspace);
+			if(same_size){
+				if(size > 0 && H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
+					throw std::runtime_error("Error, can not write dataset " + name);
+				H5Dclose(dataset);
+				return;
+			}
+			H5Dclose(dataset);
+			H5Ldelete(file, name.data(), H5P_DEFAULT);
+		}
+		DataspaceType dataspace = H5Screate_simple(1, &size, NULL);
+		DatasetType dataset = H5Dcreate(file, name.data(), type, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset " + name);
+		if(size > 0 && H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
+			throw std::runtime_error("Error, can not write dataset " + name);
+		H5Dclose(dataset);
+		H5Sclose(dataspace);
+	}
+
+	void WriteCheckpoint(FileType & file, CheckpointType const & state, std::vector<unsigned char> const & rng_state)
+	{
+		//Select the slot that does not contain the last complete checkpoint
+		unsigned int slot{0};
+		if(H5Lexists(file, "/CheckpointSlot", H5P_DEFAULT) > 0){
+			DatasetType dataset_slot = H5Dopen(file, "/CheckpointSlot", H5P_DEFAULT);
+			H5Dread(dataset_slot, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &slot);
+			H5Dclose(dataset_slot);
+			slot = 1 - slot;
+		}
+		const std::string group_name("/Checkpoint" + std::to_string(slot));
+		if(H5Lexists(file, group_name.data(), H5P_DEFAULT) <= 0){
+			hid_t group = H5Gcreate(file, group_name.data(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+			if(group < 0)
+				throw std::runtime_error("Error, can not create group " + group_name);
+			H5Gclose(group);
+		}
+		for(auto const & [name, values] : state)
+			WriteCheckpointEntry(file, group_name + "/" + name, H5T_NATIVE_DOUBLE, values.data(), values.size());
+		WriteCheckpointEntry(file, group_name + "/RNG", H5T_NATIVE_UCHAR, rng_state.data(), rng_state.size());
+		//The slot is marked as complete only once it is on disk
+		if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+			throw std::runtime_error("Error, can not flush the checkpoint on file");
+		WriteCheckpointEntry(file, "/CheckpointSlot", H5T_NATIVE_UINT, &slot, 1);
+		H5Fflush(file, H5F_SCOPE_GLOBAL);
+	}
+
+	std::tuple<CheckpointType, std::vector<unsigned char>> ReadCheckpoint(FileType & file)
+	{
+		if(H5Lexists(file, "/CheckpointSlot", H5P_DEFAULT) <= 0)
+			throw std::runtime_error("Error, the file has no checkpoint. The sampling can be resumed only if it was run with checkpoint_every > 0");
+		unsigned int slot{0};
+		DatasetType dataset_slot = H5Dopen(file, "/CheckpointSlot", H5P_DEFAULT);
+		if(H5Dread(dataset_slot, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &slot) < 0)
+			throw std::runtime_error("Error, can not read dataset /CheckpointSlot");
+		H5Dclose(dataset_slot);
+		const std::string group_name("/Checkpoint" + std::to_string(slot));
+		hid_t group = H5Gopen(file, group_name.data(), H5P_DEFAULT);
+		if(group < 0)
+			throw std::runtime_error("Error, can not open group " + group_name);
+		H5G_info_t group_info;
+		H5Gget_info(group, &group_info);
+		CheckpointType state;
+		std::vector<unsigned char> rng_state;
+		for(hsize_t i = 0; i < group_info.nlinks; ++i){
+			const ssize_t length = H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+			std::string name(length, '\0');
+			H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i, name.data(), length + 1, H5P_DEFAULT);
+			DatasetType dataset = H5Dopen(group, name.data(), H5P_DEFAULT);
+			if(dataset < 0)
+				throw std::runtime_error("Error, can not open dataset " + group_name + "/" + name);
+			DataspaceType dataspace = H5Dget_space(dataset);
+			const hssize_t size = H5Sget_simple_extent_npoints(dataspace);
+			H5Sclose(dataspace);
+			StatusType status{0};
+			if(name == "RNG"){
+				rng_state.resize(size);
+				if(size > 0)
+					status = H5Dread(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, rng_state.data());
+			}
+			else{
+				std::vector<double> & values = state[name];
+				values.resize(size);
+				if(size > 0)
+					status = H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+			}
+			if(status < 0)
+				throw std::runtime_error("Error, can not read dataset " + group_name + "/" + name);
+			H5Dclose(dataset);
+		}
+		H5Gclose(group);
+		return std::make_tuple(state, rng_state);
+	}
+
+	std::vector<double> const & CheckpointEntry(CheckpointType const & state, std::string const & name, int const & size)
+	{
+		auto it = state.find(name);
+		if(it == state.cend())
+			throw std::runtime_error("Error, " + name + " is missing in the checkpoint");
+		if(size >= 0 && it->second.size() != static_cast<std::size_t>(size))
+			throw std::runtime_error("Error, the size of " + name + " in the checkpoint is not coherent with the sampler");
+		return it->second;
+	}
+
+	hid_t SamplerFileAccess(bool const & live, bool const & resume)
+	{
+		hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+		if(live && H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0){
+			H5Pclose(fapl);
+			throw std::runtime_error("Error, the HDF5 library does not support the format required by SWMR mode");
+		}
+		//Same property set by h5clear, it is not part of the public API but it is registered in every file access property list
+		hbool_t clear_status_flags{true};
+		if(resume && H5Pset(fapl, "clear_status_flags", &clear_status_flags) < 0){
+			H5Pclose(fapl);
+			throw std::runtime_error("Error, the status flags of the file to be resumed can not be cleared. If the sampling was killed, run h5clear -s on the file and resume it again");
+		}
+		return fapl;
+	}
+
+	void StartLiveWriting(FileType & file)
+	{
+		if(H5Fstart_swmr_write(file) < 0)
+			throw std::runtime_error("Error, the file can not be written in SWMR mode. A sampling can be resumed in live mode only if it was run in live mode");
+	}
+
+	void StopLiveWriting(FileType & file, std::string const & file_name)
+	{
+		H5Fclose(file);
+		file = H5Fopen(file_name.data(), H5F_ACC_RDWR, H5P_DEFAULT);
+		if(file < 0)
+			throw std::runtime_error("Error, can not open again the file " + file_name + " to write the summaries of the sampling");
+		if(H5Lexists(file, "/Progress", H5P_DEFAULT) > 0)
+			H5Ldelete(file, "/Progress", H5P_DEFAULT);
+	}
+
+	FileType OpenLiveFile(std::string const & file_name)
+	{
+		FileType file;
+		H5E_BEGIN_TRY{ //fails if the file was not written in live mode
+			file = H5Fopen(file_name.data(), H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, H5P_DEFAULT);
+		} H5E_END_TRY;
+		if(file < 0)
+			file = H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT);
+		return file;
+	}
+
+	DatasetType OpenProgress(FileType & file, bool const & live, bool const & resume)
+	{
+		const bool exists(resume && H5Lexists(file, "/Progress", H5P_DEFAULT) > 0);
+		if(!live){
+			if(exists) //it would hide the iterations saved from now on
+				H5Ldelete(file, "/Progress", H5P_DEFAULT);
+			return -1;
+		}
+		if(exists)
+			return OpenDataset(file, "/Progress");
+		ScalarType size = 3;
+		DataspaceType dataspace = H5Screate_simple(1, &size, NULL);
+		DatasetType dataset = H5Dcreate(file, "/Progress", H5T_NATIVE_UINT, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		H5Sclose(dataspace);
+		if(dataset < 0)
+			throw std::runtime_error("Error, can not create dataset for Progress");
+		WriteProgress(dataset, {0, 0, 0});
+		return dataset;
+	}
+
+	void WriteProgress(DatasetType & dataset, std::vector<unsigned int> const & progress)
+	{
+		if(progress.size() != 3)
+			throw std::runtime_error("Error, Progress has to contain three values");
+		if(H5Dwrite(dataset, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, progress.data()) < 0 || H5Dflush(dataset) < 0)
+			throw std::runtime_error("Error, can not write dataset Progress");
+	}
+
+	std::vector<unsigned int> ReadProgress(FileType & file)
+	{
+		if(H5Lexists(file, "/Progress", H5P_DEFAULT) <= 0)
+			return std::vector<unsigned int>();
+		DatasetType dataset = H5Dopen(file, "/Progress", H5P_DEFAULT);
+		std::vector<unsigned int> progress(3, 0);
+		const StatusType status = (dataset < 0) ? -1 : H5Dread(dataset, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, progress.data());
+		if(dataset >= 0)
+			H5Dclose(dataset);
+		if(status < 0)
+			throw std::runtime_error("Error, can not read dataset Progress");
+		return progress;
+	}
+
+	std::string CheckpointFileName(std::string const & file_name)
+	{
+		std::string base(file_name);
+		if(base.size() > 3 && base.compare(base.size() - 3, 3, ".h5") == 0)
+			base.resize(base.size() - 3);
+		return base + ".checkpoint";
+	}
+
+	FileType OpenCheckpointFile(FileType & file, std::string const & file_name, bool const & live, bool const & resume)
+	{
+		const std::string name(CheckpointFileName(file_name));
+		if(resume && std::ifstream(name).good()){
+			FileType checkpoint_file = H5Fopen(name.data(), H5F_ACC_RDWR, H5P_DEFAULT);
+			if(checkpoint_file < 0)
+				throw std::runtime_error("Cannot open the file of the checkpoints " + name);
+			return checkpoint_file;
+		}
+		if(!live)
+			return file;
+		if(resume)
+			throw std::runtime_error("Error, " + name + " is missing. A sampling can be resumed in live mode only if it was run in live mode");
+		FileType checkpoint_file = H5Fcreate(name.data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+		if(checkpoint_file < 0)
+			throw std::runtime_error("Cannot create the file of the checkpoints " + name);
+		return checkpoint_file;
+	}
+
+	void CloseCheckpointFile(FileType & checkpoint_file, FileType & file, std::string const & file_name, bool const & completed)
+	{
+		if(checkpoint_file == file){
+			if(completed){
+				for(const char * name : {"/Checkpoint0", "/Checkpoint1", "/CheckpointSlot"})
+					if(H5Lexists(file, name, H5P_DEFAULT) > 0 && H5Ldelete(file, name, H5P_DEFAULT) < 0)
+						throw std::runtime_error(std::string("Error, can not delete ") + name);
+			}
+			return;
+		}
+		H5Fclose(checkpoint_file);
+		checkpoint_file = file;
+		if(completed)
+			std::remove(CheckpointFileName(file_name).data());
+	}
+
+}
@@ -14,8 +14,12 @@
 * (p x n) matrix every time. This is done with AddMatrix() function. For what concern vectors, a lineat dataset of length (p * iter_to_store) is created and filled every time with p-dimensional 
 * vectors via AddVector() function. Finally, scalars are stored in a one-dimensional dataset of length iter_to_store by means of AddScalar() function.
 * Each add method has its Read version that performs the inverse operation.
-* In order to store graphs, use AddUintVector() functions, which stores the upper triangular part in a linear dataset. All graphs are saved, once the sampling is done, use GetGraphsChain() function 
-* to create an stl container with all the sampled graphs and the number of times they were visited.
+* Datasets of the chains are created by CreateChainDataset(). They are chunked, compressed with the shuffle and deflate filters and their last dimension is unlimited,
+* Add functions extend them if a value is written beyond their current size. 
+* In order to store graphs, use AddPackedGraph() function, which stores the upper triangular part in a linear dataset of bytes, one bit per possible link. All graphs are saved, 
+* once the sampling is done, use GetGraphsChain() function to create an stl container with all the sampled graphs and the number of times they were visited.
+* Visited graphs are counted in a hash table keyed by their packed representation, see GraphTally.h.
+* Files generated by older versions store one unsigned int per link (AddUintVector()), ReadGraph() and GetGraphsChain() read both formats.
 * Do not get tricked by notation, AddVector() function works for vector of every size, not only for vector of size p where p is the number of basis.
 *
 * WARNING: This file is not general at all. It only works the specified types, which are indeed the one used in the sampling. For example, it is possible to add only ColumnMajor, dynamic, 
@@ -40,6 +44,24 @@ namespace HDF5conversion{
 	using VecRow   		= Eigen::RowVectorXd;
 	using SampledGraphs = std::map< std::vector<unsigned int>, int>;
 
+	//Creates the dataset name for the chain of a parameter, each iteration adds block elements of type. The dataset is one-dimensional of length block*iter_to_store
+	//if rows is 0, otherwise it is (rows x block*iter_to_store). Chunks contain the values of a whole number of iterations, about chunk_bytes bytes, so that they 
+	//fit in the default chunk cache of HDF5 while they are filled.
+	DatasetType CreateChainDataset(FileType & file, std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store, 
+								   ScalarType const & rows = 0);
+	inline constexpr ScalarType chunk_bytes{262144};
+
+	//Number of iterations in a chunk of about chunk_bytes bytes, iter_bytes are written by each iteration. It is between 1 and iter_to_store
+	inline ScalarType ChunkIterations(ScalarType const & iter_bytes, unsigned int const & iter_to_store){
+		return std::clamp(chunk_bytes/std::max(iter_bytes, ScalarType(1)), ScalarType(1), std::max(static_cast<ScalarType>(iter_to_store), ScalarType(1)));
+	}
+
+	//Sets the length of the last dimension of a dataset created by CreateChainDataset(). Used to drop the unused tail when the sampling stops early
+	void ResizeChainDataset(DatasetType & dataset, ScalarType const & length);
+
+	//Extends the last dimension of dataset if it is shorter than end, dataspace is updated. Used by all Add functions
+	void ExtendDataset(DatasetType & dataset, DataspaceType & dataspace, ScalarType const & end);
+
 	//Takes a bi-dimensional dataset of dimension (p x iter_to_store*n) and adds a column matrix (p x n) starting from position iter
 	void AddMatrix(DatasetType & dataset, MatCol & Mat, unsigned int const & iter); //for Matrices of double (thought for Beta matrices)
 	
@@ -64,6 +86,37 @@ namespace HDF5conversion{
 	//Takes a linear dataset of dimension (p*iter_to_store) and read a p-dimensional vector starting from position iter
 	std::vector<unsigned int> ReadUintVector(DatasetType & dataset, unsigned int const & p, unsigned int const & iter);
 
+	//Number of bytes needed to store a graph with n_elem possible links, one bit each
+	inline ScalarType PackedSize(unsigned int const & n_elem){
+		return (static_cast<ScalarType>(n_elem) + 7)/8;
+	}
+
+	//Packs the adjacency list of a graph, the j-th link is the (j%8)-th least significant bit of the (j/8)-th byte
+	template<typename T>
+	std::vector<unsigned char> PackGraph(std::vector<T> const & adj)
+	{
+		std::vector<unsigned char> packed(PackedSize(adj.size()), 0);
+		for(std::size_t j = 0; j < adj.size(); ++j)
+			if(adj[j])
+				packed[j/8] |= static_cast<unsigned char>(1u << (j%8));
+		return packed;
+	}
+
+	//Inverse of PackGraph(), n_elem is the number of possible links
+	std::vector<unsigned int> UnpackGraph(std::vector<unsigned char> const & packed, unsigned int const & n_elem);
+
+	//True if dataset stores bit-packed graphs, false if it stores one unsigned int per link
+	bool IsPackedGraph(DatasetType & dataset);
+
+	//Takes a linear dataset of bytes, created with type H5T_NATIVE_UCHAR and block PackedSize(n_elem), and adds a packed graph in position iter
+	void AddPackedGraph(DatasetType & dataset, std::vector<unsigned char> & packed, unsigned int const & iter);
+
+	//Reads n_iter consecutive packed graphs starting from first_iter, each one of n_bytes bytes
+	std::vector<unsigned char> ReadPackedGraphs(DatasetType & dataset, ScalarType const & n_bytes, ScalarType const & first_iter, ScalarType const & n_iter);
+
+	//Reads the iter-th graph of a dataset of graphs with n_elem possible links. Both packed and unsigned int datasets are accepted
+	std::vector<unsigned int> ReadGraph(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & iter);
+
 	// Takes a 2-dimnesional dataset (p x stored_iter*n) and extracts the samples values for the spline_index-th coefficients of the curve_index-th curve
 	// In more abstract terms, gets the element in position (spline_index, curve_index) in all the stored_iter matrices that were saved.
 	// spline_index and curve_index are zero-based defined. The first spline is defined by 0 index. The first curve is defined by 0 index
@@ -74,10 +127,33 @@ namespace HDF5conversion{
 	// index is zero-based defined. The first element is defined by 0 index
 	std::vector<double> GetChain_from_Vector(DataspaceType & dataset, unsigned int const & index, unsigned int const & stored_iter, unsigned int const & p);
 
+	//Reads n_iter consecutive iterations, starting from first_iter, of a chain dataset saved iteration by iteration, by a single selection. Returns a (n_iter x n_elem)
+	//matrix whose rows are the saved values. Element (i,j) of a (p x stored_iter*n) dataset is the column i*n + j
+	MatRow GetIterations(DatasetType & dataset, unsigned int const & first_iter, unsigned int const & n_iter, unsigned int const & stored_iter);
+
+	//Reads the chains of n_elem consecutive elements, starting from first, from a chain dataset saved iteration by iteration, by a single strided selection.
+	//Element (i,j) of a (p x stored_iter*n) dataset has index i*n + j, the block has to be made of whole rows. Returns a (n_elem x stored_iter) matrix
+	MatRow GetChains_from_Block(DatasetType & dataset, unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter);
+
+	//Writes in group a chain-major copy of the chain dataset name, called ChainMajorName(name). It is (n_elem x stored_iter), the chain of each element is a contiguous
+	//row, hence it is read sequentially instead of by stored_iter scattered points. Elements are numbered as in the original dataset, the (i,j) element of 
+	//a (p x stored_iter*n) dataset is the row i*n + j. The transposition is done by tiles of at most max_bytes bytes, the memory does not depend on stored_iter.
+	//If contiguous, the copy is neither chunked nor compressed, so that it can be memory mapped by MappedDataset, otherwise it is chunked by rows and compressed
+	void TransposeChain(FileType & file, std::string const & group, std::string const & name, unsigned int const & stored_iter, ScalarType const & max_bytes = 67108864,
+						bool const & contiguous = false);
+	inline std::string ChainMajorName(std::string const & name){
+		return "ChainMajor" + name;
+	}
+	//True if group contains the chain-major copy of name
+	bool HasChainMajor(FileType & file, std::string const & group, std::string const & name);
+	//Reads the chains of n_elem consecutive elements, starting from first, from a dataset written by TransposeChain(). Returns a (n_elem x stored_iter) matrix
+	MatRow GetChains_from_ChainMajor(DatasetType & dataset, unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter);
+
 	//Gets a 1-dimension dataset with the stored graphs and returns a tuple with:
 	//map with visited graphs and how many times where visited; Vector with the dimension of the visited graph; number of visited graphs;
+	//If top_k is positive, the map only contains the top_k most visited graphs while the number of visited graphs still counts all of them. See TallyGraphsChain()
 	std::tuple<SampledGraphs, VecCol, int>
-	GetGraphsChain(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & stored_iter);
+	GetGraphsChain(DatasetType & dataset, unsigned int const & n_elem, unsigned int const & stored_iter, std::size_t const & top_k = 0);
 
 	/*This function gets a dataset and a std::string. It create an attribute called attribute_name and write the string on it. Do not write more than one string on that attribute. */
 	void WriteString(DatasetType & dataset, std::string const & str, std::string const & attribute_name = "Attribute");
@@ -87,10 +163,99 @@ namespace HDF5conversion{
 
 	//Return vector with information needed to read the file. They are p, n, iter_to_store, iter_to_storeG
 	std::tuple<std::vector< unsigned int >, std::string > GetInfo(std::string const & file_name);
+	//As above, for a file that is already open
+	std::tuple<std::vector< unsigned int >, std::string > GetInfo(FileType & file);
 
 	//Do not delete, needed to open old files
 	std::vector< unsigned int >
 	GetInfo_old(std::string const & file_name);
+
+	//HDF5 library is not thread safe. Chains running concurrently serialize their calls by means of this mutex
+	inline std::mutex h5_mutex;
+
+	//Name of the group where the k-th chain is stored in a file produced by more than one chain. Chains start counting from 1
+	std::string ChainGroup(unsigned int const & k);
+
+	//Copies the files produced by each chain in groups /Chain1, ... , /ChainK of file_name. /Info and /Sampler of the first chain are also copied in the root group, 
+	//so that GetInfo() works on merged files. The number of chains is saved in /NChains dataset. Raw files of the chains (see RawChainWriter) are renamed
+	//after the groups
+	void MergeChains(std::string const & file_name, std::vector<std::string> const & chain_files);
+
+	//Name of the raw file with the chains saved in group of file_name, see RawChainWriter. It is file_name with extension .chains, merged chains append their group
+	std::string RawChainsName(std::string const & file_name, std::string const & group = "/");
+	//Name of the file that contains the HDF5 object obj
+	std::string GetFileName(hid_t const & obj);
+
+	//Number of chains saved in the file. Files produced by a single chain have no /NChains dataset
+	unsigned int GetNChains(std::string const & file_name);
+	unsigned int GetNChains(FileType & file);
+
+	//Returns the prefixes of the groups to be read. chain equal to 0 means all the chains, chain equal to k means only the k-th one. 
+	//Files produced by a single chain have datasets in the root group, "/" is returned
+	std::vector<std::string> GetChainGroups(std::string const & file_name, int const & chain = 0);
+	std::vector<std::string> GetChainGroups(FileType & file, int const & chain = 0);
+	//As GetChainGroups(), given the number of chains in the file
+	std::vector<std::string> ChainGroups(unsigned int const & nchains, int const & chain = 0);
+
+	//Creates the scalar dataset name in file and writes val in it. Used for quantities that are saved only once, at the end of the sampling
+	void WriteScalarDataset(FileType & file, std::string const & name, double const & val);
+
+	//Creates the bi-dimensional dataset name in file, having the same dimension of Mat, and writes Mat in it
+	void WriteMatrixDataset(FileType & file, std::string const & name, MatRow const & Mat);
+
+	//Reads the scalar dataset name (without leading "/") of each chain saved in file_name. The returned vector is empty if the dataset is not in the file
+	std::vector<double> ReadScalarDataset(std::string const & file_name, std::string const & name);
+	std::vector<double> ReadScalarDataset(FileType & file, std::string const & name);
+
+	//State of a sampler saved in a checkpoint. Each quantity is flattened in a vector of double and identified by its name
+	using CheckpointType = std::map<std::string, std::vector<double>>;
+
+	//Opens the existing dataset name in file. Used to resume a sampling in the datasets created by the interrupted run
+	DatasetType OpenDataset(FileType & file, std::string const & name);
+
+	//Saves the state of the sampler and of its random engine. Two slots, /Checkpoint0 and /Checkpoint1, are used alternately. /CheckpointSlot, the index of the 
+	//last complete slot, is written only after the slot has been flushed on disk, hence a crash during the write leaves the previous checkpoint readable
+	void WriteCheckpoint(FileType & file, CheckpointType const & state, std::vector<unsigned char> const & rng_state);
+
+	//Reads the last complete checkpoint saved in file. Throws if the file has no checkpoint
+	std::tuple<CheckpointType, std::vector<unsigned char>> ReadCheckpoint(FileType & file);
+
+	//Returns the quantity name of a checkpoint. Throws if it is missing or if size is non negative and different from its length
+	std::vector<double> const & CheckpointEntry(CheckpointType const & state, std::string const & name, int const & size = -1);
+
+	//Live monitoring. A sampler in live mode writes its file in SWMR mode (single writer, multiple readers), so that the values saved so far can be read while
+	//the sampling runs, see OpenLiveFile(). Objects can not be added to a file in SWMR mode, hence all datasets are created before StartLiveWriting(), the
+	//checkpoints are written in a separate file (see OpenCheckpointFile()) and the summaries are written after StopLiveWriting(). Values become visible to the
+	//readers at the cadence chosen by the sampler, see ChainWriter::publish(), and /Progress holds how many of them can be read.
+
+	//File access property list of the file written by a sampler. In live mode, the file uses the latest format, as required by SWMR. It has to be closed.
+	//If resume, the status flags of the file are cleared when it is opened, as h5clear -s does. A file in SWMR mode keeps them set until it is closed,
+	//hence they are still set if the sampler was killed and the file could not be opened otherwise
+	hid_t SamplerFileAccess(bool const & live, bool const & resume = false);
+	//Switches file to SWMR mode. Throws if the file was not created in live mode
+	void StartLiveWriting(FileType & file);
+	//Closes file, written in SWMR mode, and opens it again as usual. /Progress is removed, /Info is up to date once the sampling is over
+	void StopLiveWriting(FileType & file, std::string const & file_name);
+	//Opens file_name in read only mode, as a reader of a file written in SWMR mode if it is possible. Returns a negative value if it can not be opened
+	FileType OpenLiveFile(std::string const & file_name);
+
+	//Dataset /Progress of a sampling in live mode, created or opened if resume. It holds the number of saved iterations, the number of saved iterations of the 
+	//graphs and the number of performed iterations, as they can be read by now. If live is false, -1 is returned and the /Progress left by a previous sampling 
+	//in live mode is removed
+	DatasetType OpenProgress(FileType & file, bool const & live, bool const & resume);
+	//Writes progress in dataset and flushes it, so that the readers see it
+	void WriteProgress(DatasetType & dataset, std::vector<unsigned int> const & progress);
+	//Content of /Progress, empty if the file has none
+	std::vector<unsigned int> ReadProgress(FileType & file);
+
+	//Name of the file with the checkpoints of a sampling in live mode. It is file_name with extension .checkpoint
+	std::string CheckpointFileName(std::string const & file_name);
+	//File where the checkpoints of the sampler that writes file are saved. It is file itself, unless the sampling is in live mode or it resumes checkpoints 
+	//that were saved apart. In that case CheckpointFileName(file_name) is opened, or created
+	FileType OpenCheckpointFile(FileType & file, std::string const & file_name, bool const & live, bool const & resume);
+	//Closes the checkpoint file, if it is not file. If completed, the checkpoints are not needed anymore: their file is removed or, if they are saved in file,
+	//their datasets are deleted
+	void CloseCheckpointFile(FileType & checkpoint_file, FileType & file, std::string const & file_name, bool const & completed);
 	
 }
 
@@ -0,0 +1,111 @@
+#include "MappedDataset.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace HDF5conversion{
+
+	//True if the values of dataset are stored in the file as they are in memory, i.e contiguous, without filters and as native double
+	static bool Mappable(DatasetType & dataset)
+	{
+		hid_t plist = H5Dget_create_plist(dataset);
+		const bool plain = (H5Pget_layout(plist) == H5D_CONTIGUOUS && H5Pget_nfilters(plist) == 0);
+		H5Pclose(plist);
+		DataType type = H5Dget_type(dataset);
+		const bool native = (H5Tequal(type, H5T_NATIVE_DOUBLE) > 0);
+		H5Tclose(type);
+		//Offsets are in the file only for the default driver
+		FileType file = H5Iget_file_id(dataset);
+		hid_t fapl = H5Fget_access_plist(file);
+		const bool sec2 = (H5Pget_driver(fapl) == H5FD_SEC2);
+		H5Pclose(fapl);
+		H5Fclose(file);
+		return plain && native && sec2;
+	}
+
+	MappedDataset::MappedDataset(DatasetType & dataset)
+	{
+#ifndef _WIN32
+		DataspaceType dataspace = H5Dget_space(dataset);
+		const int rank = H5Sget_simple_extent_ndims(dataspace);
+		ScalarType dims[2] = {0, 0};
+		if(rank == 2)
+			H5Sget_simple_extent_dims(dataspace, dims, NULL);
+		H5Sclose(dataspace);
+		if(rank != 2 || dims[0]*dims[1] == 0 || !Mappable(dataset))
+			return;
+		const haddr_t offset = H5Dget_offset(dataset);
+		if(offset == HADDR_UNDEF || offset % alignof(double) != 0)
+			return;
+		const std::string file_name(GetFileName(dataset));
+		if(file_name.empty())
+			return;
+		const std::size_t bytes = sizeof(double)*dims[0]*dims[1];
+		const std::size_t page = sysconf(_SC_PAGESIZE);
+		const std::size_t shift = offset % page;
+		int fd = open(file_name.data(), O_RDONLY);
+		if(fd < 0)
+			return;
+		struct stat file_stat;
+		if(fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < offset + bytes){
+			::close(fd);
+			return;
+		}
+		void * addr = mmap(NULL, shift + bytes, PROT_READ, MAP_SHARED, fd, offset - shift);
+		::close(fd); //the map keeps the file referenced
+		if(addr == MAP_FAILED)
+			return;
+		madvise(addr, shift + bytes, MADV_SEQUENTIAL);
+		base = addr;
+		length = shift + bytes;
+		values = reinterpret_cast<double const *>(static_cast<char const *>(addr) + shift);
+		n_rows = dims[0];
+		n_cols = dims[1];
+#endif
+	}
+
+	MappedDataset::MappedDataset(MappedDataset && other) noexcept:
+		base(other.base), length(other.length), values(other.values), n_rows(other.n_rows), n_cols(other.n_cols)
+	{
+		other.base = nullptr;
+		other.length = 0;
+		other.values = nullptr;
+	}
+
+	MappedDataset & MappedDataset::operator=(MappedDataset && other) noexcept
+	{
+		if(this != &other){
+			release();
+			std::swap(base, other.base);
+			std::swap(length, other.length);
+			std::swap(values, other.values);
+			n_rows = other.n_rows;
+			n_cols = other.n_cols;
+		}
+		return *this;
+	}
+
+	void MappedDataset::release()
+	{
+#ifndef _WIN32
+		if(base != nullptr)
+			munmap(base, length);
+#endif
+		base = nullptr;
+		length = 0;
+		values = nullptr;
+		n_rows = 0;
+		n_cols = 0;
+	}
+
+	Eigen::Map<const MatRow> MappedDataset::middle_rows(ScalarType const & first, ScalarType const & n) const
+	{
+		if(!is_mapped() || first + n > n_rows)
+			throw std::runtime_error("Error in MappedDataset, the requested rows are not mapped");
+		return Eigen::Map<const MatRow>(values + first*n_cols, n, n_cols);
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef __MAPPEDDATASET_HPP__
+#define __MAPPEDDATASET_HPP__
+
+#include "HDF5conversion.h"
+
+/*
+	Read only memory map of a bi-dimensional dataset of double, e.g the chain-major copies written by TransposeChain() with contiguous set. The offset of the
+	values in the file is obtained by H5Dget_offset() and the file is mapped from there, hence the rows of the dataset are read from the page cache through
+	Eigen::Map views, without copies in a buffer and without the selections of H5Dread().
+	Only datasets stored contiguously, without filters and as native double can be mapped, the file has to be opened with the default (sec2) driver.
+	Otherwise, and on Windows, is_mapped() is false and the dataset has to be read by H5Dread().
+	The map is a snapshot of the file, it has to be released before the dataset is modified or deleted.
+*/
+
+namespace HDF5conversion{
+
+	class MappedDataset{
+		public:
+		MappedDataset() = default;
+		//Maps dataset if possible, it can be closed afterwards
+		MappedDataset(DatasetType & dataset);
+		~MappedDataset(){
+			release();
+		}
+		MappedDataset(MappedDataset const &) = delete;
+		MappedDataset & operator=(MappedDataset const &) = delete;
+		MappedDataset(MappedDataset && other) noexcept;
+		MappedDataset & operator=(MappedDataset && other) noexcept;
+		void release();
+		inline bool is_mapped() const{
+			return values != nullptr;
+		}
+		inline ScalarType rows() const{
+			return n_rows;
+		}
+		inline ScalarType cols() const{
+			return n_cols;
+		}
+		//Rows from first to first + n - 1, the dataset has to be mapped
+		Eigen::Map<const MatRow> middle_rows(ScalarType const & first, ScalarType const & n) const;
+		private:
+		void * base{nullptr};   //start of the mapped pages
+		std::size_t length{0};  //length of the mapped pages
+		double const * values{nullptr};
+		ScalarType n_rows{0};
+		ScalarType n_cols{0};
+	};
+}
+
+#endif
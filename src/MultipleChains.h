@@ -0,0 +1,188 @@
+#ifndef __MULTIPLECHAINS_HPP__
+#define __MULTIPLECHAINS_HPP__
+
+#include "include_headers.h"
+#include "GSLwrappers.h"
+#include "HDF5conversion.h"
+#include "ConvergenceDiagnostics.h"
+#include <condition_variable>
+
+/*
+	Independent chains are run concurrently, one per thread. Each chain is a different sampler object with its own random engine, seeded with a stream
+	generated from the seed of the call, and it writes its own file. Once all of them are done, files are merged in a single one where the k-th chain is
+	stored in group /ChainK, see HDF5conversion::MergeChains(). Calls to HDF5 library are serialized by means of HDF5conversion::h5_mutex.
+	Only the master thread is allowed to interact with R, it is the only one that checks for user interruptions. Other chains are notified through a shared flag.
+	Convergence diagnostics are checked every check_every iterations after burn-in and they are pooled among chains by a shared ConvergenceMonitor.
+*/
+
+//Collects the diagnostics of all chains at each check and decides whether they have to stop. The decision taken at check j is applied by all chains at check j+1,
+//so that all of them stop at the same iteration and a chain has to wait only for the slowest one to reach the previous check. The decision does not depend on the threads.
+class ConvergenceMonitor{
+	public:
+	ConvergenceMonitor(unsigned int const & _nchains = 1):nchains(_nchains), snapshots(_nchains){}
+	//Called by chain k at its j-th check, j starts from 0. series are the monitored scalars of the chain. Returns true if the chain has to stop now, i.e if at check j-1 
+	//the total effective sample size of all scalars was at least target_ess and their split-Rhat at most target_rhat. Never stops if target_ess is not positive.
+	bool check(unsigned int const & k, unsigned int const & j, std::vector<diagnostics::BatchMeans> const & series, double const & target_ess, double const & target_rhat,
+			   std::atomic<bool> const & stop);
+	//Total effective sample size and split-Rhat of each scalar at the last check that all chains reached
+	std::tuple<std::vector<double>, std::vector<double>> get_diagnostics() const{
+		std::lock_guard<std::mutex> lock(mtx);
+		return std::make_tuple(ess, rhat);
+	}
+	private:
+	unsigned int nchains;
+	std::vector<std::vector<diagnostics::BatchMeans>> snapshots; //series of each chain at the current check
+	unsigned int posted{0}; //number of chains that reached the current check
+	int decided_check{-1};  //last check reached by all chains
+	bool converged{false};  //decision taken at decided_check
+	std::vector<double> ess;
+	std::vector<double> rhat;
+	mutable std::mutex mtx;
+	std::condition_variable cv;
+};
+
+inline bool ConvergenceMonitor::check(unsigned int const & k, unsigned int const & j, std::vector<diagnostics::BatchMeans> const & series, double const & target_ess, 
+									  double const & target_rhat, std::atomic<bool> const & stop)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	//Wait for the slower chains to reach the previous check. stop is not notified, it is polled
+	while(decided_check < static_cast<int>(j) - 1 && !stop.load())
+		cv.wait_for(lock, std::chrono::milliseconds(100));
+	if(stop.load())
+		return false;
+	if(j > 0 && converged)
+		return true;
+	snapshots[k] = series;
+	if(++posted == nchains){
+		std::tie(ess, rhat) = diagnostics::compute(snapshots);
+		converged = target_ess > 0 && std::all_of(ess.cbegin(), ess.cend(), [&target_ess](double const & x){return x >= target_ess;}) &&
+								  	  std::all_of(rhat.cbegin(), rhat.cend(), [&target_rhat](double const & x){return x <= target_rhat;});
+		decided_check = j;
+		posted = 0;
+		cv.notify_all();
+	}
+	return false;
+}
+
+//Tells a sampler whether it is allowed to interact with R and whether it has to stop
+class ChainControl{
+	public:
+	ChainControl() = default;
+	ChainControl(bool const & _main_chain, std::shared_ptr<std::atomic<bool>> const & _stop, unsigned int const & _chain = 0, 
+				 std::shared_ptr<ConvergenceMonitor> const & _monitor = std::make_shared<ConvergenceMonitor>(1)):
+				 main_chain(_main_chain), chain(_chain), stop(_stop), monitor(_monitor){}
+	//Returns true if the execution has to be stopped, i.e if the user interrupted it or if another chain failed
+	bool interrupted() const{
+		if(main_chain){
+			try{
+				Rcpp::checkUserInterrupt();
+			}
+			catch(Rcpp::internal::InterruptedException e){
+				stop->store(true);
+			}
+		}
+		return stop->load();
+	}
+	inline bool is_main() const{
+		return main_chain;
+	}
+	//Has to be called every check_every iterations after burn-in, n_check counts the calls. Returns true if the sampling has to stop, see ConvergenceMonitor::check()
+	bool converged(unsigned int const & n_check, std::vector<diagnostics::BatchMeans> const & series, double const & target_ess, double const & target_rhat) const{
+		return monitor->check(chain, n_check, series, target_ess, target_rhat, *stop);
+	}
+	std::tuple<std::vector<double>, std::vector<double>> get_diagnostics() const{
+		return monitor->get_diagnostics();
+	}
+	private:
+	bool main_chain{true};
+	unsigned int chain{0};
+	std::shared_ptr<std::atomic<bool>> stop{std::make_shared<std::atomic<bool>>(false)};
+	std::shared_ptr<ConvergenceMonitor> monitor{std::make_shared<ConvergenceMonitor>(1)};
+};
+
+namespace chains{
+
+	//Name of the file (without extension) written by the k-th chain before merging. Chains start counting from 1
+	inline std::string chain_file_name(std::string const & file_name, unsigned int const & k){
+		return file_name + "_Chain" + std::to_string(k);
+	}
+
+	//Runs nchains samplers concurrently. build(file_name, seed, print_bar) has to return a sampler having set_control() and run() methods.
+	//Samplers own a GSL_RNG, they can not be copied. build has to construct the sampler in its return statement, so that copy elision applies.
+	//It returns the value returned by run() for each chain, it is negative for the chains that were interrupted. In that case no file is left, unless keep_files
+	//is true: files of the chains are kept so that they can be resumed from their last checkpoint.
+	//file_name has no extension. If nchains is 1, the sampler is run as usual, with the given seed and writing directly file_name.
+	template<class SamplerBuilder>
+	std::vector<int> run_chains(std::string const & file_name, unsigned int const & nchains, unsigned int const & seed, bool const & print_bar, SamplerBuilder && build,
+								bool const & keep_files = false)
+	{
+		if(nchains <= 1){
+			auto Sampler = build(file_name, seed, print_bar);
+			return std::vector<int>{Sampler.run()};
+		}
+		const unsigned int base_seed(sample::GSL_RNG(seed).get_seed()); //seed equal to 0 means random seed
+		std::vector<int> results(nchains, -1);
+		std::vector<std::exception_ptr> errors(nchains);
+		auto stop = std::make_shared<std::atomic<bool>>(false);
+		auto monitor = std::make_shared<ConvergenceMonitor>(nchains);
+
+		#pragma omp parallel for num_threads(nchains) schedule(static,1)
+		for(unsigned int k = 0; k < nchains; ++k){
+			try{
+				bool main_thread{true};
+				#ifdef PARALLELEXEC
+					main_thread = (omp_get_thread_num() == 0);
+				#endif
+				auto Sampler = build(chain_file_name(file_name, k+1), sample::stream_seed(base_seed, k), print_bar && k == 0);
+				Sampler.set_control(ChainControl(main_thread, stop, k, monitor));
+				results[k] = Sampler.run();
+			}
+			catch(...){ //Exceptions can not leave the parallel region, they are thrown once all chains are done
+				errors[k] = std::current_exception();
+				stop->store(true);
+			}
+		}
+
+		std::vector<std::string> files(nchains);
+		for(unsigned int k = 0; k < nchains; ++k)
+			files[k] = chain_file_name(file_name, k+1) + ".h5";
+		auto remove_files = [&files](){
+			for(auto const & f : files){
+				std::remove(f.data());
+				std::remove(HDF5conversion::RawChainsName(f).data()); //chains saved in the raw format, if any. MergeChains() moves them
+			}
+		};
+		for(auto const & e : errors){
+			if(e){
+				if(!keep_files)
+					remove_files();
+				std::rethrow_exception(e);
+			}
+		}
+		if(std::any_of(results.cbegin(), results.cend(), [](int const & res){return res < 0;})){
+			if(!keep_files)
+				remove_files();
+			return results;
+		}
+		HDF5conversion::MergeChains(file_name + ".h5", files);
+		remove_files();
+		return results;
+	}
+
+	//Called once run_chains() returned a negative value for some chain. If keep_files is true, as passed to run_chains(), the file is kept so that the
+	//sampling can be resumed, otherwise it is removed. Files of multiple chains were already removed by run_chains(), file_name has no extension
+	inline void discard_interrupted(std::string const & file_name, unsigned int const & nchains, bool const & keep_files){
+		const std::string name(file_name + ".h5");
+		if(keep_files){
+			Rcpp::Rcout<<"File "<<name<<" is kept, run the sampler again with resume = TRUE to continue from the last checkpoint"<<std::endl;
+			return;
+		}
+		Rcpp::Rcout<<"Removing file "<<name<<std::endl;
+		if(nchains <= 1){
+			std::remove(name.data());
+			std::remove(HDF5conversion::RawChainsName(name).data()); //chains saved in the raw format, if any
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef __ONLINESUMMARIES_HPP__
+#define __ONLINESUMMARIES_HPP__
+
+#include "include_headers.h"
+#include <array>
+#include <limits>
+
+/*
+	Posterior summaries updated while sampling, so that they do not require to read the whole chain from file once the sampling is over.
+	Means and variances are computed with Welford's algorithm, in its weighted version (West, 1979) because precision matrices sampled by continuous time
+	algorithms are weighted by their waiting times. Quantiles are estimated by the P^2 algorithm (Jain and Chlamtac, 1985), that tracks 5 markers per quantile
+	and needs constant memory. Quantiles are not weighted, as in analysis::Vector_ComputeQuantiles().
+*/
+
+namespace summaries{
+
+	using MatRow = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+	using VecCol = Eigen::VectorXd;
+
+	//P^2 estimate of the prob-quantile of a stream of values
+	class P2Quantile{
+		public:
+		P2Quantile(double const & _prob = 0.5):prob(_prob){
+			if(prob <= 0.0 || prob >= 1.0)
+				throw std::runtime_error("Error, the level of a quantile has to be in (0,1)");
+			increments = {0.0, 0.5*prob, prob, 0.5*(1.0 + prob), 1.0};
+		}
+		void update(double const & x);
+		//Exact quantile if less than five values were seen, computed as gsl_stats_quantile_from_sorted_data()
+		double get_quantile() const;
+		//Markers and number of seen values, they are restored by set_state(). The level is not part of the state
+		std::vector<double> get_state() const;
+		void set_state(std::vector<double>::const_iterator it);
+		static constexpr unsigned int state_size{16};
+		private:
+		//Piecewise parabolic prediction of the height of marker i moved by d
+		inline double parabolic(unsigned int const & i, double const & d) const{
+			return heights[i] + d/(positions[i+1] - positions[i-1]) * ( (positions[i] - positions[i-1] + d)*(heights[i+1] - heights[i])/(positions[i+1] - positions[i]) +
+																		 (positions[i+1] - positions[i] - d)*(heights[i] - heights[i-1])/(positions[i] - positions[i-1]) );
+		}
+		inline double linear(unsigned int const & i, int const & d) const{
+			return heights[i] + d*(heights[i+d] - heights[i])/(positions[i+d] - positions[i]);
+		}
+		double prob;
+		std::array<double, 5> heights;
+		std::array<double, 5> positions{ {1.0, 2.0, 3.0, 4.0, 5.0} };
+		std::array<double, 5> desired;
+		std::array<double, 5> increments;
+		unsigned int count{0};
+	};
+
+	inline void P2Quantile::update(double const & x)
+	{
+		if(count < 5){ //the first five values are the initial markers
+			heights[count++] = x;
+			if(count == 5){
+				std::sort(heights.begin(), heights.end());
+				desired = {1.0, 1.0 + 2.0*prob, 1.0 + 4.0*prob, 3.0 + 2.0*prob, 5.0};
+			}
+			return;
+		}
+		//Find the cell containing x, extremes are updated if needed
+		unsigned int k{0};
+		if(x < heights[0]){
+			heights[0] = x;
+			k = 0;
+		}
+		else if(x >= heights[4]){
+			heights[4] = x;
+			k = 3;
+		}
+		else{
+			while(x >= heights[k+1])
+				k++;
+		}
+		for(unsigned int i = k + 1; i < 5; ++i)
+			positions[i] += 1.0;
+		for(unsigned int i = 0; i < 5; ++i)
+			desired[i] += increments[i];
+		//Adjust the heights of the central markers
+		for(unsigned int i = 1; i < 4; ++i){
+			const double diff = desired[i] - positions[i];
+			if( (diff >= 1.0 && positions[i+1] - positions[i] > 1.0) || (diff <= -1.0 && positions[i-1] - positions[i] < -1.0) ){
+				const int d = (diff > 0) ? 1 : -1;
+				const double candidate = parabolic(i, d);
+				if(heights[i-1] < candidate && candidate < heights[i+1])
+					heights[i] = candidate;
+				else
+					heights[i] = linear(i, d);
+				positions[i] += d;
+			}
+		}
+		count++;
+	}
+
+	inline double P2Quantile::get_quantile() const
+	{
+		if(count >= 5)
+			return heights[2];
+		if(count == 0)
+			return std::numeric_limits<double>::quiet_NaN();
+		std::vector<double> values(heights.cbegin(), heights.cbegin() + count);
+		std::sort(values.begin(), values.end());
+		const double index = prob*(count - 1);
+		const unsigned int lhs = static_cast<unsigned int>(index);
+		const double delta = index - lhs;
+		if(lhs + 1 >= count)
+			return values[lhs];
+		return (1.0 - delta)*values[lhs] + delta*values[lhs + 1];
+	}
+
+	inline std::vector<double> P2Quantile::get_state() const
+	{
+		std::vector<double> state;
+		state.reserve(state_size);
+		state.insert(state.end(), heights.cbegin(), heights.cend());
+		state.insert(state.end(), positions.cbegin(), positions.cend());
+		state.insert(state.end(), desired.cbegin(), desired.cend());
+		state.push_back(count);
+		return state;
+	}
+
+	inline void P2Quantile::set_state(std::vector<double>::const_iterator it)
+	{
+		std::copy(it, it + 5, heights.begin());
+		std::copy(it + 5, it + 10, positions.begin());
+		std::copy(it + 10, it + 15, desired.begin());
+		count = static_cast<unsigned int>(it[15]);
+	}
+
+
+	//Mean, variance, lower and upper quantiles of each element of a vector of parameters. Matrices are summarized element by element, in their storage order
+	class OnlineSummary{
+		public:
+		OnlineSummary(unsigned int const & _n_elem, double const & lower_qtl = 0.05, double const & upper_qtl = 0.95):
+					  n_elem(_n_elem), mean(VecCol::Zero(_n_elem)), m2(VecCol::Zero(_n_elem)), lower(_n_elem, P2Quantile(lower_qtl)), upper(_n_elem, P2Quantile(upper_qtl)){}
+		//x has to have n_elem elements. weight is used for mean and variance only
+		template<class Derived>
+		void update(Eigen::DenseBase<Derived> const & x, double const & weight = 1.0);
+		void update(double const & x, double const & weight = 1.0){
+			this->update(VecCol::Constant(1, x), weight);
+		}
+		//Returns a 5 x n_elem matrix. Rows are mean, variance, lower quantile, upper quantile and the sum of the weights
+		MatRow get_summary() const;
+		//Everything needed to continue the updates, used for checkpoints of the sampler
+		std::vector<double> get_state() const;
+		void set_state(std::vector<double> const & state);
+		private:
+		unsigned int n_elem;
+		double total_weight{0};
+		VecCol mean;
+		VecCol m2; //weighted sum of squared deviations from the mean
+		std::vector<P2Quantile> lower;
+		std::vector<P2Quantile> upper;
+	};
+
+	template<class Derived>
+	void OnlineSummary::update(Eigen::DenseBase<Derived> const & x, double const & weight)
+	{
+		if(x.size() != n_elem)
+			throw std::runtime_error("Error in OnlineSummary::update(), the number of elements is not coherent");
+		if(weight <= 0)
+			return;
+		total_weight += weight;
+		const double ratio = weight/total_weight;
+		#pragma omp parallel for if(n_elem > 1000)
+		for(unsigned int i = 0; i < n_elem; ++i){
+			const double xi = x(i);
+			const double delta = xi - mean(i);
+			mean(i) += ratio*delta;
+			m2(i) += weight*delta*(xi - mean(i));
+			lower[i].update(xi);
+			upper[i].update(xi);
+		}
+	}
+
+	inline MatRow OnlineSummary::get_summary() const
+	{
+		MatRow res(MatRow::Zero(5, n_elem));
+		res.row(0) = mean.transpose();
+		if(total_weight > 0)
+			res.row(1) = m2.transpose()/total_weight;
+		for(unsigned int i = 0; i < n_elem; ++i){
+			res(2,i) = lower[i].get_quantile();
+			res(3,i) = upper[i].get_quantile();
+		}
+		res.row(4).setConstant(total_weight);
+		return res;
+	}
+
+	inline std::vector<double> OnlineSummary::get_state() const
+	{
+		std::vector<double> state{total_weight};
+		state.reserve(1 + 2*n_elem*(1 + P2Quantile::state_size));
+		state.insert(state.end(), mean.data(), mean.data() + n_elem);
+		state.insert(state.end(), m2.data(), m2.data() + n_elem);
+		for(unsigned int i = 0; i < n_elem; ++i){
+			const std::vector<double> state_lower(lower[i].get_state());
+			const std::vector<double> state_upper(upper[i].get_state());
+			state.insert(state.end(), state_lower.cbegin(), state_lower.cend());
+			state.insert(state.end(), state_upper.cbegin(), state_upper.cend());
+		}
+		return state;
+	}
+
+	inline void OnlineSummary::set_state(std::vector<double> const & state)
+	{
+		if(state.size() != 1 + 2*n_elem*(1 + P2Quantile::state_size))
+			throw std::runtime_error("Error in OnlineSummary::set_state(), the size of the state is not coherent");
+		total_weight = state[0];
+		mean = Eigen::Map<const VecCol>(state.data() + 1, n_elem);
+		m2 = Eigen::Map<const VecCol>(state.data() + 1 + n_elem, n_elem);
+		auto it = state.cbegin() + 1 + 2*n_elem;
+		for(unsigned int i = 0; i < n_elem; ++i){
+			lower[i].set_state(it);
+			upper[i].set_state(it + P2Quantile::state_size);
+			it += 2*P2Quantile::state_size;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef __PARALLELTEMPERING_HPP__
+#define __PARALLELTEMPERING_HPP__
+
+#include "GGM.h"
+
+/*
+	Parallel tempering for the graphical step. n_replicas copies of the GGM method are run concurrently, one per thread. The replica at level l targets
+	the posterior where the likelihood is raised to the inverse temperature beta_l = max_temperature^(-l/(n_replicas-1)), level 0 is the cold chain
+	(beta_0 = 1) that is the only one whose states are saved. Tempering the likelihood of a GGM is equivalent to use beta*U and beta*n, see GGM::set_inverse_temperature().
+	Every swap_every iterations, replicas at adjacent levels l and l+1 propose to exchange their states. The swap is accepted with probability
+		min{ 1, exp( (beta_l - beta_{l+1}) * (loglik(K_{l+1}) - loglik(K_l)) ) },
+	where loglik(K) = n/2*log|K| - 1/2*tr(KU) is the untempered log-likelihood, see utils::log_likelihood_GGM(). Even and odd pairs of levels are alternated (deterministic even-odd scheme).
+	Instead of exchanging graphs and precision matrices, replicas exchange their temperatures. Each replica keeps its own random stream, generated from the seed
+	of the sampler, hence the chain does not depend on the number of threads.
+	In FGMsampler, U depends on the regression coefficients that are sampled given the cold chain only. Hot replicas are moved given the current U, they are
+	a device to propose distant graphs to the cold chain.
+*/
+
+template<template <typename> class GraphStructure = GraphType, typename T = unsigned int>
+class ParallelTempering : public GGMTraits<GraphStructure, T> {
+	public:
+		//Typedefs
+		using IdxType  	  		= typename GGMTraits<GraphStructure, T>::IdxType;
+		using MatRow      		= typename GGMTraits<GraphStructure, T>::MatRow;
+		using MatCol      		= typename GGMTraits<GraphStructure, T>::MatCol;
+		using CholTypeRow 		= typename GGMTraits<GraphStructure, T>::CholTypeRow;
+		using Graph 			= typename GGMTraits<GraphStructure, T>::Graph;
+		using ReturnType 		= typename GGMTraits<GraphStructure, T>::ReturnType;
+		using GGMType 	    	= std::unique_ptr<GGM<GraphStructure, T>>;
+
+		//cold_method has to be already initialized with G0 and K0, see GGM::init_precision(). All replicas start from the same state
+		ParallelTempering(GGM<GraphStructure, T> const & cold_method, Graph const & G0, MatRow const & K0, unsigned int const & n_replicas,
+						  double const & max_temperature, unsigned int const & _swap_every, unsigned int const & seed);
+
+		//Performs one graph move for every replica and, if needed, the swaps. G is set equal to the graph of the cold chain, the returned tuple refers to the cold chain too
+		ReturnType operator()(MatCol const & data, unsigned int const & n, Graph & G, double alpha, int const & iter);
+		double get_waiting_time()const{
+			return methods[level_to_replica[0]]->get_waiting_time();
+		}
+		//Fraction of accepted swaps between levels l and l+1
+		std::vector<double> get_swap_rates()const;
+		//Adaptation of the proposal scales, see GGM::set_adaptation(). Scales are attached to the levels, they are exchanged together with temperatures
+		void set_adaptation(bool const & adapt_scale, double const & target_acceptance = 0.234){
+			for(auto & method : methods)
+				method->set_adaptation(adapt_scale, target_acceptance);
+		}
+		double get_proposal_scale()const{
+			return methods[level_to_replica[0]]->get_proposal_scale();
+		}
+	private:
+		void swap(MatCol const & data, unsigned int const & n);
+		std::vector<GGMType> methods; 			//one method for each replica
+		std::vector<Graph> graphs;				//current graph of each replica
+		std::vector<MatRow> precisions;			//current precision matrix of each replica
+		std::vector<double> betas;				//inverse temperature of each level
+		std::vector<unsigned int> level_to_replica; //level_to_replica[l] is the replica that is currently at level l
+		std::deque<sample::GSL_RNG> engines;	//one stream for each replica, the last one is used for the swaps
+		std::vector<unsigned int> swap_proposed;
+		std::vector<unsigned int> swap_accepted;
+		unsigned int swap_every;
+		unsigned int swap_round{0};
+};
+
+
+template<template <typename> class GraphStructure, typename T>
+ParallelTempering<GraphStructure, T>::ParallelTempering(GGM<GraphStructure, T> const & cold_method, typename GGMTraits<GraphStructure, T>::Graph const & G0,
+														MatRow const & K0, unsigned int const & n_replicas, double const & max_temperature,
+														unsigned int const & _swap_every, unsigned int const & seed):
+														graphs(n_replicas, G0), precisions(n_replicas, K0), betas(n_replicas, 1.0), level_to_replica(n_replicas),
+														swap_proposed(n_replicas - 1, 0), swap_accepted(n_replicas - 1, 0), swap_every(std::max(_swap_every, 1u))
+{
+	if(n_replicas < 2)
+		throw std::runtime_error("Error, parallel tempering needs at least two replicas");
+	if(max_temperature <= 1.0)
+		throw std::runtime_error("Error, the maximum temperature of parallel tempering has to be larger than 1");
+	if(cold_method.is_continuous_time())
+		throw std::runtime_error("Error, parallel tempering is not available for continuous time algorithms (BD)");
+	std::iota(level_to_replica.begin(), level_to_replica.end(), 0);
+	for(unsigned int l = 0; l < n_replicas; ++l){
+		betas[l] = std::pow(max_temperature, -static_cast<double>(l)/static_cast<double>(n_replicas - 1)); //geometric ladder
+		methods.push_back(cold_method.clone());
+		methods.back()->set_inverse_temperature(betas[l]);
+	}
+	for(unsigned int r = 0; r <= n_replicas; ++r)
+		engines.emplace_back(sample::stream_seed(seed, r));
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+void ParallelTempering<GraphStructure, T>::swap(MatCol const & data, unsigned int const & n)
+{
+	sample::runif rand;
+	sample::GSL_RNG const & swap_engine = engines.back();
+	for(unsigned int l = swap_round%2; l + 1 < betas.size(); l += 2){
+		const unsigned int cold = level_to_replica[l];
+		const unsigned int hot  = level_to_replica[l+1];
+		const double log_ratio = (betas[l] - betas[l+1]) * ( utils::log_likelihood_GGM(precisions[hot], data, n) - utils::log_likelihood_GGM(precisions[cold], data, n) );
+		swap_proposed[l]++;
+		if(std::log(rand(swap_engine)) < log_ratio){
+			std::swap(level_to_replica[l], level_to_replica[l+1]);
+			methods[hot]->set_inverse_temperature(betas[l]);
+			methods[cold]->set_inverse_temperature(betas[l+1]);
+			const double scale_cold = methods[cold]->get_proposal_scale();
+			methods[cold]->set_proposal_scale(methods[hot]->get_proposal_scale());
+			methods[hot]->set_proposal_scale(scale_cold);
+			swap_accepted[l]++;
+		}
+	}
+	swap_round++;
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+typename GGMTraits<GraphStructure, T>::ReturnType
+ParallelTempering<GraphStructure, T>::operator()(MatCol const & data, unsigned int const & n, typename GGMTraits<GraphStructure, T>::Graph & G,
+												 double alpha, int const & iter)
+{
+	//1) Move all replicas. Each one has its own method, graph and stream
+	const unsigned int n_replicas(methods.size());
+	std::vector<int> accepted(n_replicas, 0);
+	#pragma omp parallel for num_threads(n_replicas) schedule(static,1) shared(accepted)
+	for(unsigned int r = 0; r < n_replicas; ++r)
+		std::tie(precisions[r], accepted[r]) = (*methods[r])(data, n, graphs[r], alpha, engines[r]);
+
+	//2) Swap. Moves are already done, hence the accepted flag refers to the replica that was cold during the move
+	const unsigned int cold_replica = level_to_replica[0];
+	if((iter + 1)%swap_every == 0)
+		swap(data, n);
+	G = graphs[level_to_replica[0]];
+	return std::make_tuple(precisions[level_to_replica[0]], accepted[cold_replica]);
+}
+
+
+template<template <typename> class GraphStructure, typename T>
+std::vector<double> ParallelTempering<GraphStructure, T>::get_swap_rates()const{
+	std::vector<double> rates(swap_proposed.size(), 0.0);
+	for(unsigned int l = 0; l < rates.size(); ++l)
+		if(swap_proposed[l] > 0)
+			rates[l] = static_cast<double>(swap_accepted[l])/static_cast<double>(swap_proposed[l]);
+	return rates;
+}
+
+
+#endif
@@ -3,7 +3,6 @@
 
 #include "SamplerOptions.h"
 #include "FLMSamplerOptions.h"
-#include <gsl/gsl_statistics_double.h> //used to compute quantiles
 
 namespace analysis{
 
@@ -19,6 +18,8 @@ namespace analysis{
 	using RetTaueps	 = SamplerTraits::RetTaueps;
 	using RetTauK	 = FLMsamplerTraits::RetTauK;
 
+	using utils::plinks_from_adj;
+
 	/*Compute posterior probability of inclusion of each possible link*/
 	template< class RetGraph, typename T = bool  >
 	MatRow Compute_plinks(RetGraph const & SampledGraphs, const unsigned int & iter_saved, GroupsPtr const & groups = nullptr)
@@ -57,268 +58,557 @@ namespace analysis{
 
 		int n_elem(SampledGraphs.cbegin()->first.size());
 		std::vector<double> plinks_adj( std::accumulate(SampledGraphs.cbegin(), SampledGraphs.cend(), std::vector<double> (n_elem, 0.0), sum) );
-		
-		if( groups == nullptr){ //Assume it is a complete Graph
-			GraphType<double> G(plinks_adj);
-			MatRow plinks( G.get_graph() );
-			plinks /= iter_saved;
-			plinks.diagonal().array() = 1; //Set the diagoal equal to one
-			return plinks;
+		return plinks_from_adj(plinks_adj, iter_saved, groups);
+	}
+
+	/*Reads the waiting times of saved graphs, i.e the Weights dataset of group. An empty vector is returned if the file does not contain them (old files)
+	  or if they are all equal to one (discrete time algorithms), in that case no weighting is needed.*/
+	std::vector<double> Read_Weights(HDF5conversion::FileType & file, unsigned int const & stored_iter, std::string const & group = "/")
+	{
+		std::vector<double> weights;
+		if(!HDF5conversion::HasChain(file, group, "Weights"))
+			return weights;
+		const MatRow weights_rd(HDF5conversion::MakeChainReader(file, group, "Weights")->iterations(0, stored_iter, stored_iter)); //(stored_iter x 1)
+		weights.assign(weights_rd.data(), weights_rd.data() + weights_rd.size());
+		if(std::all_of(weights.cbegin(), weights.cend(), [](double const & w){return w == 1.0;}))
+			weights.clear();
+		return weights;
+	}
+
+	/*Opens dataset name in group, i.e in the root group for files produced by a single chain or in /ChainK/ for the k-th chain of a merged file*/
+	HDF5conversion::DatasetType Open_Dataset(HDF5conversion::FileType & file, std::string const & group, std::string const & name)
+	{
+		HDF5conversion::DatasetType dataset_rd = H5Dopen(file, (group + name).data(), H5P_DEFAULT);
+		if(dataset_rd < 0)
+			throw std::runtime_error("Error, can not open dataset for " + name);
+		return dataset_rd;
+	}
+
+	/*Opens file_name in read only mode. If live, it can also be a file that a sampler is writing in SWMR mode, see HDF5conversion::OpenLiveFile()*/
+	HDF5conversion::FileType Open_File(std::string const & file_name, bool const & live = false)
+	{
+		HDF5conversion::FileType file = (live) ? HDF5conversion::OpenLiveFile(file_name) : H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
+		if(file < 0)
+			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
+		return file;
+	}
+
+	/*Opens file_name, returns read(file) and closes the file, also if read() throws. Used by the functions that take the name of the file, the ones that take
+	  an open file are called by analysis::ResultFile*/
+	template<class F>
+	auto Read_File(std::string const & file_name, F && read)
+	{
+		HDF5conversion::FileType file = Open_File(file_name);
+		try{
+			auto res = read(file);
+			H5Fclose(file);
+			return res;
+		}
+		catch(...){
+			H5Fclose(file);
+			throw;
+		}
+	}
+
+
+	/*Returns true if the chain of name was saved in group, in any format. If not, the sampler was asked to save only its online summary, see Read_Summary()*/
+	bool Chain_Stored(HDF5conversion::FileType & file, std::string const & group, std::string const & name)
+	{
+		return HDF5conversion::HasChain(file, group, name);
+	}
+
+	/*Chain of name saved in group, either in the .h5 file or in the raw file of the chains, see HDF5conversion::GetChainFormat(). In the .h5 file, the 
+	  chain-major copy written by HDF5conversion::TransposeChain() is used if available*/
+	std::unique_ptr<HDF5conversion::ChainReader> Open_Chain(HDF5conversion::FileType & file, std::string const & group, std::string const & name)
+	{
+		return HDF5conversion::MakeChainReader(file, group, name);
+	}
+
+	/*Reads the chains of n_elem consecutive elements, starting from first, from a chain opened by Open_Chain(). Returns a (n_elem x stored_iter) matrix.
+	  For Beta, the block has to be made of whole rows, see HDF5conversion::GetChains_from_Block()*/
+	MatRow Read_Chains(HDF5conversion::ChainReader & chain_rd, unsigned int const & first, unsigned int const & n_elem, unsigned int const & stored_iter)
+	{
+		return chain_rd.elements(first, n_elem, stored_iter);
+	}
+
+	/*As Read_Chains(), but the rows are viewed in place when the chain is memory mapped, see HDF5conversion::ChainReader::view(). Otherwise they are read in 
+	  buffer, that has to outlive the returned view*/
+	Eigen::Map<const MatRow> View_Chains(HDF5conversion::ChainReader & chain_rd, unsigned int const & first, unsigned int const & n_elem, 
+										 unsigned int const & stored_iter, MatRow & buffer)
+	{
+		if(double const * values = chain_rd.view(first, n_elem, stored_iter))
+			return Eigen::Map<const MatRow>(values, n_elem, stored_iter);
+		buffer = Read_Chains(chain_rd, first, n_elem, stored_iter);
+		return Eigen::Map<const MatRow>(buffer.data(), buffer.rows(), buffer.cols());
+	}
+
+	/*Reads the chains of the elements listed in indices from a chain opened by Open_Chain(), they can be given in any order and repeated. Returns a 
+	  (indices.size() x stored_iter) matrix. Close elements are read together: the sorted indices are split in windows of at most max_bytes bytes, each one 
+	  is read by a single selection. Windows are made of whole rows of row_length elements, set row_length equal to n for Beta.
+	  If the chain is memory mapped, the chains are copied from the map and nothing is read by H5Dread()*/
+	MatRow Read_Chains(HDF5conversion::ChainReader & chain_rd, std::vector<unsigned int> const & indices, unsigned int const & stored_iter, 
+					   unsigned int const & row_length = 1, std::size_t const & max_bytes = 268435456)
+	{
+		MatRow chains(indices.size(), stored_iter);
+		if(indices.empty())
+			return chains;
+		const unsigned int n_rows = *std::max_element(indices.cbegin(), indices.cend()) + 1;
+		if(double const * values = chain_rd.view(0, n_rows, stored_iter)){
+			const Eigen::Map<const MatRow> all(values, n_rows, stored_iter);
+			for(std::size_t k = 0; k < indices.size(); ++k)
+				chains.row(k) = all.row(indices[k]);
+			return chains;
+		}
+		std::vector<std::size_t> order(indices.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&indices](std::size_t const & a, std::size_t const & b){return indices[a] < indices[b];});
+		const std::size_t max_elem = std::max(max_bytes/(sizeof(double)*std::max(stored_iter, 1u)*row_length), std::size_t(1))*row_length;
+		for(std::size_t k = 0; k < order.size();){
+			const unsigned int first = (indices[order[k]]/row_length)*row_length;
+			std::size_t last = k; //last element of the window
+			while(last + 1 < order.size() && indices[order[last + 1]] < first + max_elem)
+				++last;
+			const unsigned int n_elem = (indices[order[last]]/row_length + 1)*row_length - first;
+			const MatRow window(Read_Chains(chain_rd, first, n_elem, stored_iter));
+			for(; k <= last; ++k)
+				chains.row(order[k]) = window.row(indices[order[k]] - first);
+		}
+		return chains;
+	}
+
+	/*Quantiles of levels probs of values, computed as gsl_stats_quantile_from_sorted_data() but without sorting. Each level requires a selection 
+	  (std::nth_element) that is restricted to the values not smaller than the previous level, hence the cost is linear. values are reordered*/
+	std::vector<double> Select_Quantiles(std::vector<double> & values, std::vector<double> const & probs)
+	{
+		std::vector<double> quantiles(probs.size(), 0.0);
+		if(values.empty())
+			return quantiles;
+		std::vector<std::size_t> order(probs.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&probs](std::size_t const & a, std::size_t const & b){return probs[a] < probs[b];});
+		auto first = values.begin();
+		for(auto const & k : order){
+			const double index = probs[k]*(values.size() - 1);
+			const std::size_t lhs = static_cast<std::size_t>(index);
+			const double delta = index - lhs;
+			auto nth = values.begin() + lhs;
+			std::nth_element(first, nth, values.end());
+			first = nth;
+			quantiles[k] = *nth;
+			if(delta > 0 && lhs + 1 < values.size()) //the next order statistic is the smallest of the following values
+				quantiles[k] = (1.0 - delta)*(*nth) + delta*(*std::min_element(nth + 1, values.end()));
+		}
+		return quantiles;
+	}
+
+	/*Quantiles of levels probs of the n_elem elements of name, the chains saved in the groups listed in chains are pooled. The datasets are read once, in blocks 
+	  of elements of at most max_bytes bytes, and the elements of a block are processed in parallel. Beta blocks are made of whole rows of n elements, set 
+	  row_length equal to n in that case. Chain-major copies that can be memory mapped are viewed in place instead of being read. 
+	  Returns a (probs.size() x n_elem) matrix*/
+	MatRow Chains_Quantiles(HDF5conversion::FileType & file, std::vector<std::string> const & chains, std::string const & name, unsigned int const & n_elem, 
+							unsigned int const & stored_iter, std::vector<double> const & probs, unsigned int const & row_length = 1, std::size_t const & max_bytes = 268435456)
+	{
+		std::vector<std::unique_ptr<HDF5conversion::ChainReader>> datasets;
+		for(auto const & group : chains)
+			datasets.push_back(Open_Chain(file, group, name));
+		const std::size_t elem_bytes = sizeof(double)*stored_iter*datasets.size();
+		const unsigned int block = std::max(static_cast<unsigned int>(max_bytes/(elem_bytes*row_length)), 1u)*row_length;
+		MatRow quantiles(probs.size(), n_elem);
+		for(unsigned int first = 0; first < n_elem; first += block){
+			const unsigned int n_block = std::min(block, n_elem - first);
+			std::vector<MatRow> buffers(datasets.size());
+			std::vector<Eigen::Map<const MatRow>> values;
+			for(std::size_t k = 0; k < datasets.size(); ++k)
+				values.push_back(View_Chains(*datasets[k], first, n_block, stored_iter, buffers[k]));
+			#pragma omp parallel for
+			for(unsigned int e = 0; e < n_block; ++e){
+				std::vector<double> chain;
+				chain.reserve(stored_iter*values.size());
+				for(auto const & values_k : values)
+					chain.insert(chain.end(), values_k.data() + static_cast<std::size_t>(e)*stored_iter, values_k.data() + static_cast<std::size_t>(e + 1)*stored_iter);
+				const std::vector<double> quantiles_e(Select_Quantiles(chain, probs));
+				for(unsigned int k = 0; k < probs.size(); ++k)
+					quantiles(k, first + e) = quantiles_e[k];
+			}
+			Rcpp::checkUserInterrupt();
+		}
+		return quantiles;
+	}
+
+	/*Reads the online summary of name computed by the sampler that wrote group, see summaries::OnlineSummary. It is a 5 x n_elem matrix whose rows are
+	  mean, variance, lower quantile, upper quantile and sum of the weights*/
+	MatRow Read_Summary(HDF5conversion::FileType & file, std::string const & group, std::string const & name, unsigned int const & n_elem)
+	{
+		if(H5Lexists(file, (group + "Summary" + name).data(), H5P_DEFAULT) <= 0)
+			throw std::runtime_error("Error, the file contains neither the chain nor the online summary of " + name);
+		HDF5conversion::DatasetType dataset_rd = Open_Dataset(file, group, "Summary" + name);
+		MatRow summary(5, n_elem);
+		HDF5conversion::StatusType status = H5Dread(dataset_rd, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, summary.data());
+		if(status < 0)
+			throw std::runtime_error("Error, can not read the online summary of " + name);
+		H5Dclose(dataset_rd);
+		return summary;
+	}
+
+	/*Posterior mean of name from its online summaries. Chains are pooled weighting them by their sums of weights*/
+	VecCol Summary_Mean(HDF5conversion::FileType & file, std::vector<std::string> const & chains, std::string const & name, unsigned int const & n_elem)
+	{
+		VecCol Mean(VecCol::Zero(n_elem));
+		double normalization{0};
+		for(auto const & group : chains){
+			MatRow summary = Read_Summary(file, group, name, n_elem);
+			Mean += summary(4,0)*summary.row(0).transpose();
+			normalization += summary(4,0);
+		}
+		return Mean / normalization;
+	}
+
+	/*Quantiles of name from its online summaries. alpha_lower and alpha_upper have to be the levels that were set for the sampling. 
+	  Quantiles of different chains are averaged, it is an approximation of the quantiles of the pooled chains*/
+	std::tuple<VecCol,VecCol> Summary_Quantiles(HDF5conversion::FileType & file, std::vector<std::string> const & chains, std::string const & name, unsigned int const & n_elem, 
+												double const & alpha_lower, double const & alpha_upper)
+	{
+		VecCol LowerBound(VecCol::Zero(n_elem));
+		VecCol UpperBound(VecCol::Zero(n_elem));
+		for(auto const & group : chains){
+			HDF5conversion::DatasetType dataset_rd = Open_Dataset(file, group, "SummaryQuantiles");
+			double qtl_levels[2];
+			HDF5conversion::StatusType status = H5Dread(dataset_rd, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, qtl_levels);
+			if(status < 0)
+				throw std::runtime_error("Error, can not read the levels of the online quantiles");
+			H5Dclose(dataset_rd);
+			if(std::abs(qtl_levels[0] - alpha_lower) > 1e-12 || std::abs(qtl_levels[1] - alpha_upper) > 1e-12)
+				throw std::runtime_error("Error, the chain of " + name + " was not saved and its quantiles were estimated online only for levels " + 
+										 std::to_string(qtl_levels[0]) + " and " + std::to_string(qtl_levels[1]));
+			MatRow summary = Read_Summary(file, group, name, n_elem);
+			LowerBound += summary.row(2).transpose();
+			UpperBound += summary.row(3).transpose();
 		}
-		else{ //Assume it is a Block Graph
-			BlockGraph<double> G(plinks_adj, groups);
-			MatRow plinks( G.get_graph());
-			plinks /= iter_saved;
-			std::vector<unsigned int> singleton(G.get_pos_singleton());
-			if(singleton.size() != 0) //Set the diagoal equal to one if there is a singleton 
-				std::for_each(singleton.cbegin(), singleton.cend(),[&plinks](unsigned int const & pos){plinks(pos, pos)=1.0;});
-			return plinks;
+		return std::make_tuple(LowerBound / chains.size(), UpperBound / chains.size());
+	}
+
+
+	/*Weighted mean and variance of the n_elem elements of name, the chains saved in the groups listed in chains are pooled. Chains are streamed by blocks of 
+	  iterations of at most max_bytes bytes, the memory does not depend on saved_iter. Each block is summarized in parallel over the elements and merged 
+	  with the previous ones (Chan, Golub and LeVeque, 1979). Chain-major copies that can be memory mapped are summarized element by element, without reading
+	  them. If weighted, iterations are weighted by their waiting times, see Read_Weights(). 
+	  Returns a (2 x n_elem) matrix, rows are mean and variance*/
+	MatRow Chains_Moments(HDF5conversion::FileType & file, std::vector<std::string> const & chains, std::string const & name, unsigned int const & n_elem, 
+						  unsigned int const & saved_iter, bool const & weighted = false, std::size_t const & max_bytes = 268435456)
+	{
+		VecCol mean(VecCol::Zero(n_elem));
+		VecCol m2(VecCol::Zero(n_elem)); //weighted sum of squared deviations from the mean
+		double total_weight{0};
+		const unsigned int block = std::clamp(static_cast<unsigned int>(max_bytes/(sizeof(double)*std::max(n_elem, 1u))), 1u, std::max(saved_iter, 1u));
+		const unsigned int n_cols{512}; //elements summarized by each thread at a time
+		for(auto const & group : chains){
+			const bool has_weights(weighted && Chain_Stored(file, group, "Weights"));
+			std::unique_ptr<HDF5conversion::ChainReader> chain_rd = Open_Chain(file, group, name);
+			std::unique_ptr<HDF5conversion::ChainReader> weights_rd = (has_weights) ? Open_Chain(file, group, "Weights") : nullptr;
+			//If the chain-major copy is memory mapped, the chain of each element is a contiguous row that is summarized in place
+			if(double const * mapped = chain_rd->view(0, n_elem, saved_iter)){
+				VecCol w(VecCol::Ones(saved_iter));
+				if(has_weights)
+					w = weights_rd->iterations(0, saved_iter, saved_iter).col(0);
+				const double chain_weight = w.sum();
+				if(chain_weight <= 0)
+					continue;
+				const double new_weight = total_weight + chain_weight;
+				const Eigen::Map<const MatRow> values(mapped, n_elem, saved_iter);
+				#pragma omp parallel for
+				for(unsigned int e = 0; e < n_elem; ++e){
+					const double chain_mean = w.dot(values.row(e).transpose())/chain_weight;
+					const double chain_m2 = (w.array()*(values.row(e).transpose().array() - chain_mean).square()).sum();
+					const double delta = chain_mean - mean(e);
+					mean(e) += (chain_weight/new_weight)*delta;
+					m2(e) += chain_m2 + (total_weight*chain_weight/new_weight)*delta*delta;
+				}
+				total_weight = new_weight;
+				continue;
+			}
+			for(unsigned int first = 0; first < saved_iter; first += block){
+				const unsigned int n_iter = std::min(block, saved_iter - first);
+				const MatRow values(chain_rd->iterations(first, n_iter, saved_iter));
+				const VecCol w = (has_weights) ? VecCol(weights_rd->iterations(first, n_iter, saved_iter).col(0)) : VecCol::Ones(n_iter);
+				const double block_weight = w.sum();
+				if(block_weight <= 0)
+					continue;
+				const double new_weight = total_weight + block_weight;
+				#pragma omp parallel for
+				for(unsigned int c0 = 0; c0 < n_elem; c0 += n_cols){
+					const unsigned int nc = std::min(n_cols, n_elem - c0);
+					const auto values_c = values.middleCols(c0, nc);
+					const VecRow block_mean = (w.transpose()*values_c)/block_weight;
+					VecRow block_m2(VecRow::Zero(nc));
+					for(unsigned int t = 0; t < n_iter; ++t)
+						block_m2.array() += w(t)*(values_c.row(t) - block_mean).array().square();
+					const VecRow delta = block_mean - mean.segment(c0, nc).transpose();
+					mean.segment(c0, nc) += (block_weight/new_weight)*delta.transpose();
+					m2.segment(c0, nc) += (block_m2.array() + (total_weight*block_weight/new_weight)*delta.array().square()).matrix().transpose();
+				}
+				total_weight = new_weight;
+			}
 		}
+		MatRow moments(MatRow::Zero(2, n_elem));
+		moments.row(0) = mean.transpose();
+		if(total_weight > 0)
+			moments.row(1) = m2.transpose()/total_weight;
+		return moments;
 	}
 
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------
 	//Reading values from file
+	//All functions read the groups listed in chains, see HDF5conversion::GetChainGroups(). If more than one group is given, the chains are pooled. 
+	//Each of them has saved_iter (or stored_iter) values.
+	//Each function comes in two versions, the first one reads a file that is already open, e.g by ResultFile, the second one opens and closes file_name.
 
 
 	//This function is thought for Beta matrices. file_name has to containg also the extension (name.h5). The file has to contain a dataset called /Beta.
 	//It then returns a (p x n) matrix containing the mean values of every Beta
-	MatCol Matrix_PointwiseEstimate( std::string const & file_name, const int& saved_iter, const unsigned int & p, const unsigned int & n )
+	MatCol Matrix_PointwiseEstimate( HDF5conversion::FileType & file, const int& saved_iter, const unsigned int & p, const unsigned int & n,
+									 std::vector<std::string> const & chains = {"/"} )
 	{
-		
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_Beta_rd;
-		//Open file
-		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		dataset_Beta_rd  = H5Dopen(file, "/Beta", H5P_DEFAULT);
-		if(dataset_Beta_rd < 0)
-			throw std::runtime_error("Error, can not open dataset for Beta ");
-		//Read beta
-		std::vector< MatCol > vett_Beta(saved_iter);
-		for(int i = 0; i < saved_iter; ++i){
-			vett_Beta[i] = HDF5conversion::ReadMatrix(dataset_Beta_rd, p, n, i);	
-		}
-
-		MatCol MeanBeta(MatCol::Zero(p, n));
-		for(int i = 0; i < saved_iter; ++i){
-			MeanBeta += vett_Beta[i];
+		if(!Chain_Stored(file, chains.front(), "Beta")){ //only the online summary is available
+			VecCol MeanBeta_vett = Summary_Mean(file, chains, "Beta", p*n);
+			return Eigen::Map<MatCol>(MeanBeta_vett.data(), p, n);
 		}
-		MeanBeta /= saved_iter;	
-		H5Dclose(dataset_Beta_rd);
-		H5Fclose(file);
-		return MeanBeta;
+		//The chain is streamed by blocks of iterations, element (i,j) is the column i*n + j
+		const MatRow moments(Chains_Moments(file, chains, "Beta", p*n, saved_iter));
+		return Eigen::Map<const MatRow>(moments.row(0).data(), p, n);
+	}
+	MatCol Matrix_PointwiseEstimate( std::string const & file_name, const int& saved_iter, const unsigned int & p, const unsigned int & n,
+									 std::vector<std::string> const & chains = {"/"} )
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Matrix_PointwiseEstimate(file, saved_iter, p, n, chains);});
 	}
 	//This function is thought for Mu and Precision vector. file_name has to containg also the extension (name.h5). The file has to contain a dataset called /Mu or /Precision.
 	//Only possibilities for vett_type are indeed Mu or Precision.
 	//It then returns a (length)-dimensional vector containing the mean values of every element
-	VecCol Vector_PointwiseEstimate( std::string const & file_name, const int& saved_iter, const unsigned int & length, std::string const & vett_type )
+	VecCol Vector_PointwiseEstimate( HDF5conversion::FileType & file, const int& saved_iter, const unsigned int & length, std::string const & vett_type,
+									 std::vector<std::string> const & chains = {"/"} )
 	{
 		if(vett_type != "Mu" && vett_type != "Precision")
 			throw std::runtime_error("Error in Vector_PointwiseEstimate(). vett_type can only be Mu or Precision");
 
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_rd;
-		//Open file
-		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		if(vett_type == "Mu"){
-			dataset_rd  = H5Dopen(file, "/Mu", H5P_DEFAULT);
-			if(dataset_rd < 0)
-				throw std::runtime_error("Error, can not open dataset for Mu");
+		if(!Chain_Stored(file, chains.front(), vett_type)){ //only the online summary is available
+			VecCol Mean = Summary_Mean(file, chains, vett_type, length);
+			return Mean;
 		}
-		else
-		{
-			dataset_rd = H5Dopen(file, "/Precision", H5P_DEFAULT);
-			if(dataset_rd < 0)
-				throw std::runtime_error("Error, can not open dataset for Precision");
-		}
-		
-		//Read 
-		std::vector< VecCol > vect(saved_iter);
-		for(int i = 0; i < saved_iter; ++i){
-			vect[i] = HDF5conversion::ReadVector(dataset_rd, length, i);	
-		}
-
-		//Compute mean
-		VecCol Mean(VecCol::Zero(length));
-		for(int i = 0; i < saved_iter; ++i){
-			Mean += vect[i];
-		}
-		Mean /= saved_iter;	
-
-		H5Dclose(dataset_rd);
-		H5Fclose(file);
-		return Mean;
+		//Precision matrices sampled by continuous time algorithms are weighted by their waiting times
+		const MatRow moments(Chains_Moments(file, chains, vett_type, length, saved_iter, vett_type == "Precision"));
+		return moments.row(0).transpose();
+	}
+	VecCol Vector_PointwiseEstimate( std::string const & file_name, const int& saved_iter, const unsigned int & length, std::string const & vett_type,
+									 std::vector<std::string> const & chains = {"/"} )
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Vector_PointwiseEstimate(file, saved_iter, length, vett_type, chains);});
 	}
 	//This function is thought for TauEps variables. file_name has to containg also the extension (name.h5). The file has to contain a dataset called /TauEps.
 	//It then returns a double with the mean values of the sampled values
-	double Scalar_PointwiseEstimate( std::string const & file_name, const int& saved_iter )
+	double Scalar_PointwiseEstimate( HDF5conversion::FileType & file, const int& saved_iter, std::vector<std::string> const & chains = {"/"} )
 	{
-		
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_rd;
-		//Open file
-		file = H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		dataset_rd  = H5Dopen(file, "/TauEps", H5P_DEFAULT);
-		if(dataset_rd < 0)
-			throw std::runtime_error("Error, can not open dataset for TauEps ");
-		//Read 
-		std::vector< double > vett(saved_iter);
-		for(int i = 0; i < saved_iter; ++i){
-			vett[i] = HDF5conversion::ReadScalar(dataset_rd, i);	
+		if(!Chain_Stored(file, chains.front(), "TauEps")){ //only the online summary is available
+			double mean = Summary_Mean(file, chains, "TauEps", 1)(0);
+			return mean;
 		}
-		//Compute mean
-		double mean = std::accumulate(vett.cbegin(), vett.cend(), 0.0);
-		mean /= saved_iter;
-		H5Dclose(dataset_rd);
-		H5Fclose(file);	
+		const double mean = Chains_Moments(file, chains, "TauEps", 1, saved_iter)(0,0);
 		return mean;
 	}
+	double Scalar_PointwiseEstimate( std::string const & file_name, const int& saved_iter, std::vector<std::string> const & chains = {"/"} )
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Scalar_PointwiseEstimate(file, saved_iter, chains);});
+	}
 
 	//Computes quantiles for evey Beta. file_name has the same requirement of Matrix_PointwiseEstimate() 
-	std::tuple<MatCol,MatCol> Matrix_ComputeQuantiles(	std::string const & file_name, unsigned int const & stored_iter, unsigned int const & p, unsigned int const & n, 
-														double const & alpha_lower = 0.05, double const & alpha_upper = 0.95	)
+	std::tuple<MatCol,MatCol> Matrix_ComputeQuantiles(	HDF5conversion::FileType & file, unsigned int const & stored_iter, unsigned int const & p, unsigned int const & n, 
+														double const & alpha_lower = 0.05, double const & alpha_upper = 0.95, std::vector<std::string> const & chains = {"/"}	)
 	{
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_rd;
-		//Open file
-		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		dataset_rd  = H5Dopen(file, "/Beta", H5P_DEFAULT);
-		if(dataset_rd < 0)
-			throw std::runtime_error("Error, can not opem dataset for Beta ");
-
-		//Read chains and compute quantiles
-		MatCol LowerBound(MatCol::Zero(p,n));
-		MatCol UpperBound(MatCol::Zero(p,n));
-		for(int i = 0; i < p; ++i){
-			for(int j = 0; j < n; ++j){
-				std::vector<double> chain = HDF5conversion::GetChain_from_Matrix(dataset_rd, i, j, stored_iter, n);
-				std::sort(chain.begin(), chain.end());
-				LowerBound(i,j) = gsl_stats_quantile_from_sorted_data(&chain.data()[0], 1, chain.size(), alpha_lower);
-				UpperBound(i,j) = gsl_stats_quantile_from_sorted_data(&chain.data()[0], 1, chain.size(), alpha_upper);
-			}
-			std::cout<<"Finihed p = "<<i+1<<"/"<<p<<std::endl;
-			Rcpp::checkUserInterrupt();
+		if(!Chain_Stored(file, chains.front(), "Beta")){ //only the online summary is available
+			auto [Lower_vett, Upper_vett] = Summary_Quantiles(file, chains, "Beta", p*n, alpha_lower, alpha_upper);
+			return std::make_tuple(MatCol(Eigen::Map<MatCol>(Lower_vett.data(), p, n)), MatCol(Eigen::Map<MatCol>(Upper_vett.data(), p, n)));
 		}
-
-		H5Dclose(dataset_rd);
-		H5Fclose(file);
-		return std::make_tuple(LowerBound, UpperBound);
+		//Read chains by blocks of rows and compute quantiles, element (i,j) is the column i*n + j
+		const MatRow quantiles(Chains_Quantiles(file, chains, "Beta", p*n, stored_iter, {alpha_lower, alpha_upper}, n));
+		return std::make_tuple(MatCol(Eigen::Map<const MatRow>(quantiles.row(0).data(), p, n)), MatCol(Eigen::Map<const MatRow>(quantiles.row(1).data(), p, n)));
+	}
+	std::tuple<MatCol,MatCol> Matrix_ComputeQuantiles(	std::string const & file_name, unsigned int const & stored_iter, unsigned int const & p, unsigned int const & n, 
+														double const & alpha_lower = 0.05, double const & alpha_upper = 0.95, std::vector<std::string> const & chains = {"/"}	)
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Matrix_ComputeQuantiles(file, stored_iter, p, n, alpha_lower, alpha_upper, chains);});
 	}
 	//Computes quantiles for evey Mu or Precision element. file_name has the same requirement of Vector_PointwiseEstimate() 
-	std::tuple<VecCol,VecCol> Vector_ComputeQuantiles(	std::string const & file_name, unsigned int const & stored_iter, unsigned int const & n_elem, std::string const & vett_type, 
-														double const & alpha_lower = 0.05, double const & alpha_upper = 0.95	)
+	std::tuple<VecCol,VecCol> Vector_ComputeQuantiles(	HDF5conversion::FileType & file, unsigned int const & stored_iter, unsigned int const & n_elem, std::string const & vett_type, 
+														double const & alpha_lower = 0.05, double const & alpha_upper = 0.95, std::vector<std::string> const & chains = {"/"}	)
 	{
 		if(vett_type != "Mu" && vett_type != "Precision")
 			throw std::runtime_error("Error in Vector_PointwiseEstimate(). vett_type can only be Mu or Precision");
 
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_rd;
-		//Open file
-		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		if(vett_type == "Mu"){
-			dataset_rd  = H5Dopen(file, "/Mu", H5P_DEFAULT);
-			if(dataset_rd < 0)
-				throw std::runtime_error("Error, can not open dataset for Mu ");
-		}
-		else
-		{
-			dataset_rd  = H5Dopen(file, "/Precision", H5P_DEFAULT);
-			if(dataset_rd < 0)
-				throw std::runtime_error("Error, can not open dataset for Precision");
-		}
-		//Read chains and compute quantiles
-		VecCol LowerBound(VecCol::Zero(n_elem));
-		VecCol UpperBound(VecCol::Zero(n_elem));
-		for(int i = 0; i < n_elem; ++i){
-			std::vector<double> chain = HDF5conversion::GetChain_from_Vector(dataset_rd, i, stored_iter, n_elem);
-			std::sort(chain.begin(), chain.end());
-			LowerBound(i) = gsl_stats_quantile_from_sorted_data(&chain.data()[0], 1, chain.size(), alpha_lower);
-			UpperBound(i) = gsl_stats_quantile_from_sorted_data(&chain.data()[0], 1, chain.size(), alpha_upper);
+		if(!Chain_Stored(file, chains.front(), vett_type)){ //only the online summary is available
+			auto quantiles = Summary_Quantiles(file, chains, vett_type, n_elem, alpha_lower, alpha_upper);
+			return quantiles;
 		}
-
-		H5Dclose(dataset_rd);
-		H5Fclose(file);
-		return std::make_tuple(LowerBound, UpperBound);
+		//Read chains by blocks and compute quantiles
+		const MatRow quantiles(Chains_Quantiles(file, chains, vett_type, n_elem, stored_iter, {alpha_lower, alpha_upper}));
+		return std::make_tuple(VecCol(quantiles.row(0).transpose()), VecCol(quantiles.row(1).transpose()));
+	}
+	std::tuple<VecCol,VecCol> Vector_ComputeQuantiles(	std::string const & file_name, unsigned int const & stored_iter, unsigned int const & n_elem, std::string const & vett_type, 
+														double const & alpha_lower = 0.05, double const & alpha_upper = 0.95, std::vector<std::string> const & chains = {"/"}	)
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Vector_ComputeQuantiles(file, stored_iter, n_elem, vett_type, alpha_lower, alpha_upper, chains);});
 	}
 	//Computes quantiles for tau_eps. file_name has the same requirement of Scalar_PointwiseEstimate() 
-	std::tuple<double,double> Scalar_ComputeQuantiles(	std::string const & file_name, unsigned int const & stored_iter, double const & alpha_lower = 0.05, double const & alpha_upper = 0.95	)
+	std::tuple<double,double> Scalar_ComputeQuantiles(	HDF5conversion::FileType & file, unsigned int const & stored_iter, double const & alpha_lower = 0.05, double const & alpha_upper = 0.95,
+														std::vector<std::string> const & chains = {"/"}	)
 	{
-		
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_rd;
-		//Open file
-		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		dataset_rd  = H5Dopen(file, "/TauEps", H5P_DEFAULT);
-		if(dataset_rd < 0)
-			throw std::runtime_error("Error, can not open dataset for TauEps");
-		//Read chains all the chain
-		std::vector<double> chain(stored_iter);
-		double * ptr_chain = chain.data();
-		HDF5conversion::StatusType status;
-		status = H5Dread(dataset_rd,H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, ptr_chain);
+		if(!Chain_Stored(file, chains.front(), "TauEps")){ //only the online summary is available
+			auto [Lower, Upper] = Summary_Quantiles(file, chains, "TauEps", 1, alpha_lower, alpha_upper);
+			return std::make_tuple(Lower(0), Upper(0));
+		}
+		//Read all the chains
+		std::vector<double> chain(stored_iter*chains.size());
+		for(unsigned int k = 0; k < chains.size(); ++k){
+			const MatRow chain_k(Open_Chain(file, chains[k], "TauEps")->iterations(0, stored_iter, stored_iter)); //(stored_iter x 1)
+			std::copy(chain_k.data(), chain_k.data() + stored_iter, chain.begin() + k*stored_iter);
+		}
 
 		//Compute Quantiles
-		double LowerBound{0};
-		double UpperBound{0};
-		std::sort(chain.begin(), chain.end());
-		LowerBound = gsl_stats_quantile_from_sorted_data(&chain.data()[0], 1, chain.size(), alpha_lower);
-		UpperBound = gsl_stats_quantile_from_sorted_data(&chain.data()[0], 1, chain.size(), alpha_upper);
+		const std::vector<double> quantiles(Select_Quantiles(chain, {alpha_lower, alpha_upper}));
 		//Close and return
-		H5Dclose(dataset_rd);
-		H5Fclose(file);
-		return std::make_tuple(LowerBound, UpperBound);
+		return std::make_tuple(quantiles[0], quantiles[1]);
+	}
+	std::tuple<double,double> Scalar_ComputeQuantiles(	std::string const & file_name, unsigned int const & stored_iter, double const & alpha_lower = 0.05, double const & alpha_upper = 0.95,
+														std::vector<std::string> const & chains = {"/"}	)
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Scalar_ComputeQuantiles(file, stored_iter, alpha_lower, alpha_upper, chains);});
 	}
 
 
-	std::tuple<MatRow, HDF5conversion::SampledGraphs, VecCol, int > //plinks, map with graphs frequence of visit, traceplot, visited graphs
-	Summary_Graph(std::string const & file_name, unsigned int const & stored_iter, unsigned int const & p, GroupsPtr const & groups = nullptr)
+	/*Reads the Rao-Blackwellized posterior probabilities of inclusion computed during the sampling. They are averaged if more than one chain is given*/
+	MatRow Read_plinksRB(HDF5conversion::FileType & file, unsigned int const & p, std::vector<std::string> const & chains = {"/"})
 	{
-		unsigned int n_elem;
-		if( groups == nullptr){ //Assume it is a complete Graph
-			n_elem = 0.5*p*(p-1);
-		}
-		else{ //Assume it is a block Graph
-			n_elem = 0.5*groups->get_n_groups()*(groups->get_n_groups() + 1) - groups->get_n_singleton();
+		MatRow plinks(MatRow::Zero(p,p));
+		for(auto const & group : chains){
+			if(H5Lexists(file, (group + "PlinksRB").data(), H5P_DEFAULT) <= 0)
+				throw std::runtime_error("Error, the file does not contain Rao-Blackwellized probabilities of inclusion. It was generated by an older version or by a sampler without graph");
+			HDF5conversion::DatasetType dataset_rd = Open_Dataset(file, group, "PlinksRB");
+			MatRow plinks_k(p,p);
+			HDF5conversion::StatusType status = H5Dread(dataset_rd, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, plinks_k.data());
+			if(status < 0)
+				throw std::runtime_error("Error, can not read PlinksRB");
+			H5Dclose(dataset_rd);
+			plinks += plinks_k;
 		}
+		return plinks / static_cast<double>(chains.size());
+	}
+	MatRow Read_plinksRB(std::string const & file_name, unsigned int const & p, std::vector<std::string> const & chains = {"/"})
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Read_plinksRB(file, p, chains);});
+	}
 
-		HDF5conversion::SampledGraphs Glist;
-		VecCol traceplot_size;
-		int visited;
-		//Open file
-		HDF5conversion::FileType file;
-		HDF5conversion::DatasetType dataset_rd;
-		//Open file
-		file=H5Fopen(file_name.data(), H5F_ACC_RDONLY, H5P_DEFAULT); //it is read only
-		if(file < 0)
-			throw std::runtime_error("Cannot open the file in read-only mode. The most probable reason is that it was not closed correctly");
-		//Open datasets
-		dataset_rd  = H5Dopen(file, "/Graphs", H5P_DEFAULT);
-		if(dataset_rd < 0)
-			throw std::runtime_error("Error, can not open the dataset for Graphs");
+	//Number of possible links of a complete graph, or of a block graph if groups are given
+	unsigned int Graph_Elements(unsigned int const & p, GroupsPtr const & groups = nullptr)
+	{
+		if( groups == nullptr) //Assume it is a complete Graph
+			return 0.5*p*(p-1);
+		return 0.5*groups->get_n_groups()*(groups->get_n_groups() + 1) - groups->get_n_singleton(); //Assume it is a block Graph
+	}
 
-		std::tie(Glist, traceplot_size, visited) = HDF5conversion::GetGraphsChain(dataset_rd, n_elem, stored_iter);
-		MatRow plinks = Compute_plinks<decltype(Glist), unsigned int>(Glist, stored_iter, groups);
+	/*Adds to counter the graphs saved in group, either as an event log (see HDF5conversion::GraphLogWriter) or as a chain of packed graphs in any format.
+	  Returns the size of each graph and the sum of the weights of the graphs that contain each link, see HDF5conversion::TallyGraphsChain()*/
+	template<class Counter>
+	std::tuple<VecCol, std::vector<double>> Tally_Graphs(HDF5conversion::FileType & file, std::string const & group, unsigned int const & n_elem, 
+														 unsigned int const & stored_iter, Counter & counter, std::vector<double> const & weights)
+	{
+		if(HDF5conversion::HasGraphLog(file, group)) //graphs saved as an event log
+			return HDF5conversion::TallyGraphsLog(file, group, n_elem, stored_iter, counter, weights);
+		if(HDF5conversion::GetChainFormat(file, group) == HDF5conversion::ChainFormat::Raw)
+			return HDF5conversion::TallyGraphsChain(*Open_Chain(file, group, "Graphs"), n_elem, stored_iter, counter, weights);
+		HDF5conversion::DatasetType dataset_rd = Open_Dataset(file, group, "Graphs"); //older files may store one unsigned int per link
+		auto tallied = HDF5conversion::TallyGraphsChain(dataset_rd, n_elem, stored_iter, counter, weights);
 		H5Dclose(dataset_rd);
-		H5Fclose(file);
-		return std::make_tuple(plinks, Glist, traceplot_size, visited);
+		return tallied;
+	}
+
+	//If top_k is positive, only the top_k most visited graphs are returned. Visited graphs are counted over all chains before the selection and plinks are always
+	//computed from all the graphs
+	std::tuple<MatRow, HDF5conversion::SampledGraphs, VecCol, int > //plinks, map with graphs frequence of visit, traceplot, visited graphs
+	Summary_Graph(HDF5conversion::FileType & file, unsigned int const & stored_iter, unsigned int const & p, GroupsPtr const & groups = nullptr, 
+				  std::vector<std::string> const & chains = {"/"}, std::size_t const & top_k = 0)
+	{
+		const unsigned int n_elem = Graph_Elements(p, groups);
+		HDF5conversion::GraphTally tally(n_elem);
+		VecCol traceplot_size(stored_iter*chains.size());
+		std::vector<double> plinks_adj(n_elem, 0.0);
+		double normalization{0};
+		//Open file
+		for(unsigned int k = 0; k < chains.size(); ++k){
+			//Continuous time algorithms, each graph is weighted by its waiting time. Frequencies of the links are accumulated while the graphs are counted
+			std::vector<double> weights(Read_Weights(file, stored_iter, chains[k]));
+			std::tuple<VecCol, std::vector<double>> tallied(Tally_Graphs(file, chains[k], n_elem, stored_iter, tally, weights));
+			auto const & [traceplot_k, links_weight_k] = tallied;
+			traceplot_size.segment(k*stored_iter, stored_iter) = traceplot_k;
+			std::transform(plinks_adj.cbegin(), plinks_adj.cend(), links_weight_k.cbegin(), plinks_adj.begin(), std::plus<double>());
+			normalization += (weights.size() == 0) ? stored_iter : std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+		}
+		MatRow plinks = plinks_from_adj(plinks_adj, normalization, groups);
+		return std::make_tuple(plinks, tally.top(top_k), traceplot_size, static_cast<int>(tally.size()));
+	}
+	std::tuple<MatRow, HDF5conversion::SampledGraphs, VecCol, int >
+	Summary_Graph(std::string const & file_name, unsigned int const & stored_iter, unsigned int const & p, GroupsPtr const & groups = nullptr, 
+				  std::vector<std::string> const & chains = {"/"}, std::size_t const & top_k = 0)
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Summary_Graph(file, stored_iter, p, groups, chains, top_k);});
+	}
+
+	/*Most visited graphs with bounded memory, see HDF5conversion::GraphSketch. If capacity is positive, the graphs saved in the file are read and summarized by 
+	a sketch of that capacity, probabilities of inclusion are computed as in Summary_Graph(). If capacity is zero, the sketches and the probabilities of inclusion
+	computed during the sampling are read, the sampler has to be run with a positive sketch_capacity. Sketches of different chains are merged, probabilities are averaged.
+	If top_k is positive, only the top_k most visited graphs are returned.*/
+	std::tuple<MatRow, HDF5conversion::SketchedGraphs, long long, std::size_t> //plinks, graphs with frequency and error, total visits, capacity
+	Summary_GraphSketch(HDF5conversion::FileType & file, unsigned int const & stored_iter, unsigned int const & p, std::size_t const & capacity, GroupsPtr const & groups = nullptr, 
+						std::vector<std::string> const & chains = {"/"}, std::size_t const & top_k = 0)
+	{
+		const unsigned int n_elem = Graph_Elements(p, groups);
+		if(capacity == 0){
+			MatRow plinks(MatRow::Zero(p,p));
+			HDF5conversion::GraphSketch sketch;
+			for(unsigned int k = 0; k < chains.size(); ++k){
+				if(!HDF5conversion::HasGraphSketch(file, chains[k]))
+					throw std::runtime_error("Error, the file does not contain the sketch of the visited graphs. Run the sampler with a positive sketch_capacity or set a positive capacity");
+				if(k == 0)
+					sketch = HDF5conversion::ReadGraphSketch(file, chains[k], n_elem);
+				else
+					sketch.merge(HDF5conversion::ReadGraphSketch(file, chains[k], n_elem));
+				if(H5Lexists(file, (chains[k] + "SketchPlinks").data(), H5P_DEFAULT) > 0){ //it is not written if no graph was saved
+					HDF5conversion::DatasetType dataset_rd = Open_Dataset(file, chains[k], "SketchPlinks");
+					MatRow plinks_k(p,p);
+					if(H5Dread(dataset_rd, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, plinks_k.data()) < 0)
+						throw std::runtime_error("Error, can not read SketchPlinks");
+					H5Dclose(dataset_rd);
+					plinks += plinks_k;
+				}
+			}
+			return std::make_tuple(plinks / static_cast<double>(chains.size()), sketch.top(top_k), sketch.get_total(), sketch.get_capacity());
+		}
+		HDF5conversion::GraphSketch sketch(n_elem, capacity);
+		std::vector<double> plinks_adj(n_elem, 0.0);
+		double normalization{0};
+		for(unsigned int k = 0; k < chains.size(); ++k){
+			std::vector<double> weights(Read_Weights(file, stored_iter, chains[k]));
+			std::tuple<VecCol, std::vector<double>> tallied(Tally_Graphs(file, chains[k], n_elem, stored_iter, sketch, weights));
+			std::vector<double> const & links_weight_k = std::get<1>(tallied);
+			std::transform(plinks_adj.cbegin(), plinks_adj.cend(), links_weight_k.cbegin(), plinks_adj.begin(), std::plus<double>());
+			normalization += (weights.size() == 0) ? stored_iter : std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+		}
+		MatRow plinks = plinks_from_adj(plinks_adj, normalization, groups);
+		return std::make_tuple(plinks, sketch.top(top_k), sketch.get_total(), sketch.get_capacity());
+	}
+	std::tuple<MatRow, HDF5conversion::SketchedGraphs, long long, std::size_t>
+	Summary_GraphSketch(std::string const & file_name, unsigned int const & stored_iter, unsigned int const & p, std::size_t const & capacity, GroupsPtr const & groups = nullptr, 
+						std::vector<std::string> const & chains = {"/"}, std::size_t const & top_k = 0)
+	{
+		return Read_File(file_name, [&](HDF5conversion::FileType & file){return Summary_GraphSketch(file, stored_iter, p, capacity, groups, chains, top_k);});
 	}
 
 }
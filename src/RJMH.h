@@ -48,11 +48,11 @@ class ReversibleJumpsMH : public GGM<GraphStructure, T> {
 		using ReturnType 		= typename GGMTraits<GraphStructure, T>::ReturnType;
 		//Constructors
 		ReversibleJumpsMH(	PriorPtr& _ptr_prior,double const & _b , MatCol const & _D, double const & _trGwishSampler, double const & _sigma, 
-						  			unsigned int const & _MCiterPrior = 100):
-						  			GGM<GraphStructure, T>(_ptr_prior, _b, _D, _trGwishSampler), sigma(_sigma), MCiterPrior(_MCiterPrior) {}
+						  			unsigned int const & _MCiterPrior = 100, ConstantRatio const & _ratio_mode = ConstantRatio::MC):
+						  			GGM<GraphStructure, T>(_ptr_prior, _b, _D, _trGwishSampler), sigma(_sigma), MCiterPrior(_MCiterPrior), ratio_mode(_ratio_mode) {}
 		ReversibleJumpsMH(	PriorPtr& _ptr_prior,unsigned int const & _p, double const & _trGwishSampler, double const & _sigma, 
-									unsigned int const & _MCiterPrior = 100 ):
-						  			GGM<GraphStructure, T>(_ptr_prior, _p, _trGwishSampler), sigma(_sigma), MCiterPrior(_MCiterPrior) {}
+									unsigned int const & _MCiterPrior = 100, ConstantRatio const & _ratio_mode = ConstantRatio::MC ):
+						  			GGM<GraphStructure, T>(_ptr_prior, _p, _trGwishSampler), sigma(_sigma), MCiterPrior(_MCiterPrior), ratio_mode(_ratio_mode) {}
 		
 		//Our proposed RJ move
 		template< template <typename> class GG = GraphStructure, typename TT = T,
@@ -75,9 +75,26 @@ class ReversibleJumpsMH : public GGM<GraphStructure, T> {
 		
 		//Call operator
 		ReturnType operator()(MatCol const & data, unsigned int const & n, Graph & Gold, double alpha, sample::GSL_RNG const & engine = sample::GSL_RNG());
+		std::unique_ptr<GGM<GraphStructure, T>> clone()const override{
+			return std::make_unique<ReversibleJumpsMH>(*this);
+		}
+		double get_proposal_scale()const override{
+			return sigma;
+		}
+		void set_proposal_scale(double const & scale) override{
+			sigma = scale;
+		}
 	protected:
-		double const sigma; //it is a standard deviation
+		//Robbins-Monro step on log(sigma), log(sigma) += gamma_t*(acceptance_ratio - target) with gamma_t = t^(-0.6). It does nothing if adaptation is not active
+		void adapt_sigma(double const & acceptance_ratio){
+			if(!this->adapt_scale)
+				return;
+			const double gamma = std::pow(static_cast<double>(++this->n_adapted), -0.6);
+			sigma = std::exp( std::log(sigma) + gamma*(acceptance_ratio - this->target_acceptance) );
+		}
+		double sigma; //it is a standard deviation
 		unsigned int MCiterPrior;
+		ConstantRatio ratio_mode;
 };
 
 
@@ -585,8 +602,14 @@ ReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsigned i
 	bool isInf_new{false};
 	bool isInf_old{false};
 
+	//D+U is changing every iteration or not? if not, just factorize it once. It is needed by informed proposals too
+	if(!this->data_factorized){
+		this->D_plus_U = this->Kprior.get_inv_scale() + this->beta*data;	
+		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
+		this->data_factorized = true;
+	}
 	//1) Propose new Graph
-	auto [Gnew, log_GraphMove_proposal, mv_type] = this->propose_new_graph(Gold, alpha, engine) ;
+	auto [Gnew, log_GraphMove_proposal, mv_type] = this->propose(Gold, alpha, n, engine) ;
 	//2) Perform RJ according to the proposed move and graph
 	CompleteType Gnew_complete(Gnew.completeview());
 	CompleteType Gold_complete(Gold.completeview());
@@ -595,17 +618,23 @@ ReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsigned i
 	//3) Compute acceptance probability ratio
 	PrecisionType& Kold_prior = this->Kprior; //lighter notation to avoid this-> every time
 	double log_GraphPr_ratio(this->ptr_prior->log_ratio(Gnew, Gold));
-	double const_old = 	Kold_prior.log_normalizing_constat(Gold_complete,MCiterPrior, engine);						  
-	double const_new = 	Knew_prior.log_normalizing_constat(Gnew_complete,MCiterPrior, engine);	
-	if(const_new < std::numeric_limits<double>::min()){
-		isInf_new = true;
-		//std::cout<<std::endl<<"Inf in GWish const prior new"<<std::endl;
+	double log_GWishPrConst_ratio{0};
+	if(ratio_mode == ConstantRatio::Approx){
+		log_GWishPrConst_ratio = - this->log_constant_ratio_approx(Kold_prior, Gnew, mv_type); //Knew_prior has the same shape and inverse scale
 	}
-	if(const_old < std::numeric_limits<double>::min()){
-		isInf_old = true;
-		//std::cout<<std::endl<<"Inf in GWish const prior old"<<std::endl;
+	else{
+		double const_old = 	Kold_prior.log_normalizing_constat(Gold_complete,MCiterPrior, engine);						  
+		double const_new = 	Knew_prior.log_normalizing_constat(Gnew_complete,MCiterPrior, engine);	
+		if(const_new < std::numeric_limits<double>::min()){
+			isInf_new = true;
+			//std::cout<<std::endl<<"Inf in GWish const prior new"<<std::endl;
+		}
+		if(const_old < std::numeric_limits<double>::min()){
+			isInf_old = true;
+			//std::cout<<std::endl<<"Inf in GWish const prior old"<<std::endl;
+		}
+		log_GWishPrConst_ratio = const_old - const_new;					  
 	}
-	double log_GWishPrConst_ratio(const_old - const_new);					  
 	auto TraceProd = [](MatRow const & A, MatCol const & B){
 		double res{0};
 		#pragma omp parallel for reduction(+:res)
@@ -616,12 +645,6 @@ ReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsigned i
 
 	
 	
-	//D+U is changing every iteration or not? if not, just factorize it once
-	if(!this->data_factorized){
-		this->D_plus_U = this->Kprior.get_inv_scale() + data;	
-		this->chol_inv_DplusU = this->D_plus_U.llt().solve(MatCol::Identity(data.rows(),data.rows())).llt().matrixU();
-		this->data_factorized = true;
-	}
 	double log_LL_GWishPr_ratio(  TraceProd( Knew_prior.get_matrix() - Kold_prior.get_matrix() , this->D_plus_U)  );
 	if(mv_type == MoveType::Add)
 		log_acceptance_ratio = log_GWishPrConst_ratio + log_GraphPr_ratio + log_GraphMove_proposal + log_LL_GWishPr_ratio + log_rj_proposal + log_jacobian_mv;
@@ -633,6 +656,8 @@ ReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsigned i
 		acceptance_ratio = 1.0;
 	else if(isInf_new)
 		acceptance_ratio = 0.0;
+	this->adapt_sigma(acceptance_ratio);
+	this->last_acceptance = acceptance_ratio;
 
 	//4) Perform the move and return
 	int accepted;
@@ -644,7 +669,7 @@ ReversibleJumpsMH<GraphStructure, T>::operator()(MatCol const & data, unsigned i
 		accepted = 0;
 	}
 	this->Kprior.set_matrix(Gold_complete, 
-		utils::rgwish<CompleteSkeleton, T, utils::ScaleForm::CholUpper_InvScale, utils::MeanNorm>(Gold_complete, this->Kprior.get_shape() + n, this->chol_inv_DplusU , this->trGwishSampler, engine ) ); 
+		utils::rgwish<CompleteSkeleton, T, utils::ScaleForm::CholUpper_InvScale, utils::MeanNorm>(Gold_complete, this->Kprior.get_shape() + this->beta*n, this->chol_inv_DplusU , this->trGwishSampler, engine ) ); 
 	this->Kprior.compute_Chol();
 	return std::make_tuple(this->Kprior.get_matrix(), accepted);
 }
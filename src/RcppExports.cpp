@@ -146,8 +146,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // Compute_Quantiles
-Rcpp::List Compute_Quantiles(Rcpp::String const& file_name, bool Beta, bool Mu, bool TauEps, bool Precision, double const& lower_qtl, double const& upper_qtl);
-RcppExport SEXP _BGSL_Compute_Quantiles(SEXP file_nameSEXP, SEXP BetaSEXP, SEXP MuSEXP, SEXP TauEpsSEXP, SEXP PrecisionSEXP, SEXP lower_qtlSEXP, SEXP upper_qtlSEXP) {
+Rcpp::List Compute_Quantiles(Rcpp::String const& file_name, bool Beta, bool Mu, bool TauEps, bool Precision, double const& lower_qtl, double const& upper_qtl, int chain);
+RcppExport SEXP _BGSL_Compute_Quantiles(SEXP file_nameSEXP, SEXP BetaSEXP, SEXP MuSEXP, SEXP TauEpsSEXP, SEXP PrecisionSEXP, SEXP lower_qtlSEXP, SEXP upper_qtlSEXP, SEXP chainSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -158,13 +158,14 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< bool >::type Precision(PrecisionSEXP);
     Rcpp::traits::input_parameter< double const& >::type lower_qtl(lower_qtlSEXP);
     Rcpp::traits::input_parameter< double const& >::type upper_qtl(upper_qtlSEXP);
-    rcpp_result_gen = Rcpp::wrap(Compute_Quantiles(file_name, Beta, Mu, TauEps, Precision, lower_qtl, upper_qtl));
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(Compute_Quantiles(file_name, Beta, Mu, TauEps, Precision, lower_qtl, upper_qtl, chain));
     return rcpp_result_gen;
 END_RCPP
 }
 // Compute_PosteriorMeans
-Rcpp::List Compute_PosteriorMeans(Rcpp::String const& file_name, bool Beta, bool Mu, bool TauEps, bool Precision);
-RcppExport SEXP _BGSL_Compute_PosteriorMeans(SEXP file_nameSEXP, SEXP BetaSEXP, SEXP MuSEXP, SEXP TauEpsSEXP, SEXP PrecisionSEXP) {
+Rcpp::List Compute_PosteriorMeans(Rcpp::String const& file_name, bool Beta, bool Mu, bool TauEps, bool Precision, int chain);
+RcppExport SEXP _BGSL_Compute_PosteriorMeans(SEXP file_nameSEXP, SEXP BetaSEXP, SEXP MuSEXP, SEXP TauEpsSEXP, SEXP PrecisionSEXP, SEXP chainSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -173,13 +174,14 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< bool >::type Mu(MuSEXP);
     Rcpp::traits::input_parameter< bool >::type TauEps(TauEpsSEXP);
     Rcpp::traits::input_parameter< bool >::type Precision(PrecisionSEXP);
-    rcpp_result_gen = Rcpp::wrap(Compute_PosteriorMeans(file_name, Beta, Mu, TauEps, Precision));
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(Compute_PosteriorMeans(file_name, Beta, Mu, TauEps, Precision, chain));
     return rcpp_result_gen;
 END_RCPP
 }
 // Extract_Chain
-Eigen::VectorXd Extract_Chain(Rcpp::String const& file_name, Rcpp::String const& variable, unsigned int index1, unsigned int index2);
-RcppExport SEXP _BGSL_Extract_Chain(SEXP file_nameSEXP, SEXP variableSEXP, SEXP index1SEXP, SEXP index2SEXP) {
+Eigen::VectorXd Extract_Chain(Rcpp::String const& file_name, Rcpp::String const& variable, unsigned int index1, unsigned int index2, int chain);
+RcppExport SEXP _BGSL_Extract_Chain(SEXP file_nameSEXP, SEXP variableSEXP, SEXP index1SEXP, SEXP index2SEXP, SEXP chainSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -187,19 +189,170 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< Rcpp::String const& >::type variable(variableSEXP);
     Rcpp::traits::input_parameter< unsigned int >::type index1(index1SEXP);
     Rcpp::traits::input_parameter< unsigned int >::type index2(index2SEXP);
-    rcpp_result_gen = Rcpp::wrap(Extract_Chain(file_name, variable, index1, index2));
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(Extract_Chain(file_name, variable, index1, index2, chain));
     return rcpp_result_gen;
 END_RCPP
 }
+// Extract_LiveChain
+Eigen::VectorXd Extract_LiveChain(Rcpp::String const& file_name, Rcpp::String const& variable, unsigned int index1, unsigned int index2, int chain);
+RcppExport SEXP _BGSL_Extract_LiveChain(SEXP file_nameSEXP, SEXP variableSEXP, SEXP index1SEXP, SEXP index2SEXP, SEXP chainSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< unsigned int >::type index1(index1SEXP);
+    Rcpp::traits::input_parameter< unsigned int >::type index2(index2SEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(Extract_LiveChain(file_name, variable, index1, index2, chain));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Transpose_Chains
+void Transpose_Chains(Rcpp::String const& file_name, bool const& contiguous);
+RcppExport SEXP _BGSL_Transpose_Chains(SEXP file_nameSEXP, SEXP contiguousSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
+    Rcpp::traits::input_parameter< bool const& >::type contiguous(contiguousSEXP);
+    Transpose_Chains(file_name, contiguous);
+    return R_NilValue;
+END_RCPP
+}
 // Summary_Graph
-Rcpp::List Summary_Graph(Rcpp::String const& file_name, Rcpp::Nullable<Rcpp::List> groups);
-RcppExport SEXP _BGSL_Summary_Graph(SEXP file_nameSEXP, SEXP groupsSEXP) {
+Rcpp::List Summary_Graph(Rcpp::String const& file_name, Rcpp::Nullable<Rcpp::List> groups, int chain, int top_k);
+RcppExport SEXP _BGSL_Summary_Graph(SEXP file_nameSEXP, SEXP groupsSEXP, SEXP chainSEXP, SEXP top_kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::List> >::type groups(groupsSEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    Rcpp::traits::input_parameter< int >::type top_k(top_kSEXP);
+    rcpp_result_gen = Rcpp::wrap(Summary_Graph(file_name, groups, chain, top_k));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Summary_GraphSketch
+Rcpp::List Summary_GraphSketch(Rcpp::String const& file_name, int capacity, int top_k, Rcpp::Nullable<Rcpp::List> groups, int chain);
+RcppExport SEXP _BGSL_Summary_GraphSketch(SEXP file_nameSEXP, SEXP capacitySEXP, SEXP top_kSEXP, SEXP groupsSEXP, SEXP chainSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
+    Rcpp::traits::input_parameter< int >::type capacity(capacitySEXP);
+    Rcpp::traits::input_parameter< int >::type top_k(top_kSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::List> >::type groups(groupsSEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(Summary_GraphSketch(file_name, capacity, top_k, groups, chain));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Read_plinksRB
+Eigen::MatrixXd Read_plinksRB(Rcpp::String const& file_name, int chain);
+RcppExport SEXP _BGSL_Read_plinksRB(SEXP file_nameSEXP, SEXP chainSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(Read_plinksRB(file_name, chain));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Open_ResultFile
+SEXP Open_ResultFile(Rcpp::String const& file_name);
+RcppExport SEXP _BGSL_Open_ResultFile(SEXP file_nameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
+    rcpp_result_gen = Rcpp::wrap(Open_ResultFile(file_name));
+    return rcpp_result_gen;
+END_RCPP
+}
+// Close_ResultFile
+void Close_ResultFile(SEXP handle);
+RcppExport SEXP _BGSL_Close_ResultFile(SEXP handleSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Close_ResultFile(handle);
+    return R_NilValue;
+END_RCPP
+}
+// ResultFile_Info
+Rcpp::List ResultFile_Info(SEXP handle);
+RcppExport SEXP _BGSL_ResultFile_Info(SEXP handleSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    rcpp_result_gen = Rcpp::wrap(ResultFile_Info(handle));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ResultFile_PosteriorMeans
+Rcpp::List ResultFile_PosteriorMeans(SEXP handle, bool Beta, bool Mu, bool TauEps, bool Precision, int chain);
+RcppExport SEXP _BGSL_ResultFile_PosteriorMeans(SEXP handleSEXP, SEXP BetaSEXP, SEXP MuSEXP, SEXP TauEpsSEXP, SEXP PrecisionSEXP, SEXP chainSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< bool >::type Beta(BetaSEXP);
+    Rcpp::traits::input_parameter< bool >::type Mu(MuSEXP);
+    Rcpp::traits::input_parameter< bool >::type TauEps(TauEpsSEXP);
+    Rcpp::traits::input_parameter< bool >::type Precision(PrecisionSEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(ResultFile_PosteriorMeans(handle, Beta, Mu, TauEps, Precision, chain));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ResultFile_Quantiles
+Rcpp::List ResultFile_Quantiles(SEXP handle, bool Beta, bool Mu, bool TauEps, bool Precision, double const& lower_qtl, double const& upper_qtl, int chain);
+RcppExport SEXP _BGSL_ResultFile_Quantiles(SEXP handleSEXP, SEXP BetaSEXP, SEXP MuSEXP, SEXP TauEpsSEXP, SEXP PrecisionSEXP, SEXP lower_qtlSEXP, SEXP upper_qtlSEXP, SEXP chainSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< bool >::type Beta(BetaSEXP);
+    Rcpp::traits::input_parameter< bool >::type Mu(MuSEXP);
+    Rcpp::traits::input_parameter< bool >::type TauEps(TauEpsSEXP);
+    Rcpp::traits::input_parameter< bool >::type Precision(PrecisionSEXP);
+    Rcpp::traits::input_parameter< double const& >::type lower_qtl(lower_qtlSEXP);
+    Rcpp::traits::input_parameter< double const& >::type upper_qtl(upper_qtlSEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(ResultFile_Quantiles(handle, Beta, Mu, TauEps, Precision, lower_qtl, upper_qtl, chain));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ResultFile_Extract_Chains
+Eigen::MatrixXd ResultFile_Extract_Chains(SEXP handle, Rcpp::String const& variable, Rcpp::IntegerVector const& index1, Rcpp::IntegerVector const& index2, int chain);
+RcppExport SEXP _BGSL_ResultFile_Extract_Chains(SEXP handleSEXP, SEXP variableSEXP, SEXP index1SEXP, SEXP index2SEXP, SEXP chainSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::IntegerVector const& >::type index1(index1SEXP);
+    Rcpp::traits::input_parameter< Rcpp::IntegerVector const& >::type index2(index2SEXP);
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    rcpp_result_gen = Rcpp::wrap(ResultFile_Extract_Chains(handle, variable, index1, index2, chain));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ResultFile_Summary_Graph
+Rcpp::List ResultFile_Summary_Graph(SEXP handle, Rcpp::Nullable<Rcpp::List> groups, int chain, int top_k);
+RcppExport SEXP _BGSL_ResultFile_Summary_Graph(SEXP handleSEXP, SEXP groupsSEXP, SEXP chainSEXP, SEXP top_kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::List> >::type groups(groupsSEXP);
-    rcpp_result_gen = Rcpp::wrap(Summary_Graph(file_name, groups));
+    Rcpp::traits::input_parameter< int >::type chain(chainSEXP);
+    Rcpp::traits::input_parameter< int >::type top_k(top_kSEXP);
+    rcpp_result_gen = Rcpp::wrap(ResultFile_Summary_Graph(handle, groups, chain, top_k));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -236,8 +389,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // GGM_sampling_c
-Rcpp::List GGM_sampling_c(Eigen::MatrixXd const& data, int const& p, int const& n, int const& niter, int const& burnin, double const& thin, Rcpp::String file_name, Eigen::MatrixXd D, double const& b, Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const& G0, Eigen::MatrixXd const& K0, int const& MCprior, int const& MCpost, double const& threshold, Rcpp::String form, Rcpp::String prior, Rcpp::String algo, Rcpp::Nullable<Rcpp::List> groups, int seed, double const& Gprior, double const& sigmaG, double const& paddrm, bool print_info);
-RcppExport SEXP _BGSL_GGM_sampling_c(SEXP dataSEXP, SEXP pSEXP, SEXP nSEXP, SEXP niterSEXP, SEXP burninSEXP, SEXP thinSEXP, SEXP file_nameSEXP, SEXP DSEXP, SEXP bSEXP, SEXP G0SEXP, SEXP K0SEXP, SEXP MCpriorSEXP, SEXP MCpostSEXP, SEXP thresholdSEXP, SEXP formSEXP, SEXP priorSEXP, SEXP algoSEXP, SEXP groupsSEXP, SEXP seedSEXP, SEXP GpriorSEXP, SEXP sigmaGSEXP, SEXP paddrmSEXP, SEXP print_infoSEXP) {
+Rcpp::List GGM_sampling_c(Eigen::MatrixXd const& data, int const& p, int const& n, int const& niter, int const& burnin, double const& thin, Rcpp::String file_name, Eigen::MatrixXd D, double const& b, Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const& G0, Eigen::MatrixXd const& K0, Rcpp::List const& Param, Rcpp::String form, Rcpp::String prior, Rcpp::String algo, Rcpp::Nullable<Rcpp::List> groups, int seed, double const& Gprior, double const& sigmaG, double const& paddrm, bool print_info);
+RcppExport SEXP _BGSL_GGM_sampling_c(SEXP dataSEXP, SEXP pSEXP, SEXP nSEXP, SEXP niterSEXP, SEXP burninSEXP, SEXP thinSEXP, SEXP file_nameSEXP, SEXP DSEXP, SEXP bSEXP, SEXP G0SEXP, SEXP K0SEXP, SEXP ParamSEXP, SEXP formSEXP, SEXP priorSEXP, SEXP algoSEXP, SEXP groupsSEXP, SEXP seedSEXP, SEXP GpriorSEXP, SEXP sigmaGSEXP, SEXP paddrmSEXP, SEXP print_infoSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -252,9 +405,7 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< double const& >::type b(bSEXP);
     Rcpp::traits::input_parameter< Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const& >::type G0(G0SEXP);
     Rcpp::traits::input_parameter< Eigen::MatrixXd const& >::type K0(K0SEXP);
-    Rcpp::traits::input_parameter< int const& >::type MCprior(MCpriorSEXP);
-    Rcpp::traits::input_parameter< int const& >::type MCpost(MCpostSEXP);
-    Rcpp::traits::input_parameter< double const& >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type Param(ParamSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type form(formSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type prior(priorSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type algo(algoSEXP);
@@ -264,13 +415,13 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< double const& >::type sigmaG(sigmaGSEXP);
     Rcpp::traits::input_parameter< double const& >::type paddrm(paddrmSEXP);
     Rcpp::traits::input_parameter< bool >::type print_info(print_infoSEXP);
-    rcpp_result_gen = Rcpp::wrap(GGM_sampling_c(data, p, n, niter, burnin, thin, file_name, D, b, G0, K0, MCprior, MCpost, threshold, form, prior, algo, groups, seed, Gprior, sigmaG, paddrm, print_info));
+    rcpp_result_gen = Rcpp::wrap(GGM_sampling_c(data, p, n, niter, burnin, thin, file_name, D, b, G0, K0, Param, form, prior, algo, groups, seed, Gprior, sigmaG, paddrm, print_info));
     return rcpp_result_gen;
 END_RCPP
 }
 // FLM_sampling_c
-Rcpp::List FLM_sampling_c(Eigen::MatrixXd const& data, int const& niter, int const& burnin, double const& thin, Eigen::MatrixXd const& BaseMat, Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> G, Eigen::MatrixXd const& Beta0, Eigen::VectorXd const& mu0, double const& tau_eps0, Eigen::VectorXd const& tauK0, Eigen::MatrixXd const& K0, double const& a_tau_eps, double const& b_tau_eps, double const& sigmamu, double const& aTauK, double const& bTauK, double const& bK, Eigen::MatrixXd const& DK, Rcpp::String file_name, bool diagonal_graph, double const& threshold_GWish, int seed, bool print_info);
-RcppExport SEXP _BGSL_FLM_sampling_c(SEXP dataSEXP, SEXP niterSEXP, SEXP burninSEXP, SEXP thinSEXP, SEXP BaseMatSEXP, SEXP GSEXP, SEXP Beta0SEXP, SEXP mu0SEXP, SEXP tau_eps0SEXP, SEXP tauK0SEXP, SEXP K0SEXP, SEXP a_tau_epsSEXP, SEXP b_tau_epsSEXP, SEXP sigmamuSEXP, SEXP aTauKSEXP, SEXP bTauKSEXP, SEXP bKSEXP, SEXP DKSEXP, SEXP file_nameSEXP, SEXP diagonal_graphSEXP, SEXP threshold_GWishSEXP, SEXP seedSEXP, SEXP print_infoSEXP) {
+Rcpp::List FLM_sampling_c(Eigen::MatrixXd const& data, int const& niter, int const& burnin, double const& thin, Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> G, Eigen::MatrixXd const& Beta0, Eigen::VectorXd const& mu0, double const& tau_eps0, Eigen::VectorXd const& tauK0, Eigen::MatrixXd const& K0, double const& a_tau_eps, double const& b_tau_eps, double const& sigmamu, double const& aTauK, double const& bTauK, double const& bK, Eigen::MatrixXd const& DK, Rcpp::String file_name, bool diagonal_graph, Rcpp::List const& Param, int seed, bool print_info);
+RcppExport SEXP _BGSL_FLM_sampling_c(SEXP dataSEXP, SEXP niterSEXP, SEXP burninSEXP, SEXP thinSEXP, SEXP GSEXP, SEXP Beta0SEXP, SEXP mu0SEXP, SEXP tau_eps0SEXP, SEXP tauK0SEXP, SEXP K0SEXP, SEXP a_tau_epsSEXP, SEXP b_tau_epsSEXP, SEXP sigmamuSEXP, SEXP aTauKSEXP, SEXP bTauKSEXP, SEXP bKSEXP, SEXP DKSEXP, SEXP file_nameSEXP, SEXP diagonal_graphSEXP, SEXP ParamSEXP, SEXP seedSEXP, SEXP print_infoSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -278,7 +429,6 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< int const& >::type niter(niterSEXP);
     Rcpp::traits::input_parameter< int const& >::type burnin(burninSEXP);
     Rcpp::traits::input_parameter< double const& >::type thin(thinSEXP);
-    Rcpp::traits::input_parameter< Eigen::MatrixXd const& >::type BaseMat(BaseMatSEXP);
     Rcpp::traits::input_parameter< Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> >::type G(GSEXP);
     Rcpp::traits::input_parameter< Eigen::MatrixXd const& >::type Beta0(Beta0SEXP);
     Rcpp::traits::input_parameter< Eigen::VectorXd const& >::type mu0(mu0SEXP);
@@ -294,16 +444,16 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< Eigen::MatrixXd const& >::type DK(DKSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type file_name(file_nameSEXP);
     Rcpp::traits::input_parameter< bool >::type diagonal_graph(diagonal_graphSEXP);
-    Rcpp::traits::input_parameter< double const& >::type threshold_GWish(threshold_GWishSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type Param(ParamSEXP);
     Rcpp::traits::input_parameter< int >::type seed(seedSEXP);
     Rcpp::traits::input_parameter< bool >::type print_info(print_infoSEXP);
-    rcpp_result_gen = Rcpp::wrap(FLM_sampling_c(data, niter, burnin, thin, BaseMat, G, Beta0, mu0, tau_eps0, tauK0, K0, a_tau_eps, b_tau_eps, sigmamu, aTauK, bTauK, bK, DK, file_name, diagonal_graph, threshold_GWish, seed, print_info));
+    rcpp_result_gen = Rcpp::wrap(FLM_sampling_c(data, niter, burnin, thin, G, Beta0, mu0, tau_eps0, tauK0, K0, a_tau_eps, b_tau_eps, sigmamu, aTauK, bTauK, bK, DK, file_name, diagonal_graph, Param, seed, print_info));
     return rcpp_result_gen;
 END_RCPP
 }
 // FGM_sampling_c
-Rcpp::List FGM_sampling_c(Eigen::MatrixXd const& data, int const& niter, int const& burnin, double const& thin, double const& thinG, Eigen::MatrixXd const& BaseMat, Rcpp::String const& file_name, Eigen::MatrixXd const& Beta0, Eigen::VectorXd const& mu0, double const& tau_eps0, Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const& G0, Eigen::MatrixXd const& K0, double const& a_tau_eps, double const& b_tau_eps, double const& sigmamu, double const& bK, Eigen::MatrixXd const& DK, double const& sigmaG, double const& paddrm, double const& Gprior, int const& MCprior, int const& MCpost, double const& threshold, Rcpp::String form, Rcpp::String prior, Rcpp::String algo, Rcpp::Nullable<Rcpp::List> groups, int seed, bool print_info);
-RcppExport SEXP _BGSL_FGM_sampling_c(SEXP dataSEXP, SEXP niterSEXP, SEXP burninSEXP, SEXP thinSEXP, SEXP thinGSEXP, SEXP BaseMatSEXP, SEXP file_nameSEXP, SEXP Beta0SEXP, SEXP mu0SEXP, SEXP tau_eps0SEXP, SEXP G0SEXP, SEXP K0SEXP, SEXP a_tau_epsSEXP, SEXP b_tau_epsSEXP, SEXP sigmamuSEXP, SEXP bKSEXP, SEXP DKSEXP, SEXP sigmaGSEXP, SEXP paddrmSEXP, SEXP GpriorSEXP, SEXP MCpriorSEXP, SEXP MCpostSEXP, SEXP thresholdSEXP, SEXP formSEXP, SEXP priorSEXP, SEXP algoSEXP, SEXP groupsSEXP, SEXP seedSEXP, SEXP print_infoSEXP) {
+Rcpp::List FGM_sampling_c(Eigen::MatrixXd const& data, int const& niter, int const& burnin, double const& thin, double const& thinG, Rcpp::String const& file_name, Eigen::MatrixXd const& Beta0, Eigen::VectorXd const& mu0, double const& tau_eps0, Eigen::Matrix<unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> const& G0, Eigen::MatrixXd const& K0, double const& a_tau_eps, double const& b_tau_eps, double const& sigmamu, double const& bK, Eigen::MatrixXd const& DK, double const& sigmaG, double const& paddrm, double const& Gprior, Rcpp::List const& Param, Rcpp::String form, Rcpp::String prior, Rcpp::String algo, Rcpp::Nullable<Rcpp::List> groups, int seed, bool print_info);
+RcppExport SEXP _BGSL_FGM_sampling_c(SEXP dataSEXP, SEXP niterSEXP, SEXP burninSEXP, SEXP thinSEXP, SEXP thinGSEXP, SEXP file_nameSEXP, SEXP Beta0SEXP, SEXP mu0SEXP, SEXP tau_eps0SEXP, SEXP G0SEXP, SEXP K0SEXP, SEXP a_tau_epsSEXP, SEXP b_tau_epsSEXP, SEXP sigmamuSEXP, SEXP bKSEXP, SEXP DKSEXP, SEXP sigmaGSEXP, SEXP paddrmSEXP, SEXP GpriorSEXP, SEXP ParamSEXP, SEXP formSEXP, SEXP priorSEXP, SEXP algoSEXP, SEXP groupsSEXP, SEXP seedSEXP, SEXP print_infoSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -312,7 +462,6 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< int const& >::type burnin(burninSEXP);
     Rcpp::traits::input_parameter< double const& >::type thin(thinSEXP);
     Rcpp::traits::input_parameter< double const& >::type thinG(thinGSEXP);
-    Rcpp::traits::input_parameter< Eigen::MatrixXd const& >::type BaseMat(BaseMatSEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type file_name(file_nameSEXP);
     Rcpp::traits::input_parameter< Eigen::MatrixXd const& >::type Beta0(Beta0SEXP);
     Rcpp::traits::input_parameter< Eigen::VectorXd const& >::type mu0(mu0SEXP);
@@ -327,16 +476,14 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< double const& >::type sigmaG(sigmaGSEXP);
     Rcpp::traits::input_parameter< double const& >::type paddrm(paddrmSEXP);
     Rcpp::traits::input_parameter< double const& >::type Gprior(GpriorSEXP);
-    Rcpp::traits::input_parameter< int const& >::type MCprior(MCpriorSEXP);
-    Rcpp::traits::input_parameter< int const& >::type MCpost(MCpostSEXP);
-    Rcpp::traits::input_parameter< double const& >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< Rcpp::List const& >::type Param(ParamSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type form(formSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type prior(priorSEXP);
     Rcpp::traits::input_parameter< Rcpp::String >::type algo(algoSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::List> >::type groups(groupsSEXP);
     Rcpp::traits::input_parameter< int >::type seed(seedSEXP);
     Rcpp::traits::input_parameter< bool >::type print_info(print_infoSEXP);
-    rcpp_result_gen = Rcpp::wrap(FGM_sampling_c(data, niter, burnin, thin, thinG, BaseMat, file_name, Beta0, mu0, tau_eps0, G0, K0, a_tau_eps, b_tau_eps, sigmamu, bK, DK, sigmaG, paddrm, Gprior, MCprior, MCpost, threshold, form, prior, algo, groups, seed, print_info));
+    rcpp_result_gen = Rcpp::wrap(FGM_sampling_c(data, niter, burnin, thin, thinG, file_name, Beta0, mu0, tau_eps0, G0, K0, a_tau_eps, b_tau_eps, sigmamu, bK, DK, sigmaG, paddrm, Gprior, Param, form, prior, algo, groups, seed, print_info));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -436,15 +583,26 @@ static const R_CallMethodDef CallEntries[] = {
     {"_BGSL_Generate_Basis", (DL_FUNC) &_BGSL_Generate_Basis, 5},
     {"_BGSL_Generate_Basis_derivatives", (DL_FUNC) &_BGSL_Generate_Basis_derivatives, 6},
     {"_BGSL_Read_InfoFile", (DL_FUNC) &_BGSL_Read_InfoFile, 1},
-    {"_BGSL_Compute_Quantiles", (DL_FUNC) &_BGSL_Compute_Quantiles, 7},
-    {"_BGSL_Compute_PosteriorMeans", (DL_FUNC) &_BGSL_Compute_PosteriorMeans, 5},
-    {"_BGSL_Extract_Chain", (DL_FUNC) &_BGSL_Extract_Chain, 4},
-    {"_BGSL_Summary_Graph", (DL_FUNC) &_BGSL_Summary_Graph, 2},
+    {"_BGSL_Compute_Quantiles", (DL_FUNC) &_BGSL_Compute_Quantiles, 8},
+    {"_BGSL_Compute_PosteriorMeans", (DL_FUNC) &_BGSL_Compute_PosteriorMeans, 6},
+    {"_BGSL_Extract_Chain", (DL_FUNC) &_BGSL_Extract_Chain, 5},
+    {"_BGSL_Extract_LiveChain", (DL_FUNC) &_BGSL_Extract_LiveChain, 5},
+    {"_BGSL_Transpose_Chains", (DL_FUNC) &_BGSL_Transpose_Chains, 2},
+    {"_BGSL_Summary_Graph", (DL_FUNC) &_BGSL_Summary_Graph, 4},
+    {"_BGSL_Summary_GraphSketch", (DL_FUNC) &_BGSL_Summary_GraphSketch, 5},
+    {"_BGSL_Read_plinksRB", (DL_FUNC) &_BGSL_Read_plinksRB, 2},
+    {"_BGSL_Open_ResultFile", (DL_FUNC) &_BGSL_Open_ResultFile, 1},
+    {"_BGSL_Close_ResultFile", (DL_FUNC) &_BGSL_Close_ResultFile, 1},
+    {"_BGSL_ResultFile_Info", (DL_FUNC) &_BGSL_ResultFile_Info, 1},
+    {"_BGSL_ResultFile_PosteriorMeans", (DL_FUNC) &_BGSL_ResultFile_PosteriorMeans, 6},
+    {"_BGSL_ResultFile_Quantiles", (DL_FUNC) &_BGSL_ResultFile_Quantiles, 8},
+    {"_BGSL_ResultFile_Extract_Chains", (DL_FUNC) &_BGSL_ResultFile_Extract_Chains, 5},
+    {"_BGSL_ResultFile_Summary_Graph", (DL_FUNC) &_BGSL_ResultFile_Summary_Graph, 4},
     {"_BGSL_SimulateData_GGM_c", (DL_FUNC) &_BGSL_SimulateData_GGM_c, 10},
     {"_BGSL_CreateGroups", (DL_FUNC) &_BGSL_CreateGroups, 2},
-    {"_BGSL_GGM_sampling_c", (DL_FUNC) &_BGSL_GGM_sampling_c, 23},
-    {"_BGSL_FLM_sampling_c", (DL_FUNC) &_BGSL_FLM_sampling_c, 23},
-    {"_BGSL_FGM_sampling_c", (DL_FUNC) &_BGSL_FGM_sampling_c, 29},
+    {"_BGSL_GGM_sampling_c", (DL_FUNC) &_BGSL_GGM_sampling_c, 21},
+    {"_BGSL_FLM_sampling_c", (DL_FUNC) &_BGSL_FLM_sampling_c, 22},
+    {"_BGSL_FGM_sampling_c", (DL_FUNC) &_BGSL_FGM_sampling_c, 26},
     {"_BGSL_Read_InfoFile_old", (DL_FUNC) &_BGSL_Read_InfoFile_old, 1},
     {"_BGSL_Compute_Quantiles_old", (DL_FUNC) &_BGSL_Compute_Quantiles_old, 12},
     {"_BGSL_Extract_Chain_old", (DL_FUNC) &_BGSL_Extract_Chain_old, 8},
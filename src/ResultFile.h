@@ -0,0 +1,102 @@
+#ifndef __RESULTFILE_HPP__
+#define __RESULTFILE_HPP__
+
+#include "PosteriorAnalysis.h"
+
+/*
+	File written by a sampler, kept open between the queries. /Info, /Sampler and the number of chains are read once, when the file is opened, and the chains
+	that are read element by element (see Extract_Chain() in BGSL_export.cpp) stay open after the first request. Hence reading many chains of the same file
+	does not pay an open and close of the file and of its datasets for each of them. Chain-major copies and raw files of the chains stay mapped as well.
+	The file is opened in read only mode, it has to be closed before modifying it, e.g by Transpose_Chains().
+	A live ResultFile can also open a file that a sampler is writing in SWMR mode, its info report the iterations that can be read by now, see HDF5conversion::ReadProgress().
+	It has to be opened again to see the values written afterwards.
+*/
+
+namespace analysis{
+
+	class ResultFile{
+		public:
+		ResultFile(std::string const & _file_name, bool const & live = false);
+		~ResultFile(){
+			close();
+		}
+		ResultFile(ResultFile const &) = delete;
+		ResultFile & operator=(ResultFile const &) = delete;
+		//Closes the datasets and the file. Further queries throw
+		void close();
+		inline bool is_open() const{
+			return file >= 0;
+		}
+		HDF5conversion::FileType & get_file();
+		inline std::string const & get_file_name() const{
+			return file_name;
+		}
+		//p, n, iter_to_store, iter_to_storeG and, if saved, the number of performed iterations. See HDF5conversion::GetInfo()
+		inline std::vector<unsigned int> const & get_info() const{
+			return info;
+		}
+		inline std::string const & get_sampler() const{
+			return sampler;
+		}
+		inline unsigned int get_nchains() const{
+			return nchains;
+		}
+		//Groups to be read, as HDF5conversion::GetChainGroups()
+		inline std::vector<std::string> chain_groups(int const & chain = 0) const{
+			return HDF5conversion::ChainGroups(nchains, chain);
+		}
+		//Chain of name saved in group, see Open_Chain(). It is opened by the first request and kept open
+		HDF5conversion::ChainReader & get_chain(std::string const & group, std::string const & name);
+		private:
+		std::string file_name;
+		HDF5conversion::FileType file{-1};
+		std::vector<unsigned int> info;
+		std::string sampler;
+		unsigned int nchains{1};
+		std::map<std::string, std::unique_ptr<HDF5conversion::ChainReader>> chains; //keyed by the path of the original dataset
+	};
+
+	inline ResultFile::ResultFile(std::string const & _file_name, bool const & live):file_name(_file_name)
+	{
+		file = Open_File(file_name, live);
+		try{
+			std::tie(info, sampler) = HDF5conversion::GetInfo(file);
+			nchains = HDF5conversion::GetNChains(file);
+			const std::vector<unsigned int> progress((live) ? HDF5conversion::ReadProgress(file) : std::vector<unsigned int>());
+			if(!progress.empty() && info.size() >= 4){ //the sampling is running, or it was interrupted
+				std::copy(progress.cbegin(), progress.cbegin() + 2, info.begin() + 2);
+				if(info.size() > 4)
+					info[4] = progress[2];
+			}
+		}
+		catch(...){
+			close();
+			throw;
+		}
+	}
+
+	inline void ResultFile::close()
+	{
+		chains.clear();
+		if(file >= 0)
+			H5Fclose(file);
+		file = -1;
+	}
+
+	inline HDF5conversion::FileType & ResultFile::get_file()
+	{
+		if(!is_open())
+			throw std::runtime_error("Error, the file " + file_name + " was closed");
+		return file;
+	}
+
+	inline HDF5conversion::ChainReader & ResultFile::get_chain(std::string const & group, std::string const & name)
+	{
+		auto it = chains.find(group + name);
+		if(it == chains.end())
+			it = chains.emplace(group + name, Open_Chain(get_file(), group, name)).first;
+		return *it->second;
+	}
+}
+
+#endif
@@ -127,6 +127,25 @@ class Parameters : public SamplerTraits{
 	unsigned int iter_to_store;
 	unsigned int iter_to_storeG;
 	double trGwishSampler;
+	unsigned int n_speculative{1}; //number of consecutive graph moves evaluated concurrently, see GGM::speculative_moves()
+	unsigned int n_replicas{1}; //number of tempered replicas of the graphical step, 1 means no tempering. See ParallelTempering
+	double max_temperature{10.0}; //temperature of the hottest replica
+	unsigned int swap_every{1}; //number of iterations between two rounds of swaps
+	bool adapt_sigma{false}; //adaptation of the proposal scale of RJ and DRJ during burn-in, see GGM::set_adaptation()
+	double target_acceptance{0.234}; //target acceptance probability of the adaptation
+	bool store_chain{true}; //if false, sampled values are not saved on file, only their online summaries are. Graphs are always saved. See summaries::OnlineSummary
+	double lower_qtl{0.05}; //levels of the quantiles estimated online
+	double upper_qtl{0.95};
+	double target_ess{0.0}; //sampling stops once the effective sample sizes reach target_ess and split-Rhat are below target_rhat. 0 means no early stopping
+	double target_rhat{1.01};
+	unsigned int check_every{1000}; //number of iterations between two checks of convergence diagnostics
+	bool report_diagnostics{false}; //if true, convergence diagnostics are computed and reported at the end even if target_ess is 0
+	unsigned int checkpoint_every{0}; //number of iterations between two checkpoints of the state of the sampler, 0 means no checkpoints. See HDF5conversion::WriteCheckpoint()
+	bool resume{false}; //if true, the sampling restarts from the last checkpoint saved in the file and keeps writing in its datasets
+	unsigned int keyframe_every{0}; //if positive, graphs are saved as an event log with a keyframe every keyframe_every saved graphs, see HDF5conversion::GraphLogWriter
+	unsigned int sketch_capacity{0}; //if positive, the most visited saved graphs are tracked while sampling by a sketch of this capacity, see HDF5conversion::GraphSketch
+	HDF5conversion::ChainFormat chain_format{HDF5conversion::ChainFormat::HDF5}; //format of the saved chains, see HDF5conversion::ChainWriter
+	unsigned int flush_every{0}; //if positive, the file is written in SWMR mode and the saved values are made visible to its readers every flush_every iterations. See HDF5conversion::StartLiveWriting()
 	friend std::ostream & operator<<(std::ostream &str, Parameters & pm){
 		str<<"niter = "<<pm.niter<<std::endl;
 		str<<"nburn = "<<pm.nburn<<std::endl;
@@ -138,6 +157,25 @@ class Parameters : public SamplerTraits{
 		str<<"iter_to_store  = "<<pm.iter_to_store<<std::endl;
 		str<<"iter_to_storeG = "<<pm.iter_to_storeG<<std::endl;
 		str<<"trGwishSampler = "<<pm.trGwishSampler<<std::endl;
+		str<<"n_speculative = "<<pm.n_speculative<<std::endl;
+		str<<"n_replicas = "<<pm.n_replicas<<std::endl;
+		str<<"max_temperature = "<<pm.max_temperature<<std::endl;
+		str<<"swap_every = "<<pm.swap_every<<std::endl;
+		str<<"adapt_sigma = "<<pm.adapt_sigma<<std::endl;
+		str<<"target_acceptance = "<<pm.target_acceptance<<std::endl;
+		str<<"store_chain = "<<pm.store_chain<<std::endl;
+		str<<"lower_qtl = "<<pm.lower_qtl<<std::endl;
+		str<<"upper_qtl = "<<pm.upper_qtl<<std::endl;
+		str<<"target_ess = "<<pm.target_ess<<std::endl;
+		str<<"target_rhat = "<<pm.target_rhat<<std::endl;
+		str<<"check_every = "<<pm.check_every<<std::endl;
+		str<<"report_diagnostics = "<<pm.report_diagnostics<<std::endl;
+		str<<"checkpoint_every = "<<pm.checkpoint_every<<std::endl;
+		str<<"resume = "<<pm.resume<<std::endl;
+		str<<"keyframe_every = "<<pm.keyframe_every<<std::endl;
+		str<<"sketch_capacity = "<<pm.sketch_capacity<<std::endl;
+		str<<"chain_format = "<<((pm.chain_format == HDF5conversion::ChainFormat::Raw) ? "raw" : "hdf5")<<std::endl;
+		str<<"flush_every = "<<pm.flush_every<<std::endl;
 		if(pm.ptr_groups == nullptr)
 			str<<"groups = "<<"Not defined"<<std::endl;
 		return str;
@@ -193,15 +231,31 @@ class Init : public SamplerTraits{
 };
 
 
+//Graph having the adjacency list saved in a checkpoint, block graphs take the groups of G
+template<template <typename> class GraphStructure, typename T>
+GraphStructure<T> graph_from_checkpoint(std::vector<double> const & adj, GraphStructure<T> const & G)
+{
+	std::vector<T> adj_T(adj.size());
+	std::transform(adj.cbegin(), adj.cend(), adj_T.begin(), [](double const & x){return static_cast<T>(x);});
+	if constexpr( internal_type_traits::isBlockGraph<GraphStructure, T>::value )
+		return GraphStructure<T>(adj_T, G.get_ptr_groups());
+	else
+		return GraphStructure<T>(adj_T);
+}
+
 // -----------------------------------------------------------------------------------------------------------------------------------------------
 
 //Generic
 template < template <typename> class GraphStructure = GraphType, typename T = unsigned int > 
 std::unique_ptr< GGM<GraphStructure, T> > 
-SelectMethod_Generic(std::string const & namePr, std::string const & nameGGM, Hyperparameters const & hy, Parameters const & param){
+SelectMethod_Generic(std::string const & namePr, std::string const & nameGGM, Hyperparameters const & hy, Parameters const & param, std::string const & nameRatio = "MC",
+					 unsigned int const & n_tries = 0){
 	using Graph = GraphStructure<T>;
 	if( !(namePr == "Uniform" || namePr == "Bernoulli" || namePr == "TruncatedUniform" || namePr == "TruncatedBernoulli") )
 		throw std::runtime_error("Error, the only possible priors right now are: Uniform, TruncatedUniform, Bernoulli, TruncatedBernoulli");
+	if( !(nameRatio == "MC" || nameRatio == "approx") )
+		throw std::runtime_error("Error, the only possible ratio modes right now are: MC, approx");
+	const ConstantRatio ratio_mode = (nameRatio == "approx") ? ConstantRatio::Approx : ConstantRatio::MC;
 	//1) Select prior
 	std::unique_ptr< GraphPrior<GraphStructure, T> > prior = nullptr;
 	if( namePr == "Uniform" )
@@ -217,14 +271,20 @@ SelectMethod_Generic(std::string const & namePr, std::string const & nameGGM, Hy
 	if(prior == nullptr)
 		throw std::runtime_error("Error, the type of selected graph is not compatible with the requested prior. Complete graphs cannot use Truncated priors ");	
 	//2) Select algorithm
+	std::unique_ptr< GGM<GraphStructure, T> > method = nullptr;
 	if(nameGGM == "MH")
-		return Create_GGM<GGMAlgorithm::MH, GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler , param.MCiterPrior, param.MCiterPost);
+		method = Create_GGM<GGMAlgorithm::MH, GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler , param.MCiterPrior, param.MCiterPost, ratio_mode);
 	else if(nameGGM == "RJ")
-		return Create_GGM<GGMAlgorithm::RJ, GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler, hy.sigmaG, param.MCiterPrior);
+		method = Create_GGM<GGMAlgorithm::RJ, GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler, hy.sigmaG, param.MCiterPrior, ratio_mode);
 	else if(nameGGM == "DRJ")
-		return Create_GGM<GGMAlgorithm::DRJ,GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler, hy.sigmaG);
+		method = Create_GGM<GGMAlgorithm::DRJ,GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler, hy.sigmaG);
+	else if(nameGGM == "BD")
+		method = Create_GGM<GGMAlgorithm::BD, GraphStructure, T >(prior, hy.b_K, hy.D_K, param.trGwishSampler);
 	else
-		throw std::runtime_error("Error, the only possible GGM algorithm right now are: MH, RJ, DRJ");
+		throw std::runtime_error("Error, the only possible GGM algorithm right now are: MH, RJ, DRJ, BD");
+	//3) Set proposal. BD does not propose graphs, it scores all the links
+	method->set_n_tries(n_tries);
+	return method;
 }
 
 
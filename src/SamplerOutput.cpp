@@ -0,0 +1,201 @@
+#include "SamplerOutput.h"
+
+namespace HDF5conversion{
+
+	SamplerOutput::SamplerOutput(std::string const & _file_name, std::string const & sampler, std::vector<unsigned int> const & info, ChainFormat const & format,
+								 bool const & _live, bool const & _resume, bool const & checkpoints):
+								 lock(h5_mutex), file_name(_file_name), live(_live), resume(_resume)
+	{
+		hid_t fapl = SamplerFileAccess(live, resume);
+		if(resume){
+			file = H5Fopen(file_name.data(), H5F_ACC_RDWR, fapl);
+			H5Pclose(fapl);
+			if(file < 0)
+				throw std::runtime_error("Cannot open the file to be resumed. It has to be the file of the interrupted sampling, with the same name");
+		}
+		else{
+			file = H5Fcreate(file_name.data(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+			H5Pclose(fapl);
+			if(file < 0)
+				throw std::runtime_error("Cannot create the file. The most probable reason is that the execution was stopped before closing a file having the same name of the one that was asked to be generated. Delete the old file or change the name of the new one");
+		}
+		try{
+			writer = MakeChainWriter(format, file, file_name, resume);
+			if(resume){ //chains of the interrupted sampling are filled from the last checkpoint on
+				dataset_info 	= OpenDataset(file, "/Info");
+				dataset_version = OpenDataset(file, "/Sampler");
+				if(ReadString(dataset_version) != sampler)
+					throw std::runtime_error("Error, the file to be resumed was not generated by " + sampler);
+			}
+			else{
+				ScalarType dim_info = info.size();
+				DataspaceType dataspace_info = H5Screate_simple(1, &dim_info, NULL);
+				dataset_info = H5Dcreate(file, "/Info", H5T_NATIVE_UINT, dataspace_info, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+				H5Sclose(dataspace_info);
+				if(dataset_info < 0 || H5Dwrite(dataset_info, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, info.data()) < 0)
+					throw std::runtime_error("Error, can not create dataset for Info");
+				//What sampler has been used
+				DataspaceType dataspace_version = H5Screate(H5S_NULL);
+				dataset_version = H5Dcreate(file, "/Sampler", H5T_STD_I32LE, dataspace_version, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+				H5Sclose(dataspace_version);
+				if(dataset_version < 0)
+					throw std::runtime_error("Error, can not create dataset for Sampler");
+				WriteString(dataset_version, sampler);
+				WriteChainFormat(file, format);
+			}
+			dataset_progress = OpenProgress(file, live, resume);
+			//Objects can not be added to a file in SWMR mode, in live mode checkpoints are saved apart
+			checkpoint_file = (checkpoints || resume) ? OpenCheckpointFile(file, file_name, live, resume) : file;
+		}
+		catch(...){
+			abort();
+			throw;
+		}
+	}
+
+	SamplerOutput::~SamplerOutput()
+	{
+		if(file >= 0) //the sampler threw
+			abort();
+	}
+
+	unsigned int SamplerOutput::add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+										  unsigned int const & first_iter, ScalarType const & rows)
+	{
+		const unsigned int id = writer->add_chain(name, type, block, iter_to_store, first_iter, rows, resume);
+		if(id >= n_planned.size()){
+			n_planned.resize(id + 1, 0);
+			n_stored.resize(id + 1, 0);
+		}
+		n_planned[id] = iter_to_store;
+		n_stored[id]  = first_iter;
+		return id;
+	}
+
+	void SamplerOutput::add_graph_log(unsigned int const & n_elem, unsigned int const & iter_to_store, unsigned int const & keyframe_every, unsigned int const & n_saved)
+	{
+		if(resume)
+			graph_log.open(file, n_elem, n_saved);
+		else
+			graph_log.create(file, n_elem, iter_to_store, keyframe_every);
+		graph_log_open = true;
+	}
+
+	std::tuple<CheckpointType, std::vector<unsigned char>> SamplerOutput::read_checkpoint()
+	{
+		return ReadCheckpoint(checkpoint_file);
+	}
+
+	void SamplerOutput::start()
+	{
+		if(live) //all datasets were created
+			StartLiveWriting(file);
+		lock.unlock();
+	}
+
+	void SamplerOutput::push_graph(std::vector<unsigned char> packed, unsigned int const & iter)
+	{
+		writer->push_task([this, packed = std::move(packed), iter]() mutable{ graph_log.add(packed, iter); });
+	}
+
+	void SamplerOutput::write_checkpoint(CheckpointType const & state, std::vector<unsigned char> const & rng_state)
+	{
+		writer->flush(); //the chains have to be on file up to the saved counters
+		std::lock_guard<std::mutex> guard(h5_mutex);
+		WriteCheckpoint(checkpoint_file, state, rng_state);
+	}
+
+	void SamplerOutput::publish(std::vector<unsigned int> const & progress)
+	{
+		writer->publish(dataset_progress, progress);
+	}
+
+	void SamplerOutput::interrupt(std::vector<unsigned int> const & progress)
+	{
+		writer->close();
+		lock.lock();
+		writer->release();
+		writer.reset();
+		if(live) //readers see everything that was written
+			WriteProgress(dataset_progress, progress);
+		abort();
+	}
+
+	void SamplerOutput::complete(std::vector<unsigned int> const & info)
+	{
+		writer->close();
+		lock.lock();
+		//Number of saved and performed iterations, they are smaller than expected if the sampling stopped early
+		if(!info.empty() && H5Dwrite(dataset_info, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, info.data()) < 0)
+			throw std::runtime_error("Error, can not update dataset Info");
+		for(unsigned int id = 0; id < n_planned.size(); ++id)
+			if(n_stored[id] < n_planned[id]) //drop the tail that was never written
+				writer->resize(id, n_stored[id]);
+		writer->release();
+		writer.reset();
+		if(graph_log_open){
+			graph_log.trim();
+			graph_log.close();
+			graph_log_open = false;
+		}
+		H5Dclose(dataset_info);
+		H5Dclose(dataset_version);
+		dataset_info = dataset_version = -1;
+		CloseCheckpointFile(checkpoint_file, file, file_name, true);
+		checkpoint_file = -1;
+		if(live){ //summaries are new datasets, they are written once the file is not in SWMR mode anymore
+			H5Dclose(dataset_progress);
+			dataset_progress = -1;
+			StopLiveWriting(file, file_name);
+		}
+	}
+
+	void SamplerOutput::close()
+	{
+		H5Fclose(file);
+		file = -1;
+		lock.unlock();
+	}
+
+	void SamplerOutput::abort() noexcept
+	{
+		if(writer){ //values pushed so far are written if possible, close() can not be called while holding h5_mutex
+			if(lock.owns_lock())
+				lock.unlock();
+			try{
+				writer->close();
+			}
+			catch(...){} //the writer thread stopped at its first error, it is idle
+		}
+		if(!lock.owns_lock())
+			lock.lock();
+		if(writer){
+			try{
+				writer->release();
+			}
+			catch(...){}
+		}
+		if(graph_log_open){
+			graph_log.close();
+			graph_log_open = false;
+		}
+		for(DatasetType * dataset : {&dataset_progress, &dataset_info, &dataset_version}){
+			if(*dataset >= 0)
+				H5Dclose(*dataset);
+			*dataset = -1;
+		}
+		if(checkpoint_file >= 0){ //they are kept, the sampling can be resumed from the last one
+			try{
+				CloseCheckpointFile(checkpoint_file, file, file_name, false);
+			}
+			catch(...){}
+		}
+		checkpoint_file = -1;
+		if(file >= 0)
+			H5Fclose(file);
+		file = -1;
+		lock.unlock();
+		writer.reset();
+	}
+
+}
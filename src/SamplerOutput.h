@@ -0,0 +1,80 @@
+#ifndef __SAMPLEROUTPUT_HPP__
+#define __SAMPLEROUTPUT_HPP__
+
+#include "ChainStorage.h"
+#include "GraphLog.h"
+
+/*
+	File written by a sampler, from its opening to its final close. The constructor creates the file, with /Info, /Sampler and /ChainFormat, or opens the file
+	of the interrupted sampling to be resumed. Then the sampler adds its chains and, if any, the event log of the graphs, and calls start(). Up to start(),
+	h5_mutex is held and the file can be modified, in live mode it is written in SWMR mode afterwards (see StartLiveWriting()). Saved values go through the
+	ChainWriter, checkpoints through write_checkpoint(). The sampling ends with interrupt(), that keeps the checkpoints, or with complete(), that removes them.
+	After complete() h5_mutex is held again, the summaries are written in get_file() and close() closes the file.
+	If the sampler throws, the destructor closes everything as interrupt() does. Values pushed so far are written when possible, the checkpoints are kept,
+	hence the sampling can be resumed from the last one.
+*/
+
+namespace HDF5conversion{
+
+	class SamplerOutput{
+		public:
+		//Opens file_name to resume the sampling, or creates it writing info in /Info. sampler is the name saved in /Sampler, a resumed file has to match it.
+		//The file of the checkpoints is opened if checkpoints is true or if resume, see OpenCheckpointFile()
+		SamplerOutput(std::string const & _file_name, std::string const & sampler, std::vector<unsigned int> const & info, ChainFormat const & format,
+					  bool const & _live, bool const & _resume, bool const & checkpoints);
+		~SamplerOutput();
+		SamplerOutput(SamplerOutput const &) = delete;
+		SamplerOutput & operator=(SamplerOutput const &) = delete;
+		//Chain of name, see ChainWriter::add_chain(). It is reopened if the sampling is resumed. Called before start()
+		unsigned int add_chain(std::string const & name, DataType const & type, ScalarType const & block, unsigned int const & iter_to_store,
+							   unsigned int const & first_iter = 0, ScalarType const & rows = 0);
+		//Event log of the graphs, created or opened if resumed (the next graph to be added is the n_saved-th one). Called before start(), see GraphLogWriter
+		void add_graph_log(unsigned int const & n_elem, unsigned int const & iter_to_store, unsigned int const & keyframe_every, unsigned int const & n_saved = 0);
+		//Last checkpoint of the sampling to be resumed. Called before start()
+		std::tuple<CheckpointType, std::vector<unsigned char>> read_checkpoint();
+		//Switches the file to SWMR mode in live mode and releases h5_mutex. The sampling can start
+		void start();
+		//Adds the values of iteration iter of chain id, see ChainWriter::push()
+		template<typename T>
+		void push(unsigned int const & id, T const * values, unsigned int const & iter){
+			writer->push(id, values, iter);
+			n_stored[id] = iter + 1;
+		}
+		//Adds the iter-th saved graph to the event log, packed by PackGraph()
+		void push_graph(std::vector<unsigned char> packed, unsigned int const & iter);
+		//Saves a checkpoint once the values pushed so far are on file, see WriteCheckpoint()
+		void write_checkpoint(CheckpointType const & state, std::vector<unsigned char> const & rng_state);
+		//In live mode, values pushed so far become visible to the readers and progress is written in /Progress, see ChainWriter::publish()
+		void publish(std::vector<unsigned int> const & progress);
+		//Closes everything, the checkpoints are kept. In live mode, progress is written in /Progress
+		void interrupt(std::vector<unsigned int> const & progress);
+		//Writes everything, updates /Info with info (unless it is empty) and drops the iterations of each chain that were not pushed. The checkpoints are
+		//removed and, in live mode, the file is not in SWMR mode anymore. The file stays open and h5_mutex is held, the summaries can be written
+		void complete(std::vector<unsigned int> const & info = {});
+		//Closes the file, after complete()
+		void close();
+		inline FileType & get_file(){
+			return file;
+		}
+		private:
+		//Closes everything without throwing, as interrupt() does. The checkpoints are kept
+		void abort() noexcept;
+		std::unique_lock<std::mutex> lock; //first, hence it is released last
+		std::string file_name;
+		bool live;
+		bool resume;
+		FileType file{-1};
+		FileType checkpoint_file{-1};
+		DatasetType dataset_info{-1};
+		DatasetType dataset_version{-1};
+		DatasetType dataset_progress{-1};
+		GraphLogWriter graph_log;
+		bool graph_log_open{false};
+		std::unique_ptr<ChainWriter> writer; //after graph_log, it is destroyed before the objects used by its tasks
+		std::vector<unsigned int> n_planned; //for each chain, the number of iterations to be stored
+		std::vector<unsigned int> n_stored;
+	};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define __INCLUDE_GGM_HPP__
 
 #include "GraphPrior.h"
-#include "GGMFactory.h" //automatically includes GGM / AddRemoveMH / RJMH / DRJMH
+#include "GGMFactory.h" //automatically includes GGM / AddRemoveMH / RJMH / DRJMH / BDMCMC
+#include "ParallelTempering.h"
 
 #endif
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <fstream>
 //Containers
 #include <vector>
+#include <deque>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -33,6 +34,8 @@
 //#include <Eigen/Sparse>
 //Parallel
 #include <omp.h>
+#include <mutex>
+#include <atomic>
 //Rcpp -> decomment for using pure c++ code. It is used in progress bar, samplers and Groups
 #include <Rcpp.h>
 #endif
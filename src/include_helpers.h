@@ -5,6 +5,16 @@
 #include "GWishart.h"
 #include "GSLwrappers.h"
 #include "HDF5conversion.h"
+#include "GraphTally.h"
+#include "GraphLog.h"
+#include "MappedDataset.h"
+#include "AsyncWriter.h"
+#include "ChainStorage.h"
+#include "SamplerOutput.h"
 #include "ProgressBar.h"
+#include "OnlineSummaries.h"
+#include "ConvergenceDiagnostics.h"
+#include "MultipleChains.h"
+#include "FunctionalData.h"
 
 #endif
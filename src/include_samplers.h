@@ -5,5 +5,6 @@
 #include "GGMsampler.h"
 #include "FGMsampler.h"
 #include "PosteriorAnalysis.h"
+#include "ResultFile.h"
 
 #endif
\ No newline at end of file
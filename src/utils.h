@@ -798,6 +798,14 @@ namespace utils{
 		return res;
 	}
 
+	//Log-likelihood of n gaussian observations with precision matrix K, up to a constant. data is the p x p matrix of the sums of squares, i.e sum_i(y_i*y_i^T)
+	inline double log_likelihood_GGM(MatRow const & K, MatCol const & data, unsigned int const & n)
+	{
+		Eigen::LLT<MatRow, Eigen::Upper> chol(K);
+		const double log_det = 2.0*chol.matrixLLT().diagonal().array().log().sum();
+		return 0.5*n*log_det - 0.5*(K.cwiseProduct(data)).sum(); //K and data are symmetric, tr(K*data) is the sum of the elementwise product
+	}
+
 	//------------------------------------------------------------------------------------------------------------------------------------------------------
 
 	//Not used in R package, data are simulated in R in that case. Those are only to test c++ functions
@@ -1059,6 +1067,27 @@ namespace utils{
 		return list_all_graphs<GraphStructure, T>(0,ptr_groups, print);
 	}
 
+	/*Builds the matrix of posterior probabilities of inclusion given the (weighted) sum of the visited adjacency lists and the sum of the weights*/
+	inline MatRow plinks_from_adj(std::vector<double> const & plinks_adj, double const & normalization, std::shared_ptr<const Groups> const & groups = nullptr)
+	{
+		if( groups == nullptr){ //Assume it is a complete Graph
+			GraphType<double> G(plinks_adj);
+			MatRow plinks( G.get_graph() );
+			plinks /= normalization;
+			plinks.diagonal().array() = 1; //Set the diagoal equal to one
+			return plinks;
+		}
+		else{ //Assume it is a Block Graph
+			BlockGraph<double> G(plinks_adj, groups);
+			MatRow plinks( G.get_graph());
+			plinks /= normalization;
+			std::vector<unsigned int> singleton(G.get_pos_singleton());
+			if(singleton.size() != 0) //Set the diagoal equal to one if there is a singleton 
+				std::for_each(singleton.cbegin(), singleton.cend(),[&plinks](unsigned int const & pos){plinks(pos, pos)=1.0;});
+			return plinks;
+		}
+	}
+
 
 
 